@@ -1491,7 +1491,7 @@ if [ "$nls" -eq 0 ]; then
 fi
 
 if [ "$bc" -eq 0 ]; then
-	unneeded="$unneeded bc.c bc_lex.c bc_parse.c"
+	unneeded="$unneeded bc.c bc_cache.c bc_lex.c bc_parse.c"
 else
 	headers="$headers \$(BC_HEADERS)"
 fi
@@ -1508,7 +1508,7 @@ if [ "$library" -ne 0 ]; then
 
 	unneeded="$unneeded args.c opt.c read.c file.c main.c"
 	unneeded="$unneeded lang.c lex.c parse.c program.c"
-	unneeded="$unneeded bc.c bc_lex.c bc_parse.c"
+	unneeded="$unneeded bc.c bc_cache.c bc_lex.c bc_parse.c"
 	unneeded="$unneeded dc.c dc_lex.c dc_parse.c"
 	headers="$headers \$(LIBRARY_HEADERS)"
 
@@ -0,0 +1,343 @@
+// Copyright (c) 2018-2026 Gavin D. Howard and contributors.
+// Licensed under the 2-clause BSD license.
+// *** AUTOMATICALLY GENERATED FROM /root/repo/gen/bc_help.txt. DO NOT MODIFY. ***
+
+extern const char bc_help[];
+
+#if BC_ENABLED
+const char bc_help[] = {
+	117,115,97,103,101,58,32,37,115,32,91,111,112,116,105,111,110,115,93,32,91,
+	102,105,108,101,46,46,46,93,10,10,98,99,32,105,115,32,97,32,99,111,109,109,
+	97,110,100,45,108,105,110,101,44,32,97,114,98,105,116,114,97,114,121,45,112,
+	114,101,99,105,115,105,111,110,32,99,97,108,99,117,108,97,116,111,114,32,
+	119,105,116,104,32,97,32,84,117,114,105,110,103,45,99,111,109,112,108,101,
+	116,101,10,108,97,110,103,117,97,103,101,46,32,70,111,114,32,100,101,116,
+	97,105,108,115,44,32,117,115,101,32,96,109,97,110,32,37,115,96,32,111,114,
+	32,115,101,101,32,116,104,101,32,111,110,108,105,110,101,32,100,111,99,117,
+	109,101,110,116,97,116,105,111,110,32,97,116,10,104,116,116,112,115,58,47,
+	47,103,105,116,104,117,98,46,99,111,109,47,103,97,118,105,110,104,111,119,
+	97,114,100,47,98,99,47,116,114,101,101,47,37,115,47,109,97,110,117,97,108,
+	115,47,98,99,47,37,115,46,49,46,109,100,32,46,10,10,84,104,105,115,32,98,
+	99,32,105,115,32,99,111,109,112,97,116,105,98,108,101,32,119,105,116,104,
+	32,98,111,116,104,32,116,104,101,32,71,78,85,32,98,99,32,97,110,100,32,116,
+	104,101,32,80,79,83,73,88,32,98,99,32,115,112,101,99,46,32,83,101,101,32,
+	116,104,101,32,71,78,85,32,98,99,10,109,97,110,117,97,108,32,40,104,116,116,
+	112,115,58,47,47,119,119,119,46,103,110,117,46,111,114,103,47,115,111,102,
+	116,119,97,114,101,47,98,99,47,109,97,110,117,97,108,47,98,99,46,104,116,
+	109,108,41,32,97,110,100,32,98,99,32,115,112,101,99,10,40,104,116,116,112,
+	58,47,47,112,117,98,115,46,111,112,101,110,103,114,111,117,112,46,111,114,
+	103,47,111,110,108,105,110,101,112,117,98,115,47,57,54,57,57,57,49,57,55,
+	57,57,47,117,116,105,108,105,116,105,101,115,47,98,99,46,104,116,109,108,
+	41,10,102,111,114,32,100,101,116,97,105,108,115,46,10,10,84,104,105,115,32,
+	98,99,32,104,97,115,32,116,104,114,101,101,32,100,105,102,102,101,114,101,
+	110,99,101,115,32,116,111,32,116,104,101,32,71,78,85,32,98,99,58,10,10,32,
+	32,49,41,32,65,114,114,97,121,115,32,99,97,110,32,98,101,32,112,97,115,115,
+	101,100,32,116,111,32,116,104,101,32,98,117,105,108,116,105,110,32,34,108,
+	101,110,103,116,104,34,32,102,117,110,99,116,105,111,110,32,116,111,32,103,
+	101,116,32,116,104,101,32,110,117,109,98,101,114,32,111,102,10,32,32,32,32,
+	32,101,108,101,109,101,110,116,115,32,99,117,114,114,101,110,116,108,121,
+	32,105,110,32,116,104,101,32,97,114,114,97,121,46,32,84,104,101,32,102,111,
+	108,108,111,119,105,110,103,32,101,120,97,109,112,108,101,32,112,114,105,
+	110,116,115,32,34,49,34,58,10,10,32,32,32,32,32,32,32,97,91,48,93,32,61,32,
+	48,10,32,32,32,32,32,32,32,108,101,110,103,116,104,40,97,91,93,41,10,10,32,
+	32,50,41,32,84,104,101,32,112,114,101,99,101,100,101,110,99,101,32,111,102,
+	32,116,104,101,32,98,111,111,108,101,97,110,32,34,110,111,116,34,32,111,112,
+	101,114,97,116,111,114,32,40,33,41,32,105,115,32,101,113,117,97,108,32,116,
+	111,32,116,104,97,116,32,111,102,32,116,104,101,10,32,32,32,32,32,117,110,
+	97,114,121,32,109,105,110,117,115,32,40,45,41,44,32,111,114,32,110,101,103,
+	97,116,105,111,110,44,32,111,112,101,114,97,116,111,114,46,32,84,104,105,
+	115,32,115,116,105,108,108,32,97,108,108,111,119,115,32,80,79,83,73,88,45,
+	99,111,109,112,108,105,97,110,116,10,32,32,32,32,32,115,99,114,105,112,116,
+	115,32,116,111,32,119,111,114,107,32,119,104,105,108,101,32,115,111,109,101,
+	119,104,97,116,32,112,114,101,115,101,114,118,105,110,103,32,101,120,112,
+	101,99,116,101,100,32,98,101,104,97,118,105,111,114,32,40,118,101,114,115,
+	117,115,32,67,41,32,97,110,100,10,32,32,32,32,32,109,97,107,105,110,103,32,
+	112,97,114,115,105,110,103,32,101,97,115,105,101,114,46,10,32,32,51,41,32,
+	84,104,105,115,32,98,99,32,104,97,115,32,109,97,110,121,32,109,111,114,101,
+	32,101,120,116,101,110,115,105,111,110,115,32,116,104,97,110,32,116,104,101,
+	32,71,78,85,32,98,99,32,100,111,101,115,46,32,70,111,114,32,100,101,116,97,
+	105,108,115,44,32,115,101,101,32,116,104,101,10,32,32,32,32,32,109,97,110,
+	32,112,97,103,101,32,111,114,32,111,110,108,105,110,101,32,100,111,99,117,
+	109,101,110,116,97,116,105,111,110,46,10,10,84,104,105,115,32,98,99,32,97,
+	108,115,111,32,105,109,112,108,101,109,101,110,116,115,32,116,104,101,32,
+	100,111,116,32,40,46,41,32,101,120,116,101,110,115,105,111,110,32,111,102,
+	32,116,104,101,32,66,83,68,32,98,99,46,10,10,79,112,116,105,111,110,115,58,
+	10,10,32,32,45,67,32,32,45,45,110,111,45,100,105,103,105,116,45,99,108,97,
+	109,112,10,10,32,32,32,32,32,32,68,105,115,97,98,108,101,115,32,99,108,97,
+	109,112,105,110,103,32,111,102,32,100,105,103,105,116,115,32,116,104,97,116,
+	32,97,114,101,32,108,97,114,103,101,114,32,116,104,97,110,32,111,114,32,101,
+	113,117,97,108,32,116,111,32,116,104,101,32,99,117,114,114,101,110,116,10,
+	32,32,32,32,32,32,105,98,97,115,101,32,119,104,101,110,32,112,97,114,115,
+	105,110,103,32,110,117,109,98,101,114,115,46,10,10,32,32,32,32,32,32,84,104,
+	105,115,32,109,101,97,110,115,32,116,104,97,116,32,116,104,101,32,118,97,
+	108,117,101,32,97,100,100,101,100,32,116,111,32,97,32,110,117,109,98,101,
+	114,32,102,114,111,109,32,97,32,100,105,103,105,116,32,105,115,32,97,108,
+	119,97,121,115,32,116,104,97,116,10,32,32,32,32,32,32,100,105,103,105,116,
+	39,115,32,118,97,108,117,101,32,109,117,108,116,105,112,108,105,101,100,32,
+	98,121,32,116,104,101,32,118,97,108,117,101,32,111,102,32,105,98,97,115,101,
+	32,114,97,105,115,101,100,32,116,111,32,116,104,101,32,112,111,119,101,114,
+	32,111,102,32,116,104,101,10,32,32,32,32,32,32,100,105,103,105,116,39,115,
+	32,112,111,115,105,116,105,111,110,44,32,119,104,105,99,104,32,115,116,97,
+	114,116,115,32,102,114,111,109,32,48,32,97,116,32,116,104,101,32,108,101,
+	97,115,116,32,115,105,103,110,105,102,105,99,97,110,116,32,100,105,103,105,
+	116,46,10,10,32,32,32,32,32,32,73,102,32,109,117,108,116,105,112,108,101,
+	32,111,102,32,116,104,105,115,32,111,112,116,105,111,110,32,97,110,100,32,
+	116,104,101,32,45,99,32,111,112,116,105,111,110,32,97,114,101,32,103,105,
+	118,101,110,44,32,116,104,101,32,108,97,115,116,32,105,115,32,117,115,101,
+	100,46,10,10,32,32,45,99,32,32,45,45,100,105,103,105,116,45,99,108,97,109,
+	112,10,10,32,32,32,32,32,32,69,110,97,98,108,101,115,32,99,108,97,109,112,
+	105,110,103,32,111,102,32,100,105,103,105,116,115,32,116,104,97,116,32,97,
+	114,101,32,108,97,114,103,101,114,32,116,104,97,110,32,111,114,32,101,113,
+	117,97,108,32,116,111,32,116,104,101,32,99,117,114,114,101,110,116,10,32,
+	32,32,32,32,32,105,98,97,115,101,32,119,104,101,110,32,112,97,114,115,105,
+	110,103,32,110,117,109,98,101,114,115,46,10,10,32,32,32,32,32,32,84,104,105,
+	115,32,109,101,97,110,115,32,116,104,97,116,32,100,105,103,105,116,115,32,
+	116,104,97,116,32,116,104,101,32,118,97,108,117,101,32,97,100,100,101,100,
+	32,116,111,32,97,32,110,117,109,98,101,114,32,102,114,111,109,32,97,32,100,
+	105,103,105,116,32,116,104,97,116,10,32,32,32,32,32,32,105,115,32,103,114,
+	101,97,116,101,114,32,116,104,97,110,32,111,114,32,101,113,117,97,108,32,
+	116,111,32,116,104,101,32,105,98,97,115,101,32,105,115,32,116,104,101,32,
+	118,97,108,117,101,32,111,102,32,105,98,97,115,101,32,109,105,110,117,115,
+	32,49,32,97,108,108,10,32,32,32,32,32,32,109,117,108,116,105,112,108,105,
+	101,100,32,98,121,32,116,104,101,32,118,97,108,117,101,32,111,102,32,105,
+	98,97,115,101,32,114,97,105,115,101,100,32,116,111,32,116,104,101,32,112,
+	111,119,101,114,32,111,102,32,116,104,101,32,100,105,103,105,116,39,115,10,
+	32,32,32,32,32,32,112,111,115,105,116,105,111,110,44,32,119,104,105,99,104,
+	32,115,116,97,114,116,115,32,102,114,111,109,32,48,32,97,116,32,116,104,101,
+	32,108,101,97,115,116,32,115,105,103,110,105,102,105,99,97,110,116,32,100,
+	105,103,105,116,46,10,10,32,32,32,32,32,32,73,102,32,109,117,108,116,105,
+	112,108,101,32,111,102,32,116,104,105,115,32,111,112,116,105,111,110,32,97,
+	110,100,32,116,104,101,32,45,67,32,111,112,116,105,111,110,32,97,114,101,
+	32,103,105,118,101,110,44,32,116,104,101,32,108,97,115,116,32,105,115,32,
+	117,115,101,100,46,10,10,32,32,45,69,32,32,115,101,101,100,32,32,45,45,115,
+	101,101,100,61,115,101,101,100,10,10,32,32,32,32,32,32,83,101,116,115,32,
+	116,104,101,32,98,117,105,108,116,105,110,32,118,97,114,105,97,98,108,101,
+	32,115,101,101,100,32,116,111,32,116,104,101,32,103,105,118,101,110,32,118,
+	97,108,117,101,32,97,115,115,117,109,105,110,103,32,116,104,97,116,32,116,
+	104,101,32,103,105,118,101,110,10,32,32,32,32,32,32,118,97,108,117,101,32,
+	105,115,32,105,110,32,98,97,115,101,32,49,48,46,32,73,116,32,105,115,32,97,
+	32,102,97,116,97,108,32,101,114,114,111,114,32,105,102,32,116,104,101,32,
+	103,105,118,101,110,32,118,97,108,117,101,32,105,115,32,110,111,116,32,97,
+	32,118,97,108,105,100,10,32,32,32,32,32,32,110,117,109,98,101,114,46,10,10,
+	32,32,45,101,32,32,101,120,112,114,32,32,45,45,101,120,112,114,101,115,115,
+	105,111,110,61,101,120,112,114,10,10,32,32,32,32,32,32,82,117,110,32,34,101,
+	120,112,114,34,32,97,110,100,32,113,117,105,116,46,32,73,102,32,109,117,108,
+	116,105,112,108,101,32,101,120,112,114,101,115,115,105,111,110,115,32,111,
+	114,32,102,105,108,101,115,32,40,115,101,101,32,98,101,108,111,119,41,32,
+	97,114,101,10,32,32,32,32,32,32,103,105,118,101,110,44,32,116,104,101,121,
+	32,97,114,101,32,97,108,108,32,114,117,110,32,98,101,102,111,114,101,32,101,
+	120,101,99,117,116,105,110,103,32,102,114,111,109,32,115,116,100,105,110,
+	46,10,10,32,32,45,102,32,32,102,105,108,101,32,32,45,45,102,105,108,101,61,
+	102,105,108,101,10,10,32,32,32,32,32,32,82,117,110,32,116,104,101,32,98,99,
+	32,99,111,100,101,32,105,110,32,34,102,105,108,101,34,32,97,110,100,32,101,
+	120,105,116,46,32,83,101,101,32,97,98,111,118,101,32,97,115,32,119,101,108,
+	108,46,10,10,32,32,45,103,32,32,45,45,103,108,111,98,97,108,45,115,116,97,
+	99,107,115,10,10,32,32,32,32,32,32,84,117,114,110,32,115,99,97,108,101,44,
+	32,105,98,97,115,101,44,32,97,110,100,32,111,98,97,115,101,32,105,110,116,
+	111,32,115,116,97,99,107,115,46,32,84,104,105,115,32,109,97,107,101,115,32,
+	116,104,101,32,118,97,108,117,101,32,111,102,32,101,97,99,104,32,98,101,10,
+	32,32,32,32,32,32,98,101,32,114,101,115,116,111,114,101,100,32,111,110,32,
+	114,101,116,117,114,110,105,110,103,32,102,114,111,109,32,102,117,110,99,
+	116,105,111,110,115,46,32,83,101,101,32,116,104,101,32,109,97,110,32,112,
+	97,103,101,32,111,114,32,111,110,108,105,110,101,10,32,32,32,32,32,32,100,
+	111,99,117,109,101,110,116,97,116,105,111,110,32,102,111,114,32,109,111,114,
+	101,32,100,101,116,97,105,108,115,46,10,10,32,32,45,104,32,32,45,45,104,101,
+	108,112,10,10,32,32,32,32,32,32,80,114,105,110,116,32,116,104,105,115,32,
+	117,115,97,103,101,32,109,101,115,115,97,103,101,32,97,110,100,32,101,120,
+	105,116,46,10,10,32,32,45,73,32,32,105,98,97,115,101,32,32,45,45,105,98,97,
+	115,101,61,105,98,97,115,101,10,10,32,32,32,32,32,32,83,101,116,115,32,116,
+	104,101,32,98,117,105,108,116,105,110,32,118,97,114,105,97,98,108,101,32,
+	105,98,97,115,101,32,116,111,32,116,104,101,32,103,105,118,101,110,32,118,
+	97,108,117,101,32,97,115,115,117,109,105,110,103,32,116,104,97,116,32,116,
+	104,101,32,103,105,118,101,110,10,32,32,32,32,32,32,118,97,108,117,101,32,
+	105,115,32,105,110,32,98,97,115,101,32,49,48,46,32,73,116,32,105,115,32,97,
+	32,102,97,116,97,108,32,101,114,114,111,114,32,105,102,32,116,104,101,32,
+	103,105,118,101,110,32,118,97,108,117,101,32,105,115,32,110,111,116,32,97,
+	32,118,97,108,105,100,10,32,32,32,32,32,32,110,117,109,98,101,114,46,10,10,
+	32,32,45,105,32,32,45,45,105,110,116,101,114,97,99,116,105,118,101,10,10,
+	32,32,32,32,32,32,70,111,114,99,101,32,105,110,116,101,114,97,99,116,105,
+	118,101,32,109,111,100,101,46,10,10,32,32,45,76,32,32,45,45,110,111,45,108,
+	105,110,101,45,108,101,110,103,116,104,10,10,32,32,32,32,32,32,68,105,115,
+	97,98,108,101,32,108,105,110,101,32,108,101,110,103,116,104,32,99,104,101,
+	99,107,105,110,103,46,10,10,32,32,45,108,32,32,45,45,109,97,116,104,108,105,
+	98,10,10,32,32,32,32,32,32,85,115,101,32,112,114,101,100,101,102,105,110,
+	101,100,32,109,97,116,104,32,114,111,117,116,105,110,101,115,58,10,10,32,
+	32,32,32,32,32,32,32,32,32,115,40,101,120,112,114,41,32,32,61,32,32,115,105,
+	110,101,32,111,102,32,101,120,112,114,32,105,110,32,114,97,100,105,97,110,
+	115,10,32,32,32,32,32,32,32,32,32,32,99,40,101,120,112,114,41,32,32,61,32,
+	32,99,111,115,105,110,101,32,111,102,32,101,120,112,114,32,105,110,32,114,
+	97,100,105,97,110,115,10,32,32,32,32,32,32,32,32,32,32,97,40,101,120,112,
+	114,41,32,32,61,32,32,97,114,99,116,97,110,103,101,110,116,32,111,102,32,
+	101,120,112,114,44,32,114,101,116,117,114,110,105,110,103,32,114,97,100,105,
+	97,110,115,10,32,32,32,32,32,32,32,32,32,32,108,40,101,120,112,114,41,32,
+	32,61,32,32,110,97,116,117,114,97,108,32,108,111,103,32,111,102,32,101,120,
+	112,114,10,32,32,32,32,32,32,32,32,32,32,101,40,101,120,112,114,41,32,32,
+	61,32,32,114,97,105,115,101,115,32,101,32,116,111,32,116,104,101,32,112,111,
+	119,101,114,32,111,102,32,101,120,112,114,10,32,32,32,32,32,32,32,32,32,32,
+	106,40,110,44,32,120,41,32,32,61,32,32,66,101,115,115,101,108,32,102,117,
+	110,99,116,105,111,110,32,111,102,32,105,110,116,101,103,101,114,32,111,114,
+	100,101,114,32,110,32,111,102,32,120,10,10,32,32,32,32,32,32,84,104,105,115,
+	32,98,99,32,109,97,121,32,108,111,97,100,32,109,111,114,101,32,102,117,110,
+	99,116,105,111,110,115,32,119,105,116,104,32,116,104,101,115,101,32,111,112,
+	116,105,111,110,115,46,32,83,101,101,32,116,104,101,32,109,97,110,112,97,
+	103,101,32,111,114,10,32,32,32,32,32,32,111,110,108,105,110,101,32,100,111,
+	99,117,109,101,110,116,97,116,105,111,110,32,102,111,114,32,100,101,116,97,
+	105,108,115,46,10,10,32,32,45,78,32,32,45,45,110,111,45,111,112,116,105,109,
+	105,122,101,10,10,32,32,32,32,32,32,82,117,110,115,32,116,104,101,32,98,121,
+	116,101,99,111,100,101,32,101,120,97,99,116,108,121,32,97,115,32,105,116,
+	32,105,115,32,112,97,114,115,101,100,44,32,119,105,116,104,111,117,116,32,
+	111,112,116,105,109,105,122,105,110,103,32,105,116,46,32,84,104,105,115,32,
+	105,115,10,32,32,32,32,32,32,102,111,114,32,99,111,109,112,97,114,105,110,
+	103,32,114,101,115,117,108,116,115,32,119,105,116,104,32,116,104,101,32,111,
+	112,116,105,109,105,122,101,100,32,98,121,116,101,99,111,100,101,46,10,10,
+	32,32,45,79,32,32,111,98,97,115,101,32,32,45,45,111,98,97,115,101,61,111,
+	98,97,115,101,10,10,32,32,32,32,32,32,83,101,116,115,32,116,104,101,32,98,
+	117,105,108,116,105,110,32,118,97,114,105,97,98,108,101,32,111,98,97,115,
+	101,32,116,111,32,116,104,101,32,103,105,118,101,110,32,118,97,108,117,101,
+	32,97,115,115,117,109,105,110,103,32,116,104,97,116,32,116,104,101,32,103,
+	105,118,101,110,10,32,32,32,32,32,32,118,97,108,117,101,32,105,115,32,105,
+	110,32,98,97,115,101,32,49,48,46,32,73,116,32,105,115,32,97,32,102,97,116,
+	97,108,32,101,114,114,111,114,32,105,102,32,116,104,101,32,103,105,118,101,
+	110,32,118,97,108,117,101,32,105,115,32,110,111,116,32,97,32,118,97,108,105,
+	100,10,32,32,32,32,32,32,110,117,109,98,101,114,46,10,10,32,32,45,111,32,
+	32,102,105,108,101,32,32,45,45,99,111,109,112,105,108,101,61,102,105,108,
+	101,10,10,32,32,32,32,32,32,67,111,109,112,105,108,101,115,32,116,104,101,
+	32,111,110,108,121,32,102,105,108,101,32,103,105,118,101,110,32,111,110,32,
+	116,104,101,32,99,111,109,109,97,110,100,45,108,105,110,101,32,105,110,116,
+	111,32,97,32,98,121,116,101,99,111,100,101,32,99,97,99,104,101,32,105,110,
+	10,32,32,32,32,32,32,116,104,101,32,103,105,118,101,110,32,102,105,108,101,
+	32,105,110,115,116,101,97,100,32,111,102,32,114,117,110,110,105,110,103,32,
+	105,116,46,32,73,102,32,97,32,99,97,99,104,101,32,105,115,32,103,105,118,
+	101,110,32,97,115,32,97,32,102,105,108,101,32,108,97,116,101,114,44,10,32,
+	32,32,32,32,32,105,116,32,105,115,32,114,117,110,32,119,105,116,104,111,117,
+	116,32,112,97,114,115,105,110,103,32,105,102,32,116,104,101,32,115,99,114,
+	105,112,116,32,97,110,100,32,116,104,101,32,115,116,97,116,101,32,111,102,
+	32,98,99,32,97,114,101,32,117,110,99,104,97,110,103,101,100,46,10,10,32,32,
+	45,80,32,32,45,45,110,111,45,112,114,111,109,112,116,10,10,32,32,32,32,32,
+	32,68,105,115,97,98,108,101,32,116,104,101,32,112,114,111,109,112,116,115,
+	32,105,110,32,105,110,116,101,114,97,99,116,105,118,101,32,109,111,100,101,
+	46,10,10,32,32,45,82,32,32,45,45,110,111,45,114,101,97,100,45,112,114,111,
+	109,112,116,10,10,32,32,32,32,32,32,68,105,115,97,98,108,101,32,116,104,101,
+	32,114,101,97,100,32,112,114,111,109,112,116,32,105,110,32,105,110,116,101,
+	114,97,99,116,105,118,101,32,109,111,100,101,46,10,10,32,32,45,114,32,32,
+	107,101,121,119,111,114,100,32,32,45,45,114,101,100,101,102,105,110,101,61,
+	107,101,121,119,111,114,100,10,10,32,32,32,32,32,32,82,101,100,101,102,105,
+	110,101,115,32,34,107,101,121,119,111,114,100,34,32,97,110,100,32,97,108,
+	108,111,119,115,32,105,116,32,116,111,32,98,101,32,117,115,101,100,32,97,
+	115,32,97,32,102,117,110,99,116,105,111,110,44,32,118,97,114,105,97,98,108,
+	101,44,32,97,110,100,10,32,32,32,32,32,32,97,114,114,97,121,32,110,97,109,
+	101,46,32,84,104,105,115,32,105,115,32,117,115,101,102,117,108,32,119,104,
+	101,110,32,116,104,105,115,32,98,99,32,103,105,118,101,115,32,112,97,114,
+	115,101,32,101,114,114,111,114,115,32,111,110,32,115,99,114,105,112,116,115,
+	10,32,32,32,32,32,32,109,101,97,110,116,32,102,111,114,32,111,116,104,101,
+	114,32,98,99,32,105,109,112,108,101,109,101,110,116,97,116,105,111,110,115,
+	46,10,10,32,32,32,32,32,32,79,110,108,121,32,107,101,121,119,111,114,100,
+	115,32,116,104,97,116,32,97,114,101,32,110,111,116,32,105,110,32,116,104,
+	101,32,80,79,83,73,88,32,98,99,32,115,112,101,99,32,109,97,121,32,98,101,
+	32,114,101,100,101,102,105,110,101,100,46,10,10,32,32,32,32,32,32,73,116,
+	32,105,115,32,97,32,102,97,116,97,108,32,101,114,114,111,114,32,116,111,32,
+	97,116,116,101,109,112,116,32,116,111,32,114,101,100,101,102,105,110,101,
+	32,97,32,107,101,121,119,111,114,100,32,116,104,97,116,32,99,97,110,110,111,
+	116,32,98,101,10,32,32,32,32,32,32,114,101,100,101,102,105,110,101,100,32,
+	111,114,32,100,111,101,115,32,110,111,116,32,101,120,105,115,116,46,10,10,
+	32,32,45,113,32,32,45,45,113,117,105,101,116,10,10,32,32,32,32,32,32,68,111,
+	110,39,116,32,112,114,105,110,116,32,118,101,114,115,105,111,110,32,97,110,
+	100,32,99,111,112,121,114,105,103,104,116,46,10,10,32,32,45,83,32,32,115,
+	99,97,108,101,32,32,45,45,115,99,97,108,101,61,115,99,97,108,101,10,10,32,
+	32,32,32,32,32,83,101,116,115,32,116,104,101,32,98,117,105,108,116,105,110,
+	32,118,97,114,105,97,98,108,101,32,115,99,97,108,101,32,116,111,32,116,104,
+	101,32,103,105,118,101,110,32,118,97,108,117,101,32,97,115,115,117,109,105,
+	110,103,32,116,104,97,116,32,116,104,101,32,103,105,118,101,110,10,32,32,
+	32,32,32,32,118,97,108,117,101,32,105,115,32,105,110,32,98,97,115,101,32,
+	49,48,46,32,73,116,32,105,115,32,97,32,102,97,116,97,108,32,101,114,114,111,
+	114,32,105,102,32,116,104,101,32,103,105,118,101,110,32,118,97,108,117,101,
+	32,105,115,32,110,111,116,32,97,32,118,97,108,105,100,10,32,32,32,32,32,32,
+	110,117,109,98,101,114,46,10,10,32,32,45,115,32,32,45,45,115,116,97,110,100,
+	97,114,100,10,10,32,32,32,32,32,32,69,114,114,111,114,32,105,102,32,97,110,
+	121,32,110,111,110,45,80,79,83,73,88,32,101,120,116,101,110,115,105,111,110,
+	115,32,97,114,101,32,117,115,101,100,46,10,10,32,32,45,119,32,32,45,45,119,
+	97,114,110,10,10,32,32,32,32,32,32,87,97,114,110,32,105,102,32,97,110,121,
+	32,110,111,110,45,80,79,83,73,88,32,101,120,116,101,110,115,105,111,110,115,
+	32,97,114,101,32,117,115,101,100,46,10,10,32,32,45,118,32,32,45,45,118,101,
+	114,115,105,111,110,10,10,32,32,32,32,32,32,80,114,105,110,116,32,118,101,
+	114,115,105,111,110,32,105,110,102,111,114,109,97,116,105,111,110,32,97,110,
+	100,32,99,111,112,121,114,105,103,104,116,32,97,110,100,32,101,120,105,116,
+	46,10,10,32,32,45,122,32,32,45,45,108,101,97,100,105,110,103,45,122,101,114,
+	111,101,115,10,10,32,32,32,32,32,32,69,110,97,98,108,101,32,108,101,97,100,
+	105,110,103,32,122,101,114,111,101,115,32,111,110,32,110,117,109,98,101,114,
+	115,32,103,114,101,97,116,101,114,32,116,104,97,110,32,45,49,32,97,110,100,
+	32,108,101,115,115,32,116,104,97,110,32,49,46,10,10,69,110,118,105,114,111,
+	110,109,101,110,116,32,118,97,114,105,97,98,108,101,115,58,10,10,32,32,80,
+	79,83,73,88,76,89,95,67,79,82,82,69,67,84,10,10,32,32,32,32,32,32,69,114,
+	114,111,114,32,105,102,32,97,110,121,32,110,111,110,45,80,79,83,73,88,32,
+	101,120,116,101,110,115,105,111,110,115,32,97,114,101,32,117,115,101,100,
+	46,10,10,32,32,66,67,95,69,78,86,95,65,82,71,83,10,10,32,32,32,32,32,32,67,
+	111,109,109,97,110,100,45,108,105,110,101,32,97,114,103,117,109,101,110,116,
+	115,32,116,111,32,117,115,101,32,111,110,32,101,118,101,114,121,32,114,117,
+	110,46,10,10,32,32,66,67,95,76,73,78,69,95,76,69,78,71,84,72,10,10,32,32,
+	32,32,32,32,73,102,32,97,110,32,105,110,116,101,103,101,114,44,32,116,104,
+	101,32,110,117,109,98,101,114,32,111,102,32,99,104,97,114,97,99,116,101,114,
+	115,32,116,111,32,112,114,105,110,116,32,111,110,32,97,32,108,105,110,101,
+	32,98,101,102,111,114,101,10,32,32,32,32,32,32,119,114,97,112,112,105,110,
+	103,46,32,85,115,105,110,103,32,48,32,119,105,108,108,32,100,105,115,97,98,
+	108,101,32,108,105,110,101,32,108,101,110,103,116,104,32,99,104,101,99,107,
+	105,110,103,46,10,10,32,32,66,67,95,66,65,78,78,69,82,10,10,32,32,32,32,32,
+	32,73,102,32,97,110,32,105,110,116,101,103,101,114,32,97,110,100,32,110,111,
+	110,45,122,101,114,111,44,32,100,105,115,112,108,97,121,32,116,104,101,32,
+	99,111,112,121,114,105,103,104,116,32,98,97,110,110,101,114,32,105,110,32,
+	105,110,116,101,114,97,99,116,105,118,101,10,32,32,32,32,32,32,109,111,100,
+	101,46,10,10,32,32,32,32,32,32,73,102,32,122,101,114,111,44,32,100,105,115,
+	97,98,108,101,32,116,104,101,32,98,97,110,110,101,114,46,10,10,32,32,32,32,
+	32,32,79,118,101,114,114,105,100,101,115,32,116,104,101,32,100,101,102,97,
+	117,108,116,44,32,119,104,105,99,104,32,105,115,32,37,115,32,112,114,105,
+	110,116,32,116,104,101,32,98,97,110,110,101,114,46,10,10,32,32,66,67,95,83,
+	73,71,73,78,84,95,82,69,83,69,84,10,10,32,32,32,32,32,32,73,102,32,97,110,
+	32,105,110,116,101,103,101,114,32,97,110,100,32,110,111,110,45,122,101,114,
+	111,44,32,114,101,115,101,116,32,111,110,32,83,73,71,73,78,84,44,32,114,97,
+	116,104,101,114,32,116,104,97,110,32,101,120,105,116,44,32,119,104,101,110,
+	32,105,110,10,32,32,32,32,32,32,105,110,116,101,114,97,99,116,105,118,101,
+	32,109,111,100,101,46,10,10,32,32,32,32,32,32,73,102,32,122,101,114,111,44,
+	32,100,111,32,110,111,116,32,114,101,115,101,116,32,111,110,32,83,73,71,73,
+	78,84,32,105,110,32,97,108,108,32,99,97,115,101,115,44,32,98,117,116,32,101,
+	120,105,116,32,105,110,115,116,101,97,100,46,10,10,32,32,32,32,32,32,79,118,
+	101,114,114,105,100,101,115,32,116,104,101,32,100,101,102,97,117,108,116,
+	44,32,119,104,105,99,104,32,105,115,32,37,115,46,10,10,32,32,66,67,95,84,
+	84,89,95,77,79,68,69,10,10,32,32,32,32,32,32,73,102,32,97,110,32,105,110,
+	116,101,103,101,114,32,97,110,100,32,110,111,110,45,122,101,114,111,44,32,
+	101,110,97,98,108,101,32,84,84,89,32,109,111,100,101,32,119,104,101,110,32,
+	105,116,32,105,115,32,97,118,97,105,108,97,98,108,101,46,10,10,32,32,32,32,
+	32,32,73,102,32,122,101,114,111,44,32,100,105,115,97,98,108,101,32,84,84,
+	89,32,109,111,100,101,32,105,110,32,97,108,108,32,99,97,115,101,115,46,10,
+	10,32,32,32,32,32,32,79,118,101,114,114,105,100,101,115,32,116,104,101,32,
+	100,101,102,97,117,108,116,44,32,119,104,105,99,104,32,105,115,32,84,84,89,
+	32,109,111,100,101,32,37,115,46,10,10,32,32,66,67,95,80,82,79,77,80,84,10,
+	10,32,32,32,32,32,32,73,102,32,97,110,32,105,110,116,101,103,101,114,32,97,
+	110,100,32,110,111,110,45,122,101,114,111,44,32,101,110,97,98,108,101,32,
+	112,114,111,109,112,116,32,119,104,101,110,32,84,84,89,32,109,111,100,101,
+	32,105,115,32,112,111,115,115,105,98,108,101,46,10,10,32,32,32,32,32,32,73,
+	102,32,122,101,114,111,44,32,100,105,115,97,98,108,101,32,112,114,111,109,
+	112,116,32,105,110,32,97,108,108,32,99,97,115,101,115,46,10,10,32,32,32,32,
+	32,32,79,118,101,114,114,105,100,101,115,32,116,104,101,32,100,101,102,97,
+	117,108,116,44,32,119,104,105,99,104,32,105,115,32,112,114,111,109,112,116,
+	32,37,115,46,10,10,32,32,66,67,95,69,88,80,82,95,69,88,73,84,10,10,32,32,
+	32,32,32,32,73,102,32,97,110,32,105,110,116,101,103,101,114,32,97,110,100,
+	32,110,111,110,45,122,101,114,111,44,32,101,120,105,116,32,119,104,101,110,
+	32,101,120,112,114,101,115,115,105,111,110,115,32,111,114,32,101,120,112,
+	114,101,115,115,105,111,110,32,102,105,108,101,115,32,97,114,101,10,32,32,
+	32,32,32,32,103,105,118,101,110,32,111,110,32,116,104,101,32,99,111,109,109,
+	97,110,100,45,108,105,110,101,44,32,97,110,100,32,100,111,101,115,32,110,
+	111,116,32,101,120,105,116,32,119,104,101,110,32,97,110,32,105,110,116,101,
+	103,101,114,32,97,110,100,32,122,101,114,111,46,10,10,32,32,32,32,32,32,79,
+	118,101,114,114,105,100,101,115,32,116,104,101,32,100,101,102,97,117,108,
+	116,44,32,119,104,105,99,104,32,105,115,32,37,115,46,10,10,32,32,66,67,95,
+	68,73,71,73,84,95,67,76,65,77,80,10,10,32,32,32,32,32,32,73,102,32,97,110,
+	32,105,110,116,101,103,101,114,32,97,110,100,32,110,111,110,45,122,101,114,
+	111,44,32,99,108,97,109,112,32,100,105,103,105,116,115,32,108,97,114,103,
+	101,114,32,116,104,97,110,32,111,114,32,101,113,117,97,108,32,116,111,32,
+	116,104,101,10,32,32,32,32,32,32,99,117,114,114,101,110,116,32,105,98,97,
+	115,101,32,119,104,101,110,32,112,97,114,115,105,110,103,32,110,117,109,98,
+	101,114,115,46,10,10,32,32,32,32,32,32,79,118,101,114,114,105,100,101,115,
+	32,116,104,101,32,100,101,102,97,117,108,116,44,32,119,104,105,99,104,32,
+	105,115,32,37,115,46,10,0
+};
+#endif // BC_ENABLED
@@ -96,13 +96,13 @@ typedef struct BcLexKeyword
 
 /// A macro for the number of keywords bc has. This has to be updated if any are
 /// added. This is for the redefined_kws field of the BcVm struct.
-#define BC_LEX_NKWS (37)
+#define BC_LEX_NKWS (41)
 
 #else // BC_ENABLE_EXTRA_MATH
 
 /// A macro for the number of keywords bc has. This has to be updated if any are
 /// added. This is for the redefined_kws field of the BcVm struct.
-#define BC_LEX_NKWS (33)
+#define BC_LEX_NKWS (37)
 
 #endif // BC_ENABLE_EXTRA_MATH
 
@@ -349,6 +349,18 @@ bc_lex_token(BcLex* l);
  */
 #define BC_PARSE_IS_KEYWORD(t) ((t) >= BC_LEX_KW_AUTO && (t) <= BC_LEX_KW_ELSE)
 
+/**
+ * Returns true if the parser should leave the bytecode exactly as it generated
+ * it, to be run on the results stack. That is always the case if BC_STACK_ONLY
+ * is non-zero, and otherwise, it is chosen at runtime with the -N option.
+ */
+#define BC_PARSE_STACK_ONLY (BC_STACK_ONLY || BC_NO_OPT)
+
+/// The maximum length of the bytecode of a function body that can be inlined.
+#ifndef BC_PARSE_INLINE_MAX
+#define BC_PARSE_INLINE_MAX (64)
+#endif // BC_PARSE_INLINE_MAX
+
 /// A struct that holds data about what tokens should be expected next. There
 /// are a few instances of these, all named because they are used in specific
 /// cases. Basically, in certain situations, it's useful to use the same code,
@@ -411,6 +423,171 @@ bc_parse_parse(BcParse* p);
 void
 bc_parse_endif(BcParse* p);
 
+/**
+ * Parses one function definition, including its body, and nothing else. This
+ * is for the functions in the math libraries, which are parsed the first time
+ * that they are called. Unlike bc_parse_parse(), this does not touch main.
+ * @param p  The parser.
+ */
+void
+bc_parse_define(BcParse* p);
+
+/**
+ * Prints the limits of bc. This is what the `limits` statement does when it is
+ * parsed.
+ */
+void
+bc_parse_limits(void);
+
+#if !BC_ENABLE_LIBRARY
+
+/// The magic bytes at the start of a bytecode cache. The first one is not text,
+/// so a cache can never be mistaken for a script.
+#define BC_CACHE_MAGIC "\177bcc"
+
+/// The length of BC_CACHE_MAGIC.
+#define BC_CACHE_MAGIC_LEN (4)
+
+/// The version of the format of bytecode caches. This must be bumped whenever
+/// the format, or the bytecode that goes in it, changes.
+#define BC_CACHE_FORMAT (3)
+
+/// The things that happened when parsing a script, in the order that they
+/// happened, which a bytecode cache replays.
+typedef enum BcCacheEvent
+{
+	/// The end of the events.
+	BC_CACHE_END,
+
+	/// A function was defined.
+	BC_CACHE_DEF,
+
+	/// Code was added to main and can be executed.
+	BC_CACHE_EXEC,
+
+	/// A `limits` statement.
+	BC_CACHE_LIMITS,
+
+	/// A `quit` statement.
+	BC_CACHE_QUIT,
+
+} BcCacheEvent;
+
+/// The state of bc when compiling a script into a bytecode cache. See
+/// manuals/development.md#bytecode-caches for the format.
+typedef struct BcCache
+{
+	/// The header, with everything that has to match for a cache to be run.
+	BcVec head;
+
+	/// The events.
+	BcVec events;
+
+	/// The number of functions, variables, arrays, constants, and strings when
+	/// compiling started.
+	size_t fns, vars, arrs, consts, strs;
+
+	/// The lengths of the code and labels of main that have been recorded.
+	size_t code, labels;
+
+	/// For each function, the version and code length it had when it was last
+	/// recorded, so that only changed functions are recorded again.
+	BcVec defs;
+
+} BcCache;
+
+/// A bytecode cache that has been opened to run.
+typedef struct BcCacheFile
+{
+	/// The contents of the cache.
+	char* data;
+
+	/// The length of the contents.
+	size_t len;
+
+	/// The position of the reader in the contents.
+	size_t pos;
+
+	/// The position of the names, where running starts.
+	size_t body;
+
+	/// True if the reader ran off the end or found something that was wrong.
+	bool bad;
+
+	/// True if the cache can be run. If not, the source has to be run instead.
+	bool good;
+
+	/// The path of the source that the cache was compiled from.
+	char* src;
+
+} BcCacheFile;
+
+/**
+ * Starts compiling a script into a bytecode cache.
+ * @param c     The cache.
+ * @param path  The path of the script.
+ * @param text  The text of the script.
+ */
+void
+bc_cache_init(BcCache* c, const char* path, const char* text);
+
+/**
+ * Records everything that has been parsed since the last call. This must be
+ * called whenever bc would execute what it parsed.
+ * @param c  The cache.
+ */
+void
+bc_cache_step(BcCache* c);
+
+/**
+ * Records a statement that runs when it is parsed.
+ * @param c  The cache.
+ * @param e  The event for the statement.
+ */
+void
+bc_cache_event(BcCache* c, BcCacheEvent e);
+
+/**
+ * Writes a bytecode cache to a file and frees it.
+ * @param c     The cache.
+ * @param path  The path of the file to write.
+ */
+void
+bc_cache_write(BcCache* c, const char* path);
+
+/**
+ * Frees a bytecode cache without writing it.
+ * @param c  The cache.
+ */
+void
+bc_cache_free(BcCache* c);
+
+/**
+ * Opens a file if it is a bytecode cache and checks whether it can be run.
+ * @param c     The cache to fill.
+ * @param path  The path of the file.
+ * @return      True if the file is a bytecode cache, false otherwise. If true,
+ *              bc_cache_close() must be called.
+ */
+bool
+bc_cache_open(BcCacheFile* c, const char* path);
+
+/**
+ * Runs a bytecode cache that bc_cache_open() said was good.
+ * @param c  The cache.
+ */
+void
+bc_cache_run(BcCacheFile* c);
+
+/**
+ * Closes a bytecode cache.
+ * @param c  The cache.
+ */
+void
+bc_cache_close(BcCacheFile* c);
+
+#endif // !BC_ENABLE_LIBRARY
+
 /// References to the signal message and its length.
 extern const char bc_sig_msg[];
 extern const uchar bc_sig_msg_len;
@@ -422,6 +599,12 @@ extern const uint8_t bc_parse_exprs[];
 /// A reference to an array of bc operators.
 extern const uchar bc_parse_ops[];
 
+/// A reference to an array of the strings of the operators that can be folded.
+extern const char* const bc_parse_fold_ops[];
+
+/// A reference to an array of the complements of the relational operators.
+extern const uchar bc_parse_rel_nots[];
+
 // References to the various instances of BcParseNext's.
 
 /// A reference to what tokens are valid as next tokens when parsing normal
@@ -98,6 +98,14 @@ typedef uint32_t BclRandInt;
 
 #endif // BC_LONG_BIT >= 64
 
+// BclLimb is the type of the limbs that bcl can import numbers from and export
+// numbers to. Each limb holds BCL_LIMB_DIGS decimal digits, so it is always
+// less than BCL_LIMB_POW.
+typedef uint32_t BclLimb;
+
+#define BCL_LIMB_DIGS (9)
+#define BCL_LIMB_POW (1000000000)
+
 #ifndef BC_ENABLE_LIBRARY
 #define BC_ENABLE_LIBRARY (1)
 #endif // BC_ENABLE_LIBRARY
@@ -136,6 +144,18 @@ struct BclCtxt;
 
 typedef struct BclCtxt* BclContext;
 
+struct BclExpression;
+
+typedef struct BclExpression* BclExpr;
+
+struct BclFut;
+
+typedef struct BclFut* BclFuture;
+
+struct BclShr;
+
+typedef struct BclShr* BclShared;
+
 BclError
 bcl_start(void);
 
@@ -244,6 +264,31 @@ bcl_bigdig_keep(BclNumber n, BclBigDig* result);
 BclNumber
 bcl_bigdig2num(BclBigDig val);
 
+BclError
+bcl_limbs(BclNumber n, BclLimb* ipart, size_t* ilen, BclLimb* fpart,
+          size_t* flen);
+
+BclError
+bcl_limbs_keep(BclNumber n, BclLimb* ipart, size_t* ilen, BclLimb* fpart,
+               size_t* flen);
+
+BclNumber
+bcl_limbs2num(const BclLimb* ipart, size_t ilen, const BclLimb* fpart,
+              size_t scale, bool neg);
+
+BclError
+bcl_bytes(BclNumber n, bool bigEndian, unsigned char* ipart, size_t* ilen,
+          unsigned char* fpart, size_t* flen);
+
+BclError
+bcl_bytes_keep(BclNumber n, bool bigEndian, unsigned char* ipart,
+               size_t* ilen, unsigned char* fpart, size_t* flen);
+
+BclNumber
+bcl_bytes2num(const unsigned char* ipart, size_t ilen,
+              const unsigned char* fpart, size_t flen, size_t scale, bool neg,
+              bool bigEndian);
+
 BclNumber
 bcl_add(BclNumber a, BclNumber b);
 
@@ -310,6 +355,67 @@ bcl_modexp(BclNumber a, BclNumber b, BclNumber c);
 BclNumber
 bcl_modexp_keep(BclNumber a, BclNumber b, BclNumber c);
 
+BclNumber
+bcl_fma(BclNumber a, BclNumber b, BclNumber c);
+
+BclNumber
+bcl_fma_keep(BclNumber a, BclNumber b, BclNumber c);
+
+BclError
+bcl_addmul(BclNumber a, BclNumber b, BclNumber c);
+
+BclError
+bcl_submul(BclNumber a, BclNumber b, BclNumber c);
+
+BclError
+bcl_isprime(BclNumber n, bool bpsw, bool* result);
+
+BclError
+bcl_isprime_keep(BclNumber n, bool bpsw, bool* result);
+
+BclNumber
+bcl_nextprime(BclNumber a);
+
+BclNumber
+bcl_nextprime_keep(BclNumber a);
+
+BclNumber
+bcl_modinv(BclNumber a, BclNumber b);
+
+BclNumber
+bcl_modinv_keep(BclNumber a, BclNumber b);
+
+BclError
+bcl_egcd(BclNumber a, BclNumber b, BclNumber* g, BclNumber* x, BclNumber* y);
+
+BclError
+bcl_egcd_keep(BclNumber a, BclNumber b, BclNumber* g, BclNumber* x,
+              BclNumber* y);
+
+BclError
+bcl_add_array(const BclNumber* a, const BclNumber* b, BclNumber* c, size_t n);
+
+BclError
+bcl_sub_array(const BclNumber* a, const BclNumber* b, BclNumber* c, size_t n);
+
+BclError
+bcl_mul_array(const BclNumber* a, const BclNumber* b, BclNumber* c, size_t n);
+
+BclError
+bcl_div_array(const BclNumber* a, const BclNumber* b, BclNumber* c, size_t n);
+
+BclNumber
+bcl_sum(const BclNumber* a, size_t n);
+
+BclNumber
+bcl_prod(const BclNumber* a, size_t n);
+
+BclNumber
+bcl_dot(const BclNumber* a, const BclNumber* b, size_t n);
+
+BclError
+bcl_axpy(BclNumber a, const BclNumber* x, const BclNumber* y, size_t n);
+
 ssize_t
 bcl_cmp(BclNumber a, BclNumber b);
 
@@ -328,6 +434,12 @@ bcl_string(BclNumber n);
 char*
 bcl_string_keep(BclNumber n);
 
+BclError
+bcl_string_into(BclNumber n, char* buf, size_t size, size_t* len);
+
+BclError
+bcl_string_into_keep(BclNumber n, char* buf, size_t size, size_t* len);
+
 BclNumber
 bcl_irand(BclNumber a);
 
@@ -364,6 +476,370 @@ bcl_rand_int(void);
 BclRandInt
 bcl_rand_bounded(BclRandInt bound);
 
+BclError
+bcl_expr_compile(const char* restrict text, BclExpr* expr);
+
+size_t
+bcl_expr_nvars(BclExpr expr);
+
+const char*
+bcl_expr_var(BclExpr expr, size_t i);
+
+BclNumber
+bcl_expr_eval(BclExpr expr, const BclNumber* vals, size_t n);
+
+void
+bcl_expr_free(BclExpr expr);
+
+BclError
+bcl_pool_start(size_t threads);
+
+void
+bcl_pool_end(void);
+
+BclError
+bcl_async_mul(BclNumber a, BclNumber b, BclFuture* f);
+
+BclError
+bcl_async_div(BclNumber a, BclNumber b, BclFuture* f);
+
+BclError
+bcl_async_pow(BclNumber a, BclNumber b, BclFuture* f);
+
+BclError
+bcl_async_sqrt(BclNumber a, BclFuture* f);
+
+BclError
+bcl_async_modexp(BclNumber a, BclNumber b, BclNumber c, BclFuture* f);
+
+BclError
+bcl_async_parse(const char* restrict val, BclFuture* f);
+
+BclError
+bcl_async_string(BclNumber n, BclFuture* f);
+
+bool
+bcl_future_done(BclFuture f);
+
+BclError
+bcl_future_wait(BclFuture f);
+
+BclNumber
+bcl_future_num(BclFuture f);
+
+char*
+bcl_future_string(BclFuture f);
+
+void
+bcl_future_cancel(BclFuture f);
+
+BclError
+bcl_share(BclNumber n, BclShared* s);
+
+BclError
+bcl_share_keep(BclNumber n, BclShared* s);
+
+BclNumber
+bcl_shared_num(BclShared s);
+
+void
+bcl_shared_free(BclShared s);
+
+// Each of these is the same as the function above whose name is the same
+// without "ctxt_", except that it takes the context as its first argument
+// instead of using the current context. See the Explicit Contexts section of
+// the bcl(3) manual.
+
+BclError
+bcl_ctxt_err(BclContext ctxt, BclNumber n);
+
+BclNumber
+bcl_ctxt_num_create(BclContext ctxt);
+
+void
+bcl_ctxt_num_free(BclContext ctxt, BclNumber n);
+
+BclError
+bcl_ctxt_copy(BclContext ctxt, BclNumber d, BclNumber s);
+
+BclNumber
+bcl_ctxt_dup(BclContext ctxt, BclNumber s);
+
+bool
+bcl_ctxt_num_neg(BclContext ctxt, BclNumber n);
+
+void
+bcl_ctxt_num_setNeg(BclContext ctxt, BclNumber n, bool neg);
+
+size_t
+bcl_ctxt_num_scale(BclContext ctxt, BclNumber n);
+
+BclError
+bcl_ctxt_num_setScale(BclContext ctxt, BclNumber n, size_t scale);
+
+size_t
+bcl_ctxt_num_len(BclContext ctxt, BclNumber n);
+
+BclError
+bcl_ctxt_bigdig(BclContext ctxt, BclNumber n, BclBigDig* result);
+
+BclError
+bcl_ctxt_bigdig_keep(BclContext ctxt, BclNumber n, BclBigDig* result);
+
+BclNumber
+bcl_ctxt_bigdig2num(BclContext ctxt, BclBigDig val);
+
+BclError
+bcl_ctxt_limbs(BclContext ctxt, BclNumber n, BclLimb* ipart, size_t* ilen,
+               BclLimb* fpart, size_t* flen);
+
+BclError
+bcl_ctxt_limbs_keep(BclContext ctxt, BclNumber n, BclLimb* ipart,
+                    size_t* ilen, BclLimb* fpart, size_t* flen);
+
+BclNumber
+bcl_ctxt_limbs2num(BclContext ctxt, const BclLimb* ipart, size_t ilen,
+                   const BclLimb* fpart, size_t scale, bool neg);
+
+BclError
+bcl_ctxt_bytes(BclContext ctxt, BclNumber n, bool bigEndian,
+               unsigned char* ipart, size_t* ilen, unsigned char* fpart,
+               size_t* flen);
+
+BclError
+bcl_ctxt_bytes_keep(BclContext ctxt, BclNumber n, bool bigEndian,
+                    unsigned char* ipart, size_t* ilen, unsigned char* fpart,
+                    size_t* flen);
+
+BclNumber
+bcl_ctxt_bytes2num(BclContext ctxt, const unsigned char* ipart, size_t ilen,
+                   const unsigned char* fpart, size_t flen, size_t scale,
+                   bool neg, bool bigEndian);
+
+BclNumber
+bcl_ctxt_add(BclContext ctxt, BclNumber a, BclNumber b);
+
+BclNumber
+bcl_ctxt_add_keep(BclContext ctxt, BclNumber a, BclNumber b);
+
+BclNumber
+bcl_ctxt_sub(BclContext ctxt, BclNumber a, BclNumber b);
+
+BclNumber
+bcl_ctxt_sub_keep(BclContext ctxt, BclNumber a, BclNumber b);
+
+BclNumber
+bcl_ctxt_mul(BclContext ctxt, BclNumber a, BclNumber b);
+
+BclNumber
+bcl_ctxt_mul_keep(BclContext ctxt, BclNumber a, BclNumber b);
+
+BclNumber
+bcl_ctxt_div(BclContext ctxt, BclNumber a, BclNumber b);
+
+BclNumber
+bcl_ctxt_div_keep(BclContext ctxt, BclNumber a, BclNumber b);
+
+BclNumber
+bcl_ctxt_mod(BclContext ctxt, BclNumber a, BclNumber b);
+
+BclNumber
+bcl_ctxt_mod_keep(BclContext ctxt, BclNumber a, BclNumber b);
+
+BclNumber
+bcl_ctxt_pow(BclContext ctxt, BclNumber a, BclNumber b);
+
+BclNumber
+bcl_ctxt_pow_keep(BclContext ctxt, BclNumber a, BclNumber b);
+
+BclNumber
+bcl_ctxt_lshift(BclContext ctxt, BclNumber a, BclNumber b);
+
+BclNumber
+bcl_ctxt_lshift_keep(BclContext ctxt, BclNumber a, BclNumber b);
+
+BclNumber
+bcl_ctxt_rshift(BclContext ctxt, BclNumber a, BclNumber b);
+
+BclNumber
+bcl_ctxt_rshift_keep(BclContext ctxt, BclNumber a, BclNumber b);
+
+BclNumber
+bcl_ctxt_sqrt(BclContext ctxt, BclNumber a);
+
+BclNumber
+bcl_ctxt_sqrt_keep(BclContext ctxt, BclNumber a);
+
+BclError
+bcl_ctxt_divmod(BclContext ctxt, BclNumber a, BclNumber b, BclNumber* c,
+                BclNumber* d);
+
+BclError
+bcl_ctxt_divmod_keep(BclContext ctxt, BclNumber a, BclNumber b, BclNumber* c,
+                     BclNumber* d);
+
+BclNumber
+bcl_ctxt_modexp(BclContext ctxt, BclNumber a, BclNumber b, BclNumber c);
+
+BclNumber
+bcl_ctxt_modexp_keep(BclContext ctxt, BclNumber a, BclNumber b, BclNumber c);
+
+BclNumber
+bcl_ctxt_fma(BclContext ctxt, BclNumber a, BclNumber b, BclNumber c);
+
+BclNumber
+bcl_ctxt_fma_keep(BclContext ctxt, BclNumber a, BclNumber b, BclNumber c);
+
+BclError
+bcl_ctxt_addmul(BclContext ctxt, BclNumber a, BclNumber b, BclNumber c);
+
+BclError
+bcl_ctxt_submul(BclContext ctxt, BclNumber a, BclNumber b, BclNumber c);
+
+BclError
+bcl_ctxt_isprime(BclContext ctxt, BclNumber n, bool bpsw, bool* result);
+
+BclError
+bcl_ctxt_isprime_keep(BclContext ctxt, BclNumber n, bool bpsw, bool* result);
+
+BclNumber
+bcl_ctxt_nextprime(BclContext ctxt, BclNumber a);
+
+BclNumber
+bcl_ctxt_nextprime_keep(BclContext ctxt, BclNumber a);
+
+BclNumber
+bcl_ctxt_modinv(BclContext ctxt, BclNumber a, BclNumber b);
+
+BclNumber
+bcl_ctxt_modinv_keep(BclContext ctxt, BclNumber a, BclNumber b);
+
+BclError
+bcl_ctxt_egcd(BclContext ctxt, BclNumber a, BclNumber b, BclNumber* g,
+              BclNumber* x, BclNumber* y);
+
+BclError
+bcl_ctxt_egcd_keep(BclContext ctxt, BclNumber a, BclNumber b, BclNumber* g,
+                   BclNumber* x, BclNumber* y);
+
+BclError
+bcl_ctxt_add_array(BclContext ctxt, const BclNumber* a, const BclNumber* b,
+                   BclNumber* c, size_t n);
+
+BclError
+bcl_ctxt_sub_array(BclContext ctxt, const BclNumber* a, const BclNumber* b,
+                   BclNumber* c, size_t n);
+
+BclError
+bcl_ctxt_mul_array(BclContext ctxt, const BclNumber* a, const BclNumber* b,
+                   BclNumber* c, size_t n);
+
+BclError
+bcl_ctxt_div_array(BclContext ctxt, const BclNumber* a, const BclNumber* b,
+                   BclNumber* c, size_t n);
+
+BclNumber
+bcl_ctxt_sum(BclContext ctxt, const BclNumber* a, size_t n);
+
+BclNumber
+bcl_ctxt_prod(BclContext ctxt, const BclNumber* a, size_t n);
+
+BclNumber
+bcl_ctxt_dot(BclContext ctxt, const BclNumber* a, const BclNumber* b,
+             size_t n);
+
+BclError
+bcl_ctxt_axpy(BclContext ctxt, BclNumber a, const BclNumber* x,
+              const BclNumber* y, size_t n);
+
+ssize_t
+bcl_ctxt_cmp(BclContext ctxt, BclNumber a, BclNumber b);
+
+void
+bcl_ctxt_zero(BclContext ctxt, BclNumber n);
+
+void
+bcl_ctxt_one(BclContext ctxt, BclNumber n);
+
+BclNumber
+bcl_ctxt_parse(BclContext ctxt, const char* restrict val);
+
+char*
+bcl_ctxt_string(BclContext ctxt, BclNumber n);
+
+char*
+bcl_ctxt_string_keep(BclContext ctxt, BclNumber n);
+
+BclError
+bcl_ctxt_string_into(BclContext ctxt, BclNumber n, char* buf, size_t size,
+                     size_t* len);
+
+BclError
+bcl_ctxt_string_into_keep(BclContext ctxt, BclNumber n, char* buf,
+                          size_t size, size_t* len);
+
+BclNumber
+bcl_ctxt_irand(BclContext ctxt, BclNumber a);
+
+BclNumber
+bcl_ctxt_irand_keep(BclContext ctxt, BclNumber a);
+
+BclNumber
+bcl_ctxt_frand(BclContext ctxt, size_t places);
+
+BclNumber
+bcl_ctxt_ifrand(BclContext ctxt, BclNumber a, size_t places);
+
+BclNumber
+bcl_ctxt_ifrand_keep(BclContext ctxt, BclNumber a, size_t places);
+
+BclError
+bcl_ctxt_rand_seedWithNum(BclContext ctxt, BclNumber n);
+
+BclError
+bcl_ctxt_rand_seedWithNum_keep(BclContext ctxt, BclNumber n);
+
+BclNumber
+bcl_ctxt_rand_seed2num(BclContext ctxt);
+
+BclError
+bcl_ctxt_expr_compile(BclContext ctxt, const char* restrict text,
+                      BclExpr* expr);
+
+BclError
+bcl_ctxt_async_mul(BclContext ctxt, BclNumber a, BclNumber b, BclFuture* f);
+
+BclError
+bcl_ctxt_async_div(BclContext ctxt, BclNumber a, BclNumber b, BclFuture* f);
+
+BclError
+bcl_ctxt_async_pow(BclContext ctxt, BclNumber a, BclNumber b, BclFuture* f);
+
+BclError
+bcl_ctxt_async_sqrt(BclContext ctxt, BclNumber a, BclFuture* f);
+
+BclError
+bcl_ctxt_async_modexp(BclContext ctxt, BclNumber a, BclNumber b, BclNumber c,
+                      BclFuture* f);
+
+BclError
+bcl_ctxt_async_parse(BclContext ctxt, const char* restrict val, BclFuture* f);
+
+BclError
+bcl_ctxt_async_string(BclContext ctxt, BclNumber n, BclFuture* f);
+
+BclNumber
+bcl_ctxt_future_num(BclContext ctxt, BclFuture f);
+
+BclError
+bcl_ctxt_share(BclContext ctxt, BclNumber n, BclShared* s);
+
+BclError
+bcl_ctxt_share_keep(BclContext ctxt, BclNumber n, BclShared* s);
+
+BclNumber
+bcl_ctxt_shared_num(BclContext ctxt, BclShared s);
+
 #endif // BC_ENABLE_LIBRARY
 
 #endif // BC_BCL_H
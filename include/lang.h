@@ -180,6 +180,8 @@ typedef enum BcInst
 	BC_INST_ABS,
 	BC_INST_IS_NUMBER,
 	BC_INST_IS_STRING,
+	BC_INST_IS_PRIME,
+	BC_INST_NEXT_PRIME,
 
 #if BC_ENABLE_EXTRA_MATH
 	/// Another builtin function.
@@ -258,6 +260,36 @@ typedef enum BcInst
 
 	/// Special halt instruction.
 	BC_INST_HALT,
+
+	/// The following are superinstructions. The parser never generates them;
+	/// they are written over the first instruction of a common sequence by
+	/// bc_parse_optimize(), which leaves the rest of the sequence in place as
+	/// operands. For more details, see the development manual
+	/// (manuals/development.md#superinstructions).
+
+	/// Replaces BC_INST_VAR in x op= c and x = x op c, where c is a constant.
+	BC_INST_VAR_OP_CONST,
+
+	/// Replaces BC_INST_ARRAY_ELEM in a[i] op= c, where c is a constant.
+	BC_INST_ARRAY_OP_CONST,
+
+	/// Replaces a relational operator that is followed by BC_INST_JUMP_ZERO.
+	BC_INST_REL_JUMP_ZERO,
+
+	/// Replaces BC_INST_VAR in x = e and x op= e, where e is made of variables,
+	/// constants, and binary operators. e is evaluated in registers.
+	BC_INST_VAR_ASSIGN_REGS,
+
+	/// Replaces BC_INST_VAR in x += a * b and x -= a * b, where a and b are
+	/// variables or constants. The product is accumulated into x in place.
+	BC_INST_VAR_ADDMUL,
+
+	/// Replaces BC_INST_CALL in return f(...) when f is the function that is
+	/// returning. It reuses the current frame if it can.
+	BC_INST_TAIL_CALL,
+
+	/// Replaces BC_INST_CALL when the body of the function is inlined after it.
+	BC_INST_INLINE,
 #endif // BC_ENABLED
 
 	/// Pop an item off of the results stack.
@@ -272,6 +304,12 @@ typedef enum BcInst
 	/// Do divide and modulus at the same time.
 	BC_INST_DIVMOD,
 
+	/// Modular multiplicative inverse.
+	BC_INST_MODINV,
+
+	/// Extended GCD; produces the GCD and both Bezout coefficients.
+	BC_INST_EGCD,
+
 	/// Turns a number into a string and prints it.
 	BC_INST_PRINT_STREAM,
 
@@ -378,6 +416,20 @@ typedef struct BcConst
 	/// The parsed constant.
 	BcNum num;
 
+#if BC_ENABLED
+	/// If this constant was folded from an operator on other constants by
+	/// bc_parse_optimize(), this is the operator's instruction. Otherwise, it
+	/// is BC_INST_INVALID.
+	uchar op;
+
+	/// The indices of the operands of a folded constant. Unary operators only
+	/// use the left one.
+	size_t lhs, rhs;
+
+	/// The last scale that a folded constant was computed in.
+	size_t scale;
+#endif // BC_ENABLED
+
 } BcConst;
 
 /// A function. This is also used in dc, not just bc. The reason is that strings
@@ -409,6 +461,17 @@ typedef struct BcFunc
 #if BC_ENABLED
 	/// True if the function is a void function.
 	bool voidfn;
+
+	/// True if the results of the function should be memoized.
+	bool memo;
+
+	/// The number of times the function has been reset. Copies of the function
+	/// that were inlined compare this to find out if they are stale.
+	size_t version;
+
+	/// If the function is in a math library and has not been parsed yet, this
+	/// is where its definition starts in the library. Otherwise, it is NULL.
+	const char* lib;
 #endif // BC_ENABLED
 
 } BcFunc;
@@ -433,6 +496,11 @@ typedef enum BcResultType
 	/// expressions.
 	BC_RESULT_TEMP,
 
+	/// Result is a constant. Instead of a copy of the constant, it has the
+	/// index of the constant, which is detached into a copy if the constant is
+	/// about to change. See bc_program_const().
+	BC_RESULT_CONST,
+
 	/// Special casing the two below gave performance improvements.
 
 	/// Result is a 0.
@@ -481,7 +549,8 @@ typedef union BcResultData
 	BcVec v;
 
 	/// A variable, array, or array element reference. This could also be a
-	/// string if a string is not stored in a variable (dc only).
+	/// string if a string is not stored in a variable (dc only). For a
+	/// constant, only loc is used, and it is the index of the constant.
 	BcLoc loc;
 
 } BcResultData;
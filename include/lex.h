@@ -343,6 +343,12 @@ typedef enum BcLexType
 	/// bc is_string keyword.
 	BC_LEX_KW_IS_STRING,
 
+	/// bc is_prime keyword.
+	BC_LEX_KW_IS_PRIME,
+
+	/// bc next_prime keyword.
+	BC_LEX_KW_NEXT_PRIME,
+
 #if BC_ENABLE_EXTRA_MATH
 
 	/// bc irand keyword.
@@ -359,6 +365,12 @@ typedef enum BcLexType
 	/// bc divmod keyword.
 	BC_LEX_KW_DIVMOD,
 
+	/// bc modinv keyword.
+	BC_LEX_KW_MODINV,
+
+	/// bc egcd keyword.
+	BC_LEX_KW_EGCD,
+
 	/// bc quit keyword.
 	BC_LEX_KW_QUIT,
 
@@ -200,12 +200,15 @@ typedef BcNum BclNum;
 	while (0)
 
 /**
- * A footer for functions that do not return an error code.
+ * A footer for functions that do not return an error code. This also clears
+ * sig_pop, which the first jump of an error sets; otherwise, the next error
+ * would pop the jmp_buf of the function that it is in and jump to a stale one.
  */
 #define BC_FUNC_FOOTER_NO_ERR(vm) \
 	do                            \
 	{                             \
 		BC_UNSETJMP(vm);          \
+		vm->sig_pop = 0;          \
 	}                             \
 	while (0)
 
@@ -242,15 +245,35 @@ typedef BcNum BclNum;
 	}                                                                          \
 	while (0)
 
+/**
+ * Gets the thread data and the context. If the context is NULL, the current
+ * context of the thread is used. Otherwise, the thread data is taken from the
+ * context, which means that it does not need to be looked up.
+ * @param vm  The thread data.
+ * @param c   The context.
+ */
+#define BCL_CTXT(vm, c)                \
+	do                                 \
+	{                                  \
+		if ((c) != NULL) vm = (c)->vm; \
+		else                           \
+		{                              \
+			vm = bcl_getspecific();    \
+			c = bcl_contextHelper(vm); \
+		}                              \
+	}                                  \
+	while (0)
+
 /**
  * A header to check the context and return an error encoded in a number if it
  * is bad.
- * @param c  The context.
+ * @param vm  The thread data.
+ * @param c   The context.
  */
 #define BC_CHECK_CTXT(vm, c)                                   \
 	do                                                         \
 	{                                                          \
-		c = bcl_contextHelper(vm);                             \
+		BCL_CTXT(vm, c);                                       \
 		if (BC_ERR(c == NULL))                                 \
 		{                                                      \
 			BclNumber n_num_;                                  \
@@ -262,12 +285,13 @@ typedef BcNum BclNum;
 
 /**
  * A header to check the context and return an error directly if it is bad.
- * @param c  The context.
+ * @param vm  The thread data.
+ * @param c   The context.
  */
 #define BC_CHECK_CTXT_ERR(vm, c)              \
 	do                                        \
 	{                                         \
-		c = bcl_contextHelper(vm);            \
+		BCL_CTXT(vm, c);                      \
 		if (BC_ERR(c == NULL))                \
 		{                                     \
 			return BCL_ERROR_INVALID_CONTEXT; \
@@ -277,12 +301,13 @@ typedef BcNum BclNum;
 
 /**
  * A header to check the context and abort if it is bad.
- * @param c  The context.
+ * @param vm  The thread data.
+ * @param c   The context.
  */
 #define BC_CHECK_CTXT_ASSERT(vm, c) \
 	do                              \
 	{                               \
-		c = bcl_contextHelper(vm);  \
+		BCL_CTXT(vm, c);            \
 		assert(c != NULL);          \
 	}                               \
 	while (0)
@@ -377,8 +402,250 @@ typedef struct BclCtxt
 	/// not used (because they were freed).
 	BcVec free_nums;
 
+	/// The thread data of the thread that created the context. This is used by
+	/// the functions that take the context as an argument so that they do not
+	/// have to look it up.
+	BcVm* vm;
+
 } BclCtxt;
 
+/// A compiled expression. See bcl_expr_compile().
+typedef struct BclExpression
+{
+	/// The code, in postfix order. It uses bc's instructions and bytecode
+	/// indices, and BC_INST_NUM and BC_INST_VAR are followed by the index of
+	/// the constant or variable.
+	BcVec code;
+
+	/// The constants, as BcNums. These are parsed when the expression is
+	/// compiled.
+	BcVec consts;
+
+	/// The names of the variables, as vectors of char, in the order that they
+	/// first appear.
+	BcVec vars;
+
+	/// The temporaries for the results of operators. There are two for each
+	/// level of the stack.
+	BcVec temps;
+
+	/// The evaluation stack, as pointers to the BcNum operands. It is
+	/// allocated when the expression is compiled.
+	BcVec stack;
+
+	/// The context that the expression was compiled in and evaluates in.
+	BclCtxt* ctxt;
+
+} BclExpression;
+
+#if BC_ENABLE_LIBRARY
+
+/// The operations that can be run by the worker pool.
+typedef enum BclJob
+{
+	/// Multiply.
+	BCL_JOB_MUL,
+
+	/// Divide.
+	BCL_JOB_DIV,
+
+	/// Power.
+	BCL_JOB_POW,
+
+	/// Square root.
+	BCL_JOB_SQRT,
+
+	/// Modular exponentiation.
+	BCL_JOB_MODEXP,
+
+	/// Parse a string into a number.
+	BCL_JOB_PARSE,
+
+	/// Convert a number to a string.
+	BCL_JOB_STRING,
+
+} BclJob;
+
+/// The states of a future.
+typedef enum BclFutState
+{
+	/// The job is in the queue.
+	BCL_FUT_QUEUED,
+
+	/// A worker is running the job.
+	BCL_FUT_RUNNING,
+
+	/// The job is finished.
+	BCL_FUT_DONE,
+
+} BclFutState;
+
+/// A future for a job that was submitted to the worker pool. Everything except
+/// the state and the cancel flag belongs to whichever thread has the job; the
+/// state and the cancel flag are protected by the lock of the pool.
+typedef struct BclFut
+{
+	/// The next future in the queue.
+	struct BclFut* next;
+
+	/// The operands. They are copies of the numbers that were submitted, so
+	/// they do not belong to any context.
+	BclNum args[3];
+
+	/// The number of operands.
+	size_t nargs;
+
+	/// The result, if it is a number.
+	BclNum res;
+
+	/// The string to parse or the resulting string, depending on the job.
+	char* str;
+
+	/// The scale of the submitting context.
+	size_t scale;
+
+	/// The ibase of the submitting context.
+	size_t ibase;
+
+	/// The obase of the submitting context.
+	size_t obase;
+
+	/// The leading zeroes setting of the submitting thread.
+	bool leading_zeroes;
+
+	/// The digit clamp setting of the submitting thread.
+	bool digit_clamp;
+
+	/// True if the future was cancelled while its job was running. The worker
+	/// frees the future when it is done.
+	bool cancelled;
+
+	/// The job.
+	BclJob job;
+
+	/// The state.
+	BclFutState state;
+
+	/// The error from the job, if any.
+	BclError err;
+
+} BclFut;
+
+#ifndef _WIN32
+
+typedef pthread_mutex_t BclLock;
+typedef pthread_cond_t BclCond;
+typedef pthread_t BclThread;
+
+#else // _WIN32
+
+typedef CRITICAL_SECTION BclLock;
+typedef CONDITION_VARIABLE BclCond;
+typedef HANDLE BclThread;
+
+#endif // _WIN32
+
+/// The worker pool. See bcl_pool_start().
+typedef struct BclPool
+{
+	/// The lock for everything in the pool and the states of the futures.
+	BclLock lock;
+
+	/// Signaled when a job is queued or when the pool is stopping.
+	BclCond work;
+
+	/// Signaled when a job is finished or when a worker has started.
+	BclCond done;
+
+	/// The first future in the queue.
+	BclFut* head;
+
+	/// The last future in the queue.
+	BclFut* tail;
+
+	/// The worker threads.
+	BclThread* threads;
+
+	/// The number of worker threads that were created.
+	size_t nthreads;
+
+	/// The number of workers that have finished starting.
+	size_t started;
+
+	/// The first error from starting a worker, if any.
+	BclError err;
+
+	/// True if the workers should exit once the queue is empty.
+	bool stop;
+
+} BclPool;
+
+#ifndef _WIN32
+
+typedef size_t BclRefs;
+
+/**
+ * Atomically adds a reference and returns the new count.
+ * @param r  The reference count.
+ */
+#define BCL_REFS_INC(r) (__atomic_add_fetch(&(r), 1, __ATOMIC_RELAXED))
+
+/**
+ * Atomically drops a reference and returns the new count. This is acquire and
+ * release so that the thread that frees the number sees every read of it.
+ * @param r  The reference count.
+ */
+#define BCL_REFS_DEC(r) (__atomic_sub_fetch(&(r), 1, __ATOMIC_ACQ_REL))
+
+#else // _WIN32
+
+typedef LONG volatile BclRefs;
+
+#define BCL_REFS_INC(r) (InterlockedIncrement(&(r)))
+#define BCL_REFS_DEC(r) (InterlockedDecrement(&(r)))
+
+#endif // _WIN32
+
+/**
+ * The capacity of a number in a context that is a view of a shared number.
+ * Nothing that only reads a number uses its capacity, and no real number can
+ * have this capacity, so it marks the number as not owning its limbs.
+ */
+#define BCL_SHARED_CAP (SIZE_MAX)
+
+/**
+ * Returns true if the BcNum is a view of a shared number.
+ * @param n  The BcNum.
+ * @return   True if @a n does not own its limbs.
+ */
+#define BCL_IS_SHARED(n) ((n)->cap == BCL_SHARED_CAP)
+
+/**
+ * Returns the shared number that a view's limbs belong to.
+ * @param n  The BcNum, which must be a view of a shared number.
+ * @return   The BclShr of @a n.
+ */
+#define BCL_SHARED(n) ((BclShr*) ((char*) (n)->num - offsetof(BclShr, num)))
+
+/// A shared number. See bcl_share(). It is one allocation, with the limbs right
+/// after the header, so that a view can find the header from its limbs.
+typedef struct BclShr
+{
+	/// The number of references: one for the handle, and one for each view in
+	/// a context.
+	BclRefs refs;
+
+	/// The number that views are copied from. Its limbs are @a num, and its
+	/// capacity is BCL_SHARED_CAP.
+	BcNum n;
+
+	/// The limbs.
+	BcDig num[];
+
+} BclShr;
+
+#endif // BC_ENABLE_LIBRARY
+
 /**
  * Returns the @a BcVm for the current thread.
  * @return  The vm for the current thread.
@@ -78,6 +78,10 @@ typedef BclBigDig BcBigDig;
 /// The actual limb type.
 typedef int_least32_t BcDig;
 
+/// The number of bytes that can be multiplied into or divided out of a number
+/// at a time without overflowing a BcBigDig.
+#define BC_NUM_BYTES_CHUNK (4)
+
 #elif BC_LONG_BIT >= 32
 
 /// The biggest number held by a BcBigDig.
@@ -99,6 +103,10 @@ typedef int_least32_t BcDig;
 /// The actual limb type.
 typedef int_least16_t BcDig;
 
+/// The number of bytes that can be multiplied into or divided out of a number
+/// at a time without overflowing a BcBigDig.
+#define BC_NUM_BYTES_CHUNK (2)
+
 #else
 
 /// LONG_BIT must be at least 32 on POSIX. We depend on that.
@@ -140,6 +148,23 @@ typedef struct BcNum
 
 } BcNum;
 
+/// A cached reciprocal of a divisor. See the development manual
+/// (manuals/development.md#caching-of-reciprocals) for how it is used.
+typedef struct BcNumRecip
+{
+	/// The divisor, as an integer. If its len is 0, the entry is unused.
+	BcNum div;
+
+	/// The reciprocal, which is floor(BC_BASE_POW^prec / div), if prec is
+	/// non-zero.
+	BcNum recip;
+
+	/// The precision of the reciprocal, in limbs. If this is 0, the divisor has
+	/// only been seen once, and the reciprocal has not been calculated.
+	size_t prec;
+
+} BcNumRecip;
+
 #if BC_ENABLE_EXTRA_MATH
 
 // Forward declaration
@@ -172,10 +197,64 @@ struct BcRNG;
 #error BC_NUM_KARATSUBA_LEN must be at least 16.
 #endif // BC_NUM_KARATSUBA_LEN
 
+/// The number of limbs below the truncation point that a short product
+/// calculates. These are used to make sure that the limbs that are kept are
+/// the same as they would be in the full product.
+#define BC_NUM_SHORT_MUL_GUARD (2)
+
+/// The length above which a short product is no longer faster than a full
+/// Karatsuba product.
+#define BC_NUM_SHORT_MUL_LEN (BC_NUM_KARATSUBA_LEN * 4)
+
+/// The number of divisors that the reciprocal cache remembers.
+#define BC_NUM_RECIP_SLOTS (4)
+
+/// The minimum number of limbs in a divisor before division uses a cached
+/// reciprocal instead of long division.
+#define BC_NUM_RECIP_LEN (BC_NUM_BIGDIG_C(4))
+
+/// The maximum ratio of the number of limbs in a quotient to the number of
+/// limbs in the divisor for division to use a cached reciprocal.
+#define BC_NUM_RECIP_QUOT (4)
+
 // A crude, but always big enough, calculation of
 // the size required for ibase and obase BcNum's.
 #define BC_NUM_BIGDIG_LOG10 (BC_NUM_DEF_SIZE)
 
+#if BC_LONG_BIT >= 64
+
+/// The number of exponent bits that modular exponentiation peels off at once.
+/// The chunk times BC_BASE_POW must fit in a BcBigDig.
+#define BC_NUM_EXP_BITS (32)
+
+#else // BC_LONG_BIT >= 64
+
+/// The number of exponent bits that modular exponentiation peels off at once.
+/// The chunk times BC_BASE_POW must fit in a BcBigDig.
+#define BC_NUM_EXP_BITS (16)
+
+#endif // BC_LONG_BIT >= 64
+
+/// The divisor that peels BC_NUM_EXP_BITS bits off of an exponent.
+#define BC_NUM_EXP_CHUNK (((BcBigDig) 1) << BC_NUM_EXP_BITS)
+
+/// The number of small primes used for trial division.
+#define BC_NUM_NPRIMES (54)
+
+/// The square of the first prime after the small primes. Numbers below this
+/// with no small prime factors are prime.
+#define BC_NUM_PRIMES_LIMIT (BC_NUM_BIGDIG_C(66049))
+
+/// The number of small primes used as bases for deterministic Miller-Rabin.
+#define BC_NUM_MR_BASES (13)
+
+/// The value of D in the Lucas parameter search where a perfect square check
+/// is done because perfect squares would make the search go forever.
+#define BC_NUM_LUCAS_SQR_CHECK (BC_NUM_BIGDIG_C(65))
+
+/// The number of numbers that Lehmer's extended GCD algorithm works with.
+#define BC_NUM_LEHMER_NUMS (8)
+
 /**
  * Returns non-zero if the BcNum @a n is non-zero.
  * @param n  The number to test.
@@ -197,6 +276,23 @@ struct BcRNG;
  */
 #define BC_NUM_ONE(n) ((n)->len == 1 && (n)->rdx == 0 && (n)->num[0] == 1)
 
+/**
+ * Returns true if the BcNum @a n is a small integer, one with no scale that
+ * fits in one limb. Arithmetic on small integers is done with machine
+ * arithmetic instead of arbitrary-precision arithmetic.
+ * @param n  The number to test.
+ * @return   True if @a n is a small integer, false otherwise.
+ */
+#define BC_NUM_SMALL(n) (!(n)->scale && (n)->len <= 1)
+
+/**
+ * Returns the absolute value of the small integer @a n.
+ * @param n  The number to get the absolute value of. It must be a small
+ *           integer.
+ * @return   The absolute value of @a n.
+ */
+#define BC_NUM_SMALL_VAL(n) ((n)->len ? (BcBigDig) (n)->num[0] : 0)
+
 /**
  * Converts the letter @a c into a number.
  * @param c  The letter to convert.
@@ -668,6 +764,43 @@ bc_num_sqrt(BcNum* restrict a, BcNum* restrict b, size_t scale);
 void
 bc_num_divmod(BcNum* a, BcNum* b, BcNum* c, BcNum* d, size_t scale);
 
+/**
+ * Adds the product of two numbers to a third in place (c += a * b). The result
+ * is the same as a multiply and then an add, but the add is done in the limbs
+ * of @a c. This is a BcNumBinaryOp function.
+ * @param a      The first factor.
+ * @param b      The second factor.
+ * @param c      The number to add to and the return value.
+ * @param scale  The current scale.
+ */
+void
+bc_num_addmul(BcNum* a, BcNum* b, BcNum* c, size_t scale);
+
+/**
+ * Subtracts the product of two numbers from a third in place (c -= a * b). The
+ * result is the same as a multiply and then a subtract, but the subtract is
+ * done in the limbs of @a c. This is a BcNumBinaryOp function.
+ * @param a      The first factor.
+ * @param b      The second factor.
+ * @param c      The number to subtract from and the return value.
+ * @param scale  The current scale.
+ */
+void
+bc_num_submul(BcNum* a, BcNum* b, BcNum* c, size_t scale);
+
+/**
+ * Fused multiply-add (d = a * b + c). The result is the same as a multiply and
+ * then an add, but the product is made directly in @a d, and @a c is added to
+ * it in place. @a d can be @a c.
+ * @param a      The first factor.
+ * @param b      The second factor.
+ * @param c      The number to add.
+ * @param d      The return value.
+ * @param scale  The current scale.
+ */
+void
+bc_num_fma(BcNum* a, BcNum* b, BcNum* c, BcNum* d, size_t scale);
+
 /**
  * A function returning the required allocation size for an addition or a
  * subtraction. This is a BcNumBinaryOpReq function.
@@ -781,6 +914,50 @@ bc_num_cmp(const BcNum* a, const BcNum* b);
 void
 bc_num_modexp(BcNum* a, BcNum* b, BcNum* c, BcNum* restrict d);
 
+/**
+ * Tests whether an integer is prime. Numbers less than 2 are not prime. If
+ * @a bpsw is false, the answer is exact for numbers below 3.3 * 10^24, and
+ * the Baillie-PSW test is used for larger numbers. If @a bpsw is true,
+ * Baillie-PSW is used for everything that trial division does not decide.
+ * @param a     The number to test. It must be an integer.
+ * @param bpsw  True if Baillie-PSW should be used even for small numbers.
+ * @return      True if @a a is prime, false otherwise.
+ */
+bool
+bc_num_isPrime(BcNum* a, bool bpsw);
+
+/**
+ * Finds the smallest prime greater than @a a.
+ * @param a  The number to start from. It must be an integer.
+ * @param b  The return value. It must be initialized.
+ */
+void
+bc_num_nextPrime(BcNum* a, BcNum* restrict b);
+
+/**
+ * The extended Euclidean algorithm. Calculates the GCD of @a a and @a b, which
+ * is never negative, and cofactors such that a * x + b * y equals the GCD.
+ * @param a  The first parameter. It must be an integer.
+ * @param b  The second parameter. It must be an integer.
+ * @param g  The return value for the GCD.
+ * @param x  The return value for the cofactor of @a a.
+ * @param y  The return value for the cofactor of @a b.
+ */
+void
+bc_num_egcd(BcNum* a, BcNum* b, BcNum* restrict g, BcNum* restrict x,
+            BcNum* restrict y);
+
+/**
+ * Modular inverse. Calculates the number in the range [0, |b|) that gives 1
+ * modulo @a b when multiplied by @a a. If there is no such number because
+ * @a a and @a b are not coprime, the result is 0.
+ * @param a  The number to invert. It must be an integer.
+ * @param b  The modulus. It must be a non-zero integer.
+ * @param c  The return value.
+ */
+void
+bc_num_modinv(BcNum* a, BcNum* b, BcNum* restrict c);
+
 /**
  * Sets @a n to zero with a scale of zero.
  * @param n  The number to zero.
@@ -841,6 +1018,82 @@ bc_num_print(BcNum* restrict n, BcBigDig base, bool newline);
  */
 #define bc_num_inv(a, b, scale) bc_num_div(&vm->one, (a), (b), (scale))
 
+#if BC_ENABLE_LIBRARY
+
+/**
+ * Returns the number of BclLimb's needed to hold the integer and fractional
+ * parts of @a n.
+ * @param n     The number.
+ * @param ilen  An out parameter for the number of limbs in the integer part.
+ * @param flen  An out parameter for the number of limbs in the fractional
+ *              part.
+ */
+void
+bc_num_limbsLen(const BcNum* restrict n, size_t* ilen, size_t* flen);
+
+/**
+ * Exports @a n as BclLimb's. The integer part is stored with the least
+ * significant limb first, as is the fractional part, whose most significant
+ * limb is the one right after the decimal point. The sign is ignored.
+ * @param n      The number to export.
+ * @param ipart  The array for the integer part. It must be big enough for the
+ *               number of limbs returned by bc_num_limbsLen().
+ * @param fpart  The array for the fractional part. It must be big enough for
+ *               the number of limbs returned by bc_num_limbsLen().
+ */
+void
+bc_num_toLimbs(const BcNum* restrict n, BclLimb* ipart, BclLimb* fpart);
+
+/**
+ * Sets @a n from BclLimb's laid out as bc_num_toLimbs() exports them. Throws
+ * an overflow error if any limb is not less than BCL_LIMB_POW. @a n is
+ * expected to be a valid and allocated BcNum.
+ * @param n      The number to set.
+ * @param ipart  The integer part.
+ * @param ilen   The number of limbs in @a ipart.
+ * @param fpart  The fractional part. It must have (scale + BCL_LIMB_DIGS - 1)
+ *               / BCL_LIMB_DIGS limbs. Digits past @a scale are truncated.
+ * @param scale  The scale of the number.
+ * @param neg    True if the number should be negative, false otherwise.
+ */
+void
+bc_num_fromLimbs(BcNum* restrict n, const BclLimb* ipart, size_t ilen,
+                 const BclLimb* fpart, size_t scale, bool neg);
+
+/**
+ * Pushes either the integer part of @a n, or its fractional part times
+ * 10^scale, onto @a v as a little-endian, unsigned binary integer. No bytes are
+ * pushed if the part is zero, and there are no extra zero bytes at the end.
+ * @param n     The number to export.
+ * @param frac  True if the fractional part should be exported, false for the
+ *              integer part.
+ * @param v     The vector of bytes to push onto.
+ */
+void
+bc_num_toBytes(const BcNum* restrict n, bool frac, BcVec* restrict v);
+
+/**
+ * Sets @a n from unsigned binary integers for its integer part and for its
+ * fractional part times 10^scale. Throws an overflow error if the fractional
+ * part is not less than 10^scale. @a n is expected to be a valid and allocated
+ * BcNum.
+ * @param n          The number to set.
+ * @param ipart      The integer part.
+ * @param ilen       The number of bytes in @a ipart.
+ * @param fpart      The fractional part times 10^scale.
+ * @param flen       The number of bytes in @a fpart.
+ * @param scale      The scale of the number.
+ * @param neg        True if the number should be negative, false otherwise.
+ * @param bigEndian  True if the parts are big-endian, false if they are
+ *                   little-endian.
+ */
+void
+bc_num_fromBytes(BcNum* restrict n, const uchar* ipart, size_t ilen,
+                 const uchar* fpart, size_t flen, size_t scale, bool neg,
+                 bool bigEndian);
+
+#endif // BC_ENABLE_LIBRARY
+
 #if !BC_ENABLE_LIBRARY
 
 /**
@@ -910,4 +1163,14 @@ extern const BcDig bc_num_bigdigMax2[];
 /// A reference to a constant size of the above array.
 extern const size_t bc_num_bigdigMax2_size;
 
+/// The small primes used for trial division and Miller-Rabin bases.
+extern const uchar bc_num_primes[BC_NUM_NPRIMES];
+
+/// A reference to a constant array that is the bound below which the first
+/// BC_NUM_MR_BASES primes make Miller-Rabin deterministic.
+extern const BcDig bc_num_mrBound[];
+
+/// A reference to a constant size of the above array.
+extern const size_t bc_num_mrBound_size;
+
 #endif // BC_NUM_H
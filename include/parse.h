@@ -185,6 +185,10 @@ typedef struct BcParse
 	/// overwrite the string stored in the lexer. This buffer is for copying
 	/// that string from the lexer to keep it safe.
 	BcVec buf;
+
+	/// A stack of the indices of a run of constants in the bytecode. This is
+	/// used by the constant folding in bc_parse_optimize().
+	BcVec folds;
 #endif // BC_ENABLED
 
 	/// A reference to the program to grab the current function when necessary.
@@ -247,6 +251,16 @@ bc_parse_addString(BcParse* p);
 void
 bc_parse_number(BcParse* p);
 
+/**
+ * Adds a constant if it does not exist yet. See @a BcProgram in
+ * include/program.h for more details.
+ * @param p       The parser.
+ * @param string  The string of the constant.
+ * @return        The index of the constant.
+ */
+size_t
+bc_parse_addConst(BcParse* p, const char* string);
+
 /**
  * Update the current function in the parser.
  * @param p     The parser.
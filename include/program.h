@@ -64,6 +64,72 @@
 /// The length of the globals array.
 #define BC_PROG_GLOBALS_LEN (3 + BC_ENABLE_EXTRA_MATH)
 
+#if BC_ENABLED
+
+/// The maximum depth of an expression that BC_INST_VAR_ASSIGN_REGS can
+/// evaluate. Each level of depth needs two registers.
+#define BC_PROG_REG_DEPTH (8)
+
+/// The number of results of memoized functions that can be cached. When a
+/// result goes into a slot that is being used, the old one is evicted.
+#ifndef BC_PROG_MEMO_SIZE
+#define BC_PROG_MEMO_SIZE (1024)
+#endif // BC_PROG_MEMO_SIZE
+
+/// A cached call to a memoized function, or the key of one that has not
+/// returned yet.
+typedef struct BcMemo
+{
+	/// The index of the function, or 0 if this is an empty slot. Because 0 is
+	/// the main function, which is never memoized, that is not ambiguous.
+	size_t func;
+
+	/// The hash of the whole key.
+	size_t hash;
+
+	/// The depth of the execution stack while the call is running. This is
+	/// only used for calls that have not returned yet.
+	size_t depth;
+
+	/// The values of the globals when the function was called. The result can
+	/// depend on them, so they are part of the key.
+	BcBigDig globals[BC_PROG_GLOBALS_LEN];
+
+	/// The arguments.
+	BcVec args;
+
+	/// The result. This is only valid in the cache.
+	BcNum res;
+
+} BcMemo;
+
+/// The last inlined body that was entered. Inlined bodies do not have frames on
+/// the execution stack, so this lets a stack trace show them anyway.
+typedef struct BcInlineFrame
+{
+	/// The index of the inlined function, or 0 if there is none. Because 0 is
+	/// the main function, which is never inlined, that is not ambiguous.
+	size_t func;
+
+	/// The index of the function that the body is in.
+	size_t caller;
+
+	/// The version of the function that the body is in.
+	size_t version;
+
+	/// The depth of the execution stack while the body runs.
+	size_t depth;
+
+	/// The index of the start of the body in the caller's bytecode.
+	size_t bgn;
+
+	/// The index of the end of the body in the caller's bytecode.
+	size_t end;
+
+} BcInlineFrame;
+
+#endif // BC_ENABLED
+
 typedef struct BcProgram
 {
 	/// The array of globals values.
@@ -93,7 +159,7 @@ typedef struct BcProgram
 	BcVec consts;
 
 	/// The map of constants to go with consts.
-	BcVec const_map;
+	BcMap const_map;
 
 	/// The strings encountered in the program. They are global to the program
 	/// to prevent bad accesses when functions that used non-auto variables are
@@ -101,25 +167,25 @@ typedef struct BcProgram
 	BcVec strs;
 
 	/// The map of strings to go with strs.
-	BcVec str_map;
+	BcMap str_map;
 
 	/// The array of functions.
 	BcVec fns;
 
 	/// The map of functions to go with fns.
-	BcVec fn_map;
+	BcMap fn_map;
 
 	/// The array of variables.
 	BcVec vars;
 
 	/// The map of variables to go with vars.
-	BcVec var_map;
+	BcMap var_map;
 
 	/// The array of arrays.
 	BcVec arrs;
 
 	/// The map of arrays to go with arrs.
-	BcVec arr_map;
+	BcMap arr_map;
 
 #if DC_ENABLED
 
@@ -143,6 +209,20 @@ typedef struct BcProgram
 	/// The last printed value for bc.
 	BcNum last;
 
+	/// The registers for BC_INST_VAR_ASSIGN_REGS. They are only allocated when
+	/// they are first used, and their numbers are traded with variables.
+	BcNum regs[BC_PROG_REG_DEPTH * 2];
+
+	/// The cache of results of memoized functions, which is a table of
+	/// BC_PROG_MEMO_SIZE BcMemo slots. It is only allocated when first used.
+	BcVec memos;
+
+	/// The keys of calls to memoized functions that have not returned yet.
+	BcVec memo_calls;
+
+	/// The last inlined body that was entered, for stack traces.
+	BcInlineFrame inl;
+
 #endif // BC_ENABLED
 
 	/// The number of results that have not been retired.
@@ -367,6 +447,21 @@ bc_program_printStackDebug(BcProgram* p);
 size_t
 bc_program_search(BcProgram* p, const char* name, bool var);
 
+#if BC_ENABLED
+
+/**
+ * Returns the index of the hidden variable that holds argument @a i of an
+ * inlined function (see BC_INST_INLINE). Only one inlined body runs at a time,
+ * so all inlined functions share these variables.
+ * @param p  The program.
+ * @param i  The index of the parameter.
+ * @return   The index of the variable in the variable array.
+ */
+size_t
+bc_program_inlineVar(BcProgram* p, size_t i);
+
+#endif // BC_ENABLED
+
 /**
  * Adds a string to the program and returns the string's index in the program.
  * @param p    The program.
@@ -589,6 +684,8 @@ extern const char bc_program_esc_seqs[];
 		&&lbl_BC_INST_ABS,                              \
 		&&lbl_BC_INST_IS_NUMBER,                        \
 		&&lbl_BC_INST_IS_STRING,                        \
+		&&lbl_BC_INST_IS_PRIME,                         \
+		&&lbl_BC_INST_NEXT_PRIME,                       \
 		&&lbl_BC_INST_IRAND,                            \
 		&&lbl_BC_INST_ASCIIFY,                          \
 		&&lbl_BC_INST_READ,                             \
@@ -611,10 +708,19 @@ extern const char bc_program_esc_seqs[];
 		&&lbl_BC_INST_RET0,                             \
 		&&lbl_BC_INST_RET_VOID,                         \
 		&&lbl_BC_INST_HALT,                             \
+		&&lbl_BC_INST_VAR_OP_CONST,                     \
+		&&lbl_BC_INST_ARRAY_OP_CONST,                   \
+		&&lbl_BC_INST_REL_JUMP_ZERO,                    \
+		&&lbl_BC_INST_VAR_ASSIGN_REGS,                  \
+		&&lbl_BC_INST_VAR_ADDMUL,                       \
+		&&lbl_BC_INST_TAIL_CALL,                        \
+		&&lbl_BC_INST_INLINE,                           \
 		&&lbl_BC_INST_POP,                              \
 		&&lbl_BC_INST_SWAP,                             \
 		&&lbl_BC_INST_MODEXP,                           \
 		&&lbl_BC_INST_DIVMOD,                           \
+		&&lbl_BC_INST_MODINV,                           \
+		&&lbl_BC_INST_EGCD,                             \
 		&&lbl_BC_INST_PRINT_STREAM,                     \
 		&&lbl_BC_INST_EXTENDED_REGISTERS,               \
 		&&lbl_BC_INST_POP_EXEC,                         \
@@ -686,6 +792,8 @@ extern const char bc_program_esc_seqs[];
 		&&lbl_BC_INST_ABS,                              \
 		&&lbl_BC_INST_IS_NUMBER,                        \
 		&&lbl_BC_INST_IS_STRING,                        \
+		&&lbl_BC_INST_IS_PRIME,                         \
+		&&lbl_BC_INST_NEXT_PRIME,                       \
 		&&lbl_BC_INST_ASCIIFY,                          \
 		&&lbl_BC_INST_READ,                             \
 		&&lbl_BC_INST_MAXIBASE,                         \
@@ -705,10 +813,19 @@ extern const char bc_program_esc_seqs[];
 		&&lbl_BC_INST_RET0,                             \
 		&&lbl_BC_INST_RET_VOID,                         \
 		&&lbl_BC_INST_HALT,                             \
+		&&lbl_BC_INST_VAR_OP_CONST,                     \
+		&&lbl_BC_INST_ARRAY_OP_CONST,                   \
+		&&lbl_BC_INST_REL_JUMP_ZERO,                    \
+		&&lbl_BC_INST_VAR_ASSIGN_REGS,                  \
+		&&lbl_BC_INST_VAR_ADDMUL,                       \
+		&&lbl_BC_INST_TAIL_CALL,                        \
+		&&lbl_BC_INST_INLINE,                           \
 		&&lbl_BC_INST_POP,                              \
 		&&lbl_BC_INST_SWAP,                             \
 		&&lbl_BC_INST_MODEXP,                           \
 		&&lbl_BC_INST_DIVMOD,                           \
+		&&lbl_BC_INST_MODINV,                           \
+		&&lbl_BC_INST_EGCD,                             \
 		&&lbl_BC_INST_PRINT_STREAM,                     \
 		&&lbl_BC_INST_EXTENDED_REGISTERS,               \
 		&&lbl_BC_INST_POP_EXEC,                         \
@@ -795,6 +912,8 @@ extern const char bc_program_esc_seqs[];
 		&&lbl_BC_INST_ABS,                              \
 		&&lbl_BC_INST_IS_NUMBER,                        \
 		&&lbl_BC_INST_IS_STRING,                        \
+		&&lbl_BC_INST_IS_PRIME,                         \
+		&&lbl_BC_INST_NEXT_PRIME,                       \
 		&&lbl_BC_INST_IRAND,                            \
 		&&lbl_BC_INST_ASCIIFY,                          \
 		&&lbl_BC_INST_READ,                             \
@@ -817,10 +936,19 @@ extern const char bc_program_esc_seqs[];
 		&&lbl_BC_INST_RET0,                             \
 		&&lbl_BC_INST_RET_VOID,                         \
 		&&lbl_BC_INST_HALT,                             \
+		&&lbl_BC_INST_VAR_OP_CONST,                     \
+		&&lbl_BC_INST_ARRAY_OP_CONST,                   \
+		&&lbl_BC_INST_REL_JUMP_ZERO,                    \
+		&&lbl_BC_INST_VAR_ASSIGN_REGS,                  \
+		&&lbl_BC_INST_VAR_ADDMUL,                       \
+		&&lbl_BC_INST_TAIL_CALL,                        \
+		&&lbl_BC_INST_INLINE,                           \
 		&&lbl_BC_INST_POP,                              \
 		&&lbl_BC_INST_SWAP,                             \
 		&&lbl_BC_INST_MODEXP,                           \
 		&&lbl_BC_INST_DIVMOD,                           \
+		&&lbl_BC_INST_MODINV,                           \
+		&&lbl_BC_INST_EGCD,                             \
 		&&lbl_BC_INST_PRINT_STREAM,                     \
 		&&lbl_BC_INST_INVALID,                          \
 	}
@@ -877,6 +1005,8 @@ extern const char bc_program_esc_seqs[];
 		&&lbl_BC_INST_ABS,                              \
 		&&lbl_BC_INST_IS_NUMBER,                        \
 		&&lbl_BC_INST_IS_STRING,                        \
+		&&lbl_BC_INST_IS_PRIME,                         \
+		&&lbl_BC_INST_NEXT_PRIME,                       \
 		&&lbl_BC_INST_ASCIIFY,                          \
 		&&lbl_BC_INST_READ,                             \
 		&&lbl_BC_INST_MAXIBASE,                         \
@@ -896,10 +1026,19 @@ extern const char bc_program_esc_seqs[];
 		&&lbl_BC_INST_RET0,                             \
 		&&lbl_BC_INST_RET_VOID,                         \
 		&&lbl_BC_INST_HALT,                             \
+		&&lbl_BC_INST_VAR_OP_CONST,                     \
+		&&lbl_BC_INST_ARRAY_OP_CONST,                   \
+		&&lbl_BC_INST_REL_JUMP_ZERO,                    \
+		&&lbl_BC_INST_VAR_ASSIGN_REGS,                  \
+		&&lbl_BC_INST_VAR_ADDMUL,                       \
+		&&lbl_BC_INST_TAIL_CALL,                        \
+		&&lbl_BC_INST_INLINE,                           \
 		&&lbl_BC_INST_POP,                              \
 		&&lbl_BC_INST_SWAP,                             \
 		&&lbl_BC_INST_MODEXP,                           \
 		&&lbl_BC_INST_DIVMOD,                           \
+		&&lbl_BC_INST_MODINV,                           \
+		&&lbl_BC_INST_EGCD,                             \
 		&&lbl_BC_INST_PRINT_STREAM,                     \
 		&&lbl_BC_INST_INVALID,                          \
 	}
@@ -932,7 +1071,8 @@ extern const char bc_program_esc_seqs[];
 		&&lbl_BC_INST_SEED,          &&lbl_BC_INST_LENGTH,             \
 		&&lbl_BC_INST_SCALE_FUNC,    &&lbl_BC_INST_SQRT,               \
 		&&lbl_BC_INST_ABS,           &&lbl_BC_INST_IS_NUMBER,          \
-		&&lbl_BC_INST_IS_STRING,     &&lbl_BC_INST_IRAND,              \
+		&&lbl_BC_INST_IS_STRING,     &&lbl_BC_INST_IS_PRIME,           \
+		&&lbl_BC_INST_NEXT_PRIME,    &&lbl_BC_INST_IRAND,              \
 		&&lbl_BC_INST_ASCIIFY,       &&lbl_BC_INST_READ,               \
 		&&lbl_BC_INST_RAND,          &&lbl_BC_INST_MAXIBASE,           \
 		&&lbl_BC_INST_MAXOBASE,      &&lbl_BC_INST_MAXSCALE,           \
@@ -941,6 +1081,7 @@ extern const char bc_program_esc_seqs[];
 		&&lbl_BC_INST_PRINT_POP,     &&lbl_BC_INST_STR,                \
 		&&lbl_BC_INST_POP,           &&lbl_BC_INST_SWAP,               \
 		&&lbl_BC_INST_MODEXP,        &&lbl_BC_INST_DIVMOD,             \
+		&&lbl_BC_INST_MODINV,        &&lbl_BC_INST_EGCD,               \
 		&&lbl_BC_INST_PRINT_STREAM,  &&lbl_BC_INST_EXTENDED_REGISTERS, \
 		&&lbl_BC_INST_POP_EXEC,      &&lbl_BC_INST_EXECUTE,            \
 		&&lbl_BC_INST_EXEC_COND,     &&lbl_BC_INST_PRINT_STACK,        \
@@ -972,6 +1113,7 @@ extern const char bc_program_esc_seqs[];
 		&&lbl_BC_INST_LENGTH,        &&lbl_BC_INST_SCALE_FUNC,         \
 		&&lbl_BC_INST_SQRT,          &&lbl_BC_INST_ABS,                \
 		&&lbl_BC_INST_IS_NUMBER,     &&lbl_BC_INST_IS_STRING,          \
+		&&lbl_BC_INST_IS_PRIME,      &&lbl_BC_INST_NEXT_PRIME,         \
 		&&lbl_BC_INST_ASCIIFY,       &&lbl_BC_INST_READ,               \
 		&&lbl_BC_INST_MAXIBASE,      &&lbl_BC_INST_MAXOBASE,           \
 		&&lbl_BC_INST_MAXSCALE,      &&lbl_BC_INST_LINE_LENGTH,        \
@@ -979,6 +1121,7 @@ extern const char bc_program_esc_seqs[];
 		&&lbl_BC_INST_PRINT_POP,     &&lbl_BC_INST_STR,                \
 		&&lbl_BC_INST_POP,           &&lbl_BC_INST_SWAP,               \
 		&&lbl_BC_INST_MODEXP,        &&lbl_BC_INST_DIVMOD,             \
+		&&lbl_BC_INST_MODINV,        &&lbl_BC_INST_EGCD,               \
 		&&lbl_BC_INST_PRINT_STREAM,  &&lbl_BC_INST_EXTENDED_REGISTERS, \
 		&&lbl_BC_INST_POP_EXEC,      &&lbl_BC_INST_EXECUTE,            \
 		&&lbl_BC_INST_EXEC_COND,     &&lbl_BC_INST_PRINT_STACK,        \
@@ -70,6 +70,7 @@
 #define STDOUT_FILENO _fileno(stdout)
 #define STDERR_FILENO _fileno(stderr)
 #define S_ISDIR(m) ((m) & (_S_IFDIR))
+#define S_ISREG(m) ((m) & (_S_IFREG))
 #define O_RDONLY _O_RDONLY
 #define stat _stat
 #define fstat _fstat
@@ -185,6 +186,12 @@
 #define BC_DEBUG_CODE (0)
 #endif // BC_DEBUG_CODE
 
+// Optimize bytecode by default. Setting this to non-zero makes bc execute the
+// bytecode exactly as the parser generated it, on the results stack.
+#ifndef BC_STACK_ONLY
+#define BC_STACK_ONLY (0)
+#endif // BC_STACK_ONLY
+
 #if defined(__clang__)
 #define BC_CLANG (1)
 #else // defined(__clang__)
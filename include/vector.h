@@ -138,6 +138,20 @@ typedef struct BcVec
 
 } BcVec;
 
+/// A map from names to indices. The IDs are kept in the order they were
+/// inserted, so an ID never moves, and a hash table of indices into them makes
+/// finding a name take constant time on average.
+typedef struct BcMap
+{
+	/// The IDs, in the order they were inserted.
+	BcVec ids;
+
+	/// The hash table. Each slot is an index into ids plus one, or 0 if the slot
+	/// is empty. The number of slots is always a power of 2.
+	BcVec table;
+
+} BcMap;
+
 /**
  * Initializes a vector.
  * @param v      The vector to initialize.
@@ -318,10 +332,24 @@ bc_vec_clear(BcVec* restrict v);
 void
 bc_vec_free(void* vec);
 
+/**
+ * Initializes a map.
+ * @param m  The map to initialize.
+ */
+void
+bc_map_init(BcMap* restrict m);
+
+/**
+ * Frees a map.
+ * @param m  The map to free.
+ */
+void
+bc_map_free(BcMap* restrict m);
+
 /**
  * Attempts to insert an ID into a map and returns true if it succeeded, false
  * if the item already exists.
- * @param v     The map vector to insert into.
+ * @param m     The map to insert into.
  * @param name  The name of the item to insert. This name is assumed to be owned
  *              by another entity.
  * @param idx   The index of the partner array where the actual item is.
@@ -330,30 +358,44 @@ bc_vec_free(void* vec);
  * @return      True if the item was inserted, false if the item already exists.
  */
 bool
-bc_map_insert(BcVec* restrict v, const char* name, size_t idx,
+bc_map_insert(BcMap* restrict m, const char* name, size_t idx,
               size_t* restrict i);
 
 /**
  * Returns the index of the item with @a name in the map, or BC_VEC_INVALID_IDX
  * if it doesn't exist.
- * @param v     The map vector.
+ * @param m     The map.
  * @param name  The name of the item to find.
  * @return      The index in the map of the item with @a name, or
  *              BC_VEC_INVALID_IDX if the item does not exist.
  */
 size_t
-bc_map_index(const BcVec* restrict v, const char* name);
+bc_map_index(const BcMap* restrict m, const char* name);
+
+/// The starting value for bc_map_hashBytes().
+#define BC_MAP_HASH ((size_t) UINT32_C(2166136261))
+
+/**
+ * Hashes bytes, continuing from a previous hash. This is FNV-1a. The first
+ * hash should start from BC_MAP_HASH.
+ * @param h    The hash to continue from.
+ * @param str  The bytes to hash.
+ * @param len  The number of bytes.
+ * @return     The hash.
+ */
+size_t
+bc_map_hashBytes(size_t h, const char* str, size_t len);
 
 #if DC_ENABLED
 
 /**
  * Returns the name of the item at index @a idx in the map.
- * @param v    The map vector.
+ * @param m    The map.
  * @param idx  The index.
  * @return     The name of the item at @a idx.
  */
 const char*
-bc_map_name(const BcVec* restrict v, size_t idx);
+bc_map_name(const BcMap* restrict m, size_t idx);
 
 #endif // DC_ENABLED
 
@@ -376,12 +418,6 @@ bc_map_name(const BcVec* restrict v, size_t idx);
  */
 #define bc_vec_top(v) (bc_vec_item_rev((v), 0))
 
-/**
- * Initializes a vector to serve as a map.
- * @param v  The vector to initialize.
- */
-#define bc_map_init(v) (bc_vec_init((v), sizeof(BcId), BC_DTOR_NONE))
-
 /// A reference to the array of destructors.
 extern const BcVecFree bc_vec_dtors[];
 
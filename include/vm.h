@@ -145,6 +145,9 @@
 /// The flag for the global stacks option.
 #define BC_FLAG_G (UINTMAX_C(1) << 4)
 
+/// The flag for the no-optimize option.
+#define BC_FLAG_NO_OPT (UINTMAX_C(1) << 15)
+
 #endif // BC_ENABLED
 
 /// The flag for quiet, though this one is reversed; the option clears the flag.
@@ -200,6 +203,9 @@
 /// A convenience macro for getting the global stacks flag.
 #define BC_G (vm->flags & BC_FLAG_G)
 
+/// A convenience macro for getting the no-optimize flag.
+#define BC_NO_OPT (vm->flags & BC_FLAG_NO_OPT)
+
 #endif // BC_ENABLED
 
 #if DC_ENABLED
@@ -478,8 +484,15 @@
 
 #endif // BC_ENABLE_LINE_LIB
 
-/// The max number of temporary BcNums that can be kept.
-#define BC_VM_MAX_TEMPS (1 << 9)
+/// The number of size classes for temps. Class i keeps limb arrays with a
+/// capacity of BC_NUM_DEF_SIZE << i.
+#define BC_VM_TEMP_CLASSES (10)
+
+/// The max number of bytes that temps can keep. Limb arrays that are freed
+/// past this are given back to the system. This can be set when building.
+#ifndef BC_VM_MAX_TEMPS_SIZE
+#define BC_VM_MAX_TEMPS_SIZE ((size_t) 1 << 20)
+#endif // BC_VM_MAX_TEMPS_SIZE
 
 /// The capacity of the one BcNum, which is a constant.
 #define BC_VM_ONE_CAP (1)
@@ -548,8 +561,8 @@ typedef struct BcVm
 	/// error handling, while allowing me to do cleanup on the way.
 	BcVec jmp_bufs;
 
-	/// The number of temps in the temps array.
-	size_t temps_len;
+	/// The number of bytes in all of the temps lists.
+	size_t temps_size;
 
 #if BC_ENABLE_LIBRARY
 
@@ -765,16 +778,42 @@ typedef struct BcVm
 	/// BC_REDEFINE_KEYWORDS is non-zero.
 	bool redefined_kws[BC_LEX_NKWS];
 
+	/// The path of the bytecode cache to compile into, or NULL if bc is not
+	/// compiling.
+	const char* compile;
+
+	/// The bytecode cache being compiled.
+	BcCache cache;
+
 #endif // BC_ENABLED
 #endif // !BC_ENABLE_LIBRARY
 
-	BcDig* temps_buf[BC_VM_MAX_TEMPS];
+	/// The lists of temps, one for each size class. Each temp has the pointer
+	/// to the next one in the same list stored at its start.
+	BcDig* temps[BC_VM_TEMP_CLASSES];
+
+	/// The reciprocal cache for division. See bc_num_d().
+	BcNumRecip recips[BC_NUM_RECIP_SLOTS];
+
+	/// The entry in the reciprocal cache to replace next.
+	size_t recips_next;
 
 #if BC_DEBUG_CODE
 
 	/// The depth for BC_FUNC_ENTER and BC_FUNC_EXIT.
 	size_t func_depth;
 
+	/// The number of limb arrays that were taken from temps.
+	size_t temps_hits;
+
+	/// The number of limb arrays that could have been taken from temps but had
+	/// to be allocated.
+	size_t temps_misses;
+
+	/// The number of limb arrays that could have been kept in temps but were
+	/// freed because temps were full.
+	size_t temps_drops;
+
 #endif // BC_DEBUG_CODE
 
 } BcVm;
@@ -809,26 +848,33 @@ void
 bc_vm_shutdown(void);
 
 /**
- * Add a temp to the temp array.
- * @param num  The BcDig array to add to the temp array.
+ * Returns the capacity that a limb array should have to hold at least @a req
+ * limbs. If @a req fits in a size class of temps, this is the capacity of that
+ * class, so that the limb array can be kept in temps when it is freed.
+ * Otherwise, it is @a req.
+ * @param req  The number of limbs needed.
+ * @return     The capacity to allocate.
  */
-void
-bc_vm_addTemp(BcDig* num);
+size_t
+bc_vm_tempCap(size_t req);
 
 /**
- * Return the temp on the top of the temp stack, or NULL if there are none.
- * @return  A temp, or NULL if none exist.
+ * Adds a limb array to the temps of its size class, or frees it if it does not
+ * fit in one or if temps are full.
+ * @param num  The limb array to add to temps.
+ * @param cap  The capacity of @a num, in limbs.
  */
-BcDig*
-bc_vm_takeTemp(void);
+void
+bc_vm_addTemp(BcDig* num, size_t cap);
 
 /**
- * Gets the top temp of the temp stack. This is separate from bc_vm_takeTemp()
- * to quiet a GCC warning about longjmp() clobbering in bc_num_init().
- * @return  A temp, or NULL if none exist.
+ * Takes a limb array with the capacity @a cap from temps, or returns NULL if
+ * there are none.
+ * @param cap  The capacity, which must be from bc_vm_tempCap().
+ * @return     A temp, or NULL if none exist.
  */
 BcDig*
-bc_vm_getTemp(void);
+bc_vm_takeTemp(size_t cap);
 
 /**
  * Frees all temporaries.
@@ -836,6 +882,12 @@ bc_vm_getTemp(void);
 void
 bc_vm_freeTemps(void);
 
+/**
+ * Frees the reciprocal cache.
+ */
+void
+bc_vm_freeRecips(void);
+
 #if !BC_ENABLE_HISTORY || BC_ENABLE_LINE_LIB || BC_ENABLE_LIBRARY
 
 /**
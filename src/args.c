@@ -301,6 +301,20 @@ bc_args(int argc, const char* argv[], bool exit_exprs, BcBigDig* scale,
 				break;
 			}
 
+			case 'N':
+			{
+				assert(BC_IS_BC);
+				vm->flags |= BC_FLAG_NO_OPT;
+				break;
+			}
+
+			case 'o':
+			{
+				assert(BC_IS_BC);
+				vm->compile = opts.optarg;
+				break;
+			}
+
 			case 'q':
 			{
 				assert(BC_IS_BC);
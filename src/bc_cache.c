@@ -0,0 +1,955 @@
+/*
+ * *****************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Copyright (c) 2018-2026 Gavin D. Howard and contributors.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * *****************************************************************************
+ *
+ * Bytecode caches for bc.
+ *
+ */
+
+#if BC_ENABLED
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif // _WIN32
+
+#include <bc.h>
+#include <program.h>
+#include <vm.h>
+
+/// The index of the first function that the user can define.
+#define BC_CACHE_FUNC (BC_PROG_READ + 1)
+
+/**
+ * Hashes the state of bc that the bytecode in a cache depends on: the names of
+ * all functions, variables, arrays, constants, and strings, since the bytecode
+ * refers to them by index, which functions have been redefined, the lengths of
+ * the code and labels of main, and the options that change parsing.
+ * @return  The hash.
+ */
+static size_t
+bc_cache_state(void)
+{
+	BcProgram* p = &vm->prog;
+	BcFunc* f;
+	size_t i, h = BC_MAP_HASH;
+	size_t lens[9];
+
+	for (i = 0; i < p->fns.len; ++i)
+	{
+		f = bc_vec_item(&p->fns, i);
+		h = bc_map_hashBytes(h, f->name, strlen(f->name) + 1);
+		h = bc_map_hashBytes(h, (const char*) &f->version, sizeof(size_t));
+	}
+
+	for (i = 0; i < p->var_map.ids.len; ++i)
+	{
+		BcId* id = bc_vec_item(&p->var_map.ids, i);
+		h = bc_map_hashBytes(h, id->name, strlen(id->name) + 1);
+	}
+
+	for (i = 0; i < p->arr_map.ids.len; ++i)
+	{
+		BcId* id = bc_vec_item(&p->arr_map.ids, i);
+		h = bc_map_hashBytes(h, id->name, strlen(id->name) + 1);
+	}
+
+	for (i = 0; i < p->consts.len; ++i)
+	{
+		BcConst* c = bc_vec_item(&p->consts, i);
+		h = bc_map_hashBytes(h, c->val, strlen(c->val) + 1);
+	}
+
+	for (i = 0; i < p->strs.len; ++i)
+	{
+		char* str = *((char**) bc_vec_item(&p->strs, i));
+		h = bc_map_hashBytes(h, str, strlen(str) + 1);
+	}
+
+	f = bc_vec_item(&p->fns, BC_PROG_MAIN);
+
+	lens[0] = p->fns.len;
+	lens[1] = p->vars.len;
+	lens[2] = p->arrs.len;
+	lens[3] = p->consts.len;
+	lens[4] = p->strs.len;
+	lens[5] = f->code.len;
+	lens[6] = f->labels.len;
+	lens[7] = BC_S;
+	lens[8] = BC_NO_OPT;
+
+	h = bc_map_hashBytes(h, (const char*) lens, sizeof(lens));
+
+	return bc_map_hashBytes(h, (const char*) vm->redefined_kws,
+	                        sizeof(vm->redefined_kws));
+}
+
+/**
+ * Appends a number to a buffer.
+ * @param v  The buffer.
+ * @param n  The number.
+ */
+static void
+bc_cache_num(BcVec* v, size_t n)
+{
+	bc_vec_npush(v, sizeof(size_t), &n);
+}
+
+/**
+ * Appends a string, with its nul byte, to a buffer.
+ * @param v    The buffer.
+ * @param str  The string.
+ */
+static void
+bc_cache_str(BcVec* v, const char* str)
+{
+	bc_vec_npush(v, strlen(str) + 1, str);
+}
+
+/**
+ * Appends what identifies this build of bc to a buffer. A cache can only be
+ * run by a bc that appends the same thing.
+ * @param v  The buffer.
+ */
+static void
+bc_cache_build(BcVec* v)
+{
+	bc_cache_str(v, BC_VERSION);
+	bc_vec_pushByte(v, (uchar) sizeof(size_t));
+	bc_cache_num(v, BC_CACHE_FORMAT);
+	bc_cache_num(v, BC_INST_INVALID);
+	bc_cache_num(v, BC_LONG_BIT);
+	bc_cache_num(v, BC_ENABLE_EXTRA_MATH);
+}
+
+/**
+ * Maps a file into memory or, where that is not possible, reads it.
+ * @param path  The path of the file.
+ * @param len   An out parameter for the length of the file.
+ * @return      The contents of the file, or NULL if it could not be opened, is
+ *              not a regular file, or is empty.
+ */
+static char*
+bc_cache_map(const char* path, size_t* len)
+{
+	struct stat pstat;
+	char* data;
+	int fd;
+
+	BC_SIG_ASSERT_LOCKED;
+
+	// Every file is probed for a cache, and opening a FIFO blocks until there
+	// is a writer, so anything that is not a regular file is skipped first.
+	if (stat(path, &pstat) == -1 || !S_ISREG(pstat.st_mode)) return NULL;
+
+#ifndef _WIN32
+	fd = open(path, O_RDONLY);
+#else // _WIN32
+	fd = -1;
+	open(&fd, path, O_RDONLY);
+#endif // _WIN32
+
+	if (fd < 0) return NULL;
+
+	// The file could have been replaced after the stat(), so check it again.
+	if (fstat(fd, &pstat) == -1 || !S_ISREG(pstat.st_mode) || !pstat.st_size)
+	{
+		close(fd);
+		return NULL;
+	}
+
+	*len = (size_t) pstat.st_size;
+
+#ifndef _WIN32
+
+	data = mmap(NULL, *len, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (data == MAP_FAILED) data = NULL;
+
+#else // _WIN32
+
+	{
+		size_t done = 0;
+
+		data = bc_vm_malloc(*len);
+
+		while (done < *len)
+		{
+			ssize_t r = read(fd, data + done, *len - done);
+
+			if (r <= 0)
+			{
+				free(data);
+				data = NULL;
+				break;
+			}
+
+			done += (size_t) r;
+		}
+	}
+
+#endif // _WIN32
+
+	close(fd);
+
+	return data;
+}
+
+/**
+ * Unmaps a file mapped by bc_cache_map().
+ * @param data  The contents of the file.
+ * @param len   The length of the file.
+ */
+static void
+bc_cache_unmap(char* data, size_t len)
+{
+	BC_SIG_ASSERT_LOCKED;
+
+#ifndef _WIN32
+	munmap(data, len);
+#else // _WIN32
+	BC_UNUSED(len);
+	free(data);
+#endif // _WIN32
+}
+
+void
+bc_cache_init(BcCache* c, const char* path, const char* text)
+{
+	BcProgram* p = &vm->prog;
+	BcFunc* f;
+	size_t i, len = strlen(text);
+
+	BC_SIG_ASSERT_LOCKED;
+
+	bc_vec_init(&c->head, sizeof(uchar), BC_DTOR_NONE);
+	bc_vec_init(&c->events, sizeof(uchar), BC_DTOR_NONE);
+	bc_vec_init(&c->defs, sizeof(size_t), BC_DTOR_NONE);
+
+	bc_vec_npush(&c->head, BC_CACHE_MAGIC_LEN, BC_CACHE_MAGIC);
+	bc_cache_str(&c->head, path);
+	bc_cache_build(&c->head);
+	bc_cache_num(&c->head, len);
+	bc_cache_num(&c->head, bc_map_hashBytes(BC_MAP_HASH, text, len));
+	bc_cache_num(&c->head, bc_cache_state());
+
+	// The hash of the body is filled in by bc_cache_write().
+	bc_cache_num(&c->head, 0);
+
+	c->fns = p->fns.len;
+	c->vars = p->vars.len;
+	c->arrs = p->arrs.len;
+	c->consts = p->consts.len;
+	c->strs = p->strs.len;
+
+	f = bc_vec_item(&p->fns, BC_PROG_MAIN);
+
+	c->code = f->code.len;
+	c->labels = f->labels.len;
+
+	// Existing functions are only recorded if they are redefined.
+	for (i = 0; i < p->fns.len; ++i)
+	{
+		f = bc_vec_item(&p->fns, i);
+		bc_vec_push(&c->defs, &f->version);
+		bc_vec_push(&c->defs, &f->code.len);
+	}
+}
+
+/**
+ * Records the definition of a function.
+ * @param v    The buffer to record into.
+ * @param f    The function.
+ * @param idx  The index of the function.
+ */
+static void
+bc_cache_pushDef(BcVec* v, const BcFunc* f, size_t idx)
+{
+	size_t i;
+
+	bc_cache_num(v, BC_CACHE_DEF);
+	bc_cache_num(v, idx);
+	bc_cache_num(v, f->version);
+	bc_cache_num(v, f->nparams);
+	bc_cache_num(v, f->voidfn);
+	bc_cache_num(v, f->memo);
+
+	bc_cache_num(v, f->code.len);
+	bc_vec_npush(v, f->code.len, f->code.v);
+
+	bc_cache_num(v, f->labels.len);
+
+	for (i = 0; i < f->labels.len; ++i)
+	{
+		bc_cache_num(v, *((size_t*) bc_vec_item(&f->labels, i)));
+	}
+
+	bc_cache_num(v, f->autos.len);
+
+	for (i = 0; i < f->autos.len; ++i)
+	{
+		BcAuto* a = bc_vec_item(&f->autos, i);
+
+		bc_cache_num(v, a->idx);
+		bc_cache_num(v, (size_t) a->type);
+	}
+}
+
+void
+bc_cache_step(BcCache* c)
+{
+	BcProgram* p = &vm->prog;
+	BcInstPtr* ip = bc_vec_item(&p->stack, 0);
+	BcFunc* f;
+	size_t i;
+
+	BC_SIG_ASSERT_LOCKED;
+
+	// Record the functions that were defined since the last step, which have a
+	// new version or new code. Functions that are only called so far have
+	// neither.
+	for (i = BC_CACHE_FUNC; i < p->fns.len; ++i)
+	{
+		size_t zero = 0;
+		size_t* def;
+
+		if (i * 2 == c->defs.len)
+		{
+			bc_vec_push(&c->defs, &zero);
+			bc_vec_push(&c->defs, &zero);
+		}
+
+		f = bc_vec_item(&p->fns, i);
+		def = bc_vec_item(&c->defs, i * 2);
+
+		if (def[0] == f->version && def[1] == f->code.len) continue;
+
+		def[0] = f->version;
+		def[1] = f->code.len;
+
+		bc_cache_pushDef(&c->events, f, i);
+	}
+
+	f = bc_vec_item(&p->fns, BC_PROG_MAIN);
+
+	// Record what was added to main, which bc would execute now.
+	if (f->code.len > c->code || f->labels.len > c->labels)
+	{
+		bc_cache_num(&c->events, BC_CACHE_EXEC);
+
+		bc_cache_num(&c->events, f->code.len - c->code);
+		bc_vec_npush(&c->events, f->code.len - c->code,
+		             bc_vec_item(&f->code, c->code));
+
+		bc_cache_num(&c->events, f->labels.len - c->labels);
+
+		for (i = c->labels; i < f->labels.len; ++i)
+		{
+			bc_cache_num(&c->events, *((size_t*) bc_vec_item(&f->labels, i)));
+		}
+
+		c->code = f->code.len;
+		c->labels = f->labels.len;
+	}
+
+	// Nothing is executed, but the parser has to think that it was, or it
+	// would optimize the same code again.
+	ip->idx = f->code.len;
+}
+
+void
+bc_cache_event(BcCache* c, BcCacheEvent e)
+{
+	BC_SIG_ASSERT_LOCKED;
+	bc_cache_num(&c->events, e);
+}
+
+/**
+ * Records the names in a map that were added after compiling started.
+ * @param v      The buffer to record into.
+ * @param map    The map.
+ * @param start  The number of names when compiling started.
+ */
+static void
+bc_cache_names(BcVec* v, const BcMap* map, size_t start)
+{
+	size_t i;
+
+	bc_cache_num(v, map->ids.len - start);
+
+	for (i = start; i < map->ids.len; ++i)
+	{
+		BcId* id = bc_vec_item(&map->ids, i);
+
+		assert(id->idx == i);
+
+		bc_cache_str(v, id->name);
+	}
+}
+
+void
+bc_cache_write(BcCache* c, const char* path)
+{
+	BcProgram* p = &vm->prog;
+	BcVec* v = &c->head;
+	size_t i, body = c->head.len, hash;
+	int fd;
+
+	BC_SIG_ASSERT_LOCKED;
+
+	// The new names come first, so that the events can refer to them.
+	bc_cache_num(v, p->fns.len - c->fns);
+
+	for (i = c->fns; i < p->fns.len; ++i)
+	{
+		BcFunc* f = bc_vec_item(&p->fns, i);
+		bc_cache_str(v, f->name);
+	}
+
+	bc_cache_names(v, &p->var_map, c->vars);
+	bc_cache_names(v, &p->arr_map, c->arrs);
+
+	bc_cache_num(v, p->consts.len - c->consts);
+
+	for (i = c->consts; i < p->consts.len; ++i)
+	{
+		BcConst* k = bc_vec_item(&p->consts, i);
+
+		bc_cache_str(v, k->val);
+		bc_vec_pushByte(v, k->op);
+		bc_cache_num(v, k->lhs);
+		bc_cache_num(v, k->rhs);
+	}
+
+	bc_cache_num(v, p->strs.len - c->strs);
+
+	for (i = c->strs; i < p->strs.len; ++i)
+	{
+		bc_cache_str(v, *((char**) bc_vec_item(&p->strs, i)));
+	}
+
+	bc_vec_npush(v, c->events.len, c->events.v);
+	bc_cache_num(v, BC_CACHE_END);
+
+	// The last number in the header is the hash of everything after it.
+	hash = bc_map_hashBytes(BC_MAP_HASH, v->v + body, v->len - body);
+
+	// NOLINTNEXTLINE
+	memcpy(v->v + body - sizeof(size_t), &hash, sizeof(size_t));
+
+#ifndef _WIN32
+	fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+#else // _WIN32
+	fd = -1;
+	open(&fd, path, _O_WRONLY | _O_CREAT | _O_TRUNC);
+#endif // _WIN32
+
+	if (BC_ERR(fd < 0))
+	{
+		bc_cache_free(c);
+		bc_verr(BC_ERR_FATAL_FILE_ERR, path);
+	}
+
+	for (i = 0; i < v->len;)
+	{
+		ssize_t w = write(fd, v->v + i, v->len - i);
+		if (BC_ERR(w <= 0)) break;
+		i += (size_t) w;
+	}
+
+	close(fd);
+
+	if (BC_ERR(i < v->len))
+	{
+		bc_cache_free(c);
+		bc_verr(BC_ERR_FATAL_IO_ERR, path);
+	}
+
+	bc_cache_free(c);
+}
+
+void
+bc_cache_free(BcCache* c)
+{
+	BC_SIG_ASSERT_LOCKED;
+
+	bc_vec_free(&c->head);
+	bc_vec_free(&c->events);
+	bc_vec_free(&c->defs);
+}
+
+/**
+ * Reads a number from a cache.
+ * @param c  The cache.
+ * @return   The number, or 0 if there was not one.
+ */
+static size_t
+bc_cache_readNum(BcCacheFile* c)
+{
+	size_t n = 0;
+
+	if (BC_ERR(c->len - c->pos < sizeof(size_t)))
+	{
+		c->bad = true;
+		c->pos = c->len;
+	}
+	else
+	{
+		memcpy(&n, c->data + c->pos, sizeof(size_t));
+		c->pos += sizeof(size_t);
+	}
+
+	return n;
+}
+
+/**
+ * Reads bytes from a cache. The bytes are not copied.
+ * @param c  The cache.
+ * @param n  The number of bytes.
+ * @return   The bytes, or the start of the cache if there were not enough.
+ */
+static const char*
+bc_cache_readBytes(BcCacheFile* c, size_t n)
+{
+	const char* bytes = c->data + c->pos;
+
+	if (BC_ERR(c->len - c->pos < n))
+	{
+		c->bad = true;
+		c->pos = c->len;
+		return c->data;
+	}
+
+	c->pos += n;
+
+	return bytes;
+}
+
+/**
+ * Reads a string from a cache. The string is not copied.
+ * @param c  The cache.
+ * @return   The string, or an empty string if there was not one.
+ */
+static const char*
+bc_cache_readStr(BcCacheFile* c)
+{
+	const char* str = c->data + c->pos;
+	const char* end = memchr(str, '\0', c->len - c->pos);
+
+	if (BC_ERR(end == NULL))
+	{
+		c->bad = true;
+		c->pos = c->len;
+		return "";
+	}
+
+	c->pos += (size_t) (end - str) + 1;
+
+	return str;
+}
+
+/**
+ * Reads the definition of a function from a cache and, if running, defines the
+ * function the way that the parser did.
+ * @param c     The cache.
+ * @param run   True if running, false if only checking.
+ * @param fns   The number of functions.
+ * @param vars  The number of variables.
+ * @param arrs  The number of arrays.
+ */
+static void
+bc_cache_readDef(BcCacheFile* c, bool run, size_t fns, size_t vars,
+                 size_t arrs)
+{
+	BcProgram* p = &vm->prog;
+	BcFunc* f = NULL;
+	const char* code;
+	size_t i, n, idx, version, nparams;
+	bool voidfn, memo;
+
+	idx = bc_cache_readNum(c);
+	version = bc_cache_readNum(c);
+	nparams = bc_cache_readNum(c);
+	voidfn = (bc_cache_readNum(c) != 0);
+	memo = (bc_cache_readNum(c) != 0);
+
+	n = bc_cache_readNum(c);
+	code = bc_cache_readBytes(c, n);
+
+	if (BC_ERR(idx < BC_CACHE_FUNC || idx >= fns)) c->bad = true;
+
+	if (run)
+	{
+		f = bc_vec_item(&p->fns, idx);
+
+		// This resets the function and drops memoized results, just like
+		// redefining the function in a script does. The version is set after
+		// because inlined copies of the function in the cache expect it.
+		bc_program_insertFunc(p, f->name);
+
+		f->version = version;
+		f->nparams = nparams;
+		f->voidfn = voidfn;
+		f->memo = memo;
+
+		bc_vec_npush(&f->code, n, code);
+	}
+
+	n = bc_cache_readNum(c);
+
+	for (i = 0; i < n && !c->bad; ++i)
+	{
+		size_t label = bc_cache_readNum(c);
+		if (run) bc_vec_push(&f->labels, &label);
+	}
+
+	n = bc_cache_readNum(c);
+
+	for (i = 0; i < n && !c->bad; ++i)
+	{
+		BcAuto a;
+
+		a.idx = bc_cache_readNum(c);
+		a.type = (BcType) bc_cache_readNum(c);
+
+		if (BC_ERR(a.idx >= (BC_IS_ARRAY(a.type) ? arrs : vars)))
+		{
+			c->bad = true;
+		}
+
+		if (run) bc_vec_push(&f->autos, &a);
+	}
+
+	if (BC_ERR(nparams > n)) c->bad = true;
+}
+
+/**
+ * Reads code for main from a cache and, if running, executes it.
+ * @param c    The cache.
+ * @param run  True if running, false if only checking.
+ */
+static void
+bc_cache_readExec(BcCacheFile* c, bool run)
+{
+	BcProgram* p = &vm->prog;
+	BcFunc* f = bc_vec_item(&p->fns, BC_PROG_MAIN);
+	const char* code;
+	size_t i, n;
+
+	n = bc_cache_readNum(c);
+	code = bc_cache_readBytes(c, n);
+
+	if (run) bc_vec_npush(&f->code, n, code);
+
+	n = bc_cache_readNum(c);
+
+	for (i = 0; i < n && !c->bad; ++i)
+	{
+		size_t label = bc_cache_readNum(c);
+		if (run) bc_vec_push(&f->labels, &label);
+	}
+
+	if (run)
+	{
+		BcInstPtr* ip;
+
+		n = f->code.len;
+
+		BC_SIG_UNLOCK;
+
+		bc_program_exec(p);
+
+		assert(p->results.len == 0);
+
+		// Flush in interactive mode, like bc_vm_process() does.
+		if (BC_I) bc_file_flush(&vm->fout, bc_flush_save);
+
+		BC_SIG_LOCK;
+
+		// With computed goto, bc_program_exec() adds an end marker to main.
+		// The labels in the cache do not count it, so it has to go.
+		bc_vec_npop(&f->code, f->code.len - n);
+
+		ip = bc_vec_item(&p->stack, 0);
+		ip->idx = f->code.len;
+	}
+}
+
+/**
+ * Goes through the body of a cache, either to check that it is well-formed or
+ * to run it. Checking must come first, so that running never finds anything
+ * wrong.
+ * @param c    The cache.
+ * @param run  True if running, false if only checking.
+ */
+static void
+bc_cache_replay(BcCacheFile* c, bool run)
+{
+	BcProgram* p = &vm->prog;
+	size_t i, n, e, fns, vars, arrs, consts;
+
+	BC_SIG_ASSERT_LOCKED;
+
+	// The names are all new, so they get the same indices that they had when
+	// the cache was compiled.
+	n = bc_cache_readNum(c);
+	fns = p->fns.len + n;
+
+	for (i = 0; i < n && !c->bad; ++i)
+	{
+		const char* name = bc_cache_readStr(c);
+		if (run) bc_program_insertFunc(p, name);
+	}
+
+	n = bc_cache_readNum(c);
+	vars = p->vars.len + n;
+
+	for (i = 0; i < n && !c->bad; ++i)
+	{
+		const char* name = bc_cache_readStr(c);
+		if (run) bc_program_search(p, name, true);
+	}
+
+	n = bc_cache_readNum(c);
+	arrs = p->arrs.len + n;
+
+	for (i = 0; i < n && !c->bad; ++i)
+	{
+		const char* name = bc_cache_readStr(c);
+		if (run) bc_program_search(p, name, false);
+	}
+
+	n = bc_cache_readNum(c);
+	consts = p->consts.len + n;
+
+	for (i = 0; i < n && !c->bad; ++i)
+	{
+		const char* val = bc_cache_readStr(c);
+		uchar op = (uchar) *bc_cache_readBytes(c, 1);
+		size_t lhs = bc_cache_readNum(c);
+		size_t rhs = bc_cache_readNum(c);
+
+		if (BC_ERR(op != BC_INST_INVALID && lhs >= consts)) c->bad = true;
+
+		if (run)
+		{
+			size_t idx = bc_parse_addConst(&vm->prs, val);
+			BcConst* k = bc_vec_item(&p->consts, idx);
+
+			k->op = op;
+			k->lhs = lhs;
+			k->rhs = rhs;
+		}
+	}
+
+	n = bc_cache_readNum(c);
+
+	for (i = 0; i < n && !c->bad; ++i)
+	{
+		const char* str = bc_cache_readStr(c);
+		if (run) bc_program_addString(p, str);
+	}
+
+	for (e = bc_cache_readNum(c); !c->bad && e != BC_CACHE_END;
+	     e = bc_cache_readNum(c))
+	{
+		switch (e)
+		{
+			case BC_CACHE_DEF:
+			{
+				bc_cache_readDef(c, run, fns, vars, arrs);
+				break;
+			}
+
+			case BC_CACHE_EXEC:
+			{
+				bc_cache_readExec(c, run);
+				break;
+			}
+
+			case BC_CACHE_LIMITS:
+			{
+				if (run) bc_parse_limits();
+				break;
+			}
+
+			case BC_CACHE_QUIT:
+			{
+				if (run)
+				{
+					vm->status = BC_STATUS_QUIT;
+					BC_JMP;
+				}
+
+				break;
+			}
+
+			default:
+			{
+				c->bad = true;
+				break;
+			}
+		}
+	}
+}
+
+/**
+ * Checks whether a cache can be run. It must be from this build of bc, bc must
+ * be in the state that it was in when the cache was compiled, the source must
+ * have the same size and hash, and the body must have the hash that was
+ * written with it. Modification times are not used, since they only change
+ * once a second on some systems.
+ * @param c  The cache, with the source path read.
+ * @return   True if the cache can be run, false otherwise.
+ */
+static bool
+bc_cache_check(BcCacheFile* c)
+{
+	BcVec build;
+	size_t size, hash, sum, body, len = 0;
+	bool good;
+
+	bc_vec_init(&build, sizeof(uchar), BC_DTOR_NONE);
+	bc_cache_build(&build);
+
+	good = (c->len - c->pos >= build.len &&
+	        !memcmp(c->data + c->pos, build.v, build.len));
+
+	if (good) c->pos += build.len;
+
+	bc_vec_free(&build);
+
+	if (!good) return false;
+
+	size = bc_cache_readNum(c);
+	hash = bc_cache_readNum(c);
+
+	if (bc_cache_readNum(c) != bc_cache_state()) return false;
+
+	sum = bc_cache_readNum(c);
+
+	if (c->bad) return false;
+
+	// The bytecode is trusted once it is read, so a cache that was truncated
+	// or changed after it was written must not get that far.
+	body = bc_map_hashBytes(BC_MAP_HASH, c->data + c->pos, c->len - c->pos);
+
+	if (body != sum) return false;
+
+	// Warnings only come from the parser.
+	if (BC_W) return false;
+
+	// An empty source is not mapped.
+	if (!size) good = (bc_cache_map(c->src, &len) == NULL);
+	else
+	{
+		char* text = bc_cache_map(c->src, &len);
+
+		if (text == NULL) return false;
+
+		good = (len == size &&
+		        bc_map_hashBytes(BC_MAP_HASH, text, len) == hash);
+
+		bc_cache_unmap(text, len);
+	}
+
+	if (!good) return false;
+
+	c->body = c->pos;
+
+	bc_cache_replay(c, false);
+
+	c->pos = c->body;
+
+	return !c->bad;
+}
+
+bool
+bc_cache_open(BcCacheFile* c, const char* path)
+{
+	const char* src;
+
+	BC_SIG_ASSERT_LOCKED;
+
+	c->data = bc_cache_map(path, &c->len);
+
+	if (c->data == NULL) return false;
+
+	if (c->len < BC_CACHE_MAGIC_LEN ||
+	    memcmp(c->data, BC_CACHE_MAGIC, BC_CACHE_MAGIC_LEN))
+	{
+		bc_cache_unmap(c->data, c->len);
+		return false;
+	}
+
+	c->pos = BC_CACHE_MAGIC_LEN;
+	c->bad = false;
+
+	src = bc_cache_readStr(c);
+
+	// Without the path of the source, there is nothing to fall back on.
+	if (BC_ERR(c->bad))
+	{
+		bc_cache_unmap(c->data, c->len);
+		bc_verr(BC_ERR_FATAL_BIN_FILE, path);
+	}
+
+	c->src = bc_vm_strdup(src);
+	c->good = bc_cache_check(c);
+
+	return true;
+}
+
+void
+bc_cache_run(BcCacheFile* c)
+{
+	assert(c->good);
+
+	BC_SIG_LOCK;
+	bc_cache_replay(c, true);
+	BC_SIG_UNLOCK;
+}
+
+void
+bc_cache_close(BcCacheFile* c)
+{
+	BC_SIG_ASSERT_LOCKED;
+
+	bc_cache_unmap(c->data, c->len);
+	free(c->src);
+}
+
+#endif // BC_ENABLED
@@ -67,6 +67,9 @@ bc_parse_expr_err(BcParse* p, uint8_t flags, BcParseNext next);
 static void
 bc_parse_expr_status(BcParse* p, uint8_t flags, BcParseNext next);
 
+static size_t
+bc_parse_instLen(const uchar* code, size_t idx);
+
 /**
  * Returns true if an instruction could only have come from a "leaf" expression.
  * For more on what leaf expressions are, read the comment for BC_PARSE_LEAF().
@@ -207,6 +210,19 @@ bc_parse_createCondLabel(BcParse* p, size_t idx)
 	bc_vec_push(&p->conds, &idx);
 }
 
+/**
+ * Sets a conditional label that was created earlier, for when code that comes
+ * before the label, like an inlined call, creates labels of its own.
+ * @param p    The parser.
+ * @param idx  The index of the label.
+ */
+static void
+bc_parse_setCondLabel(BcParse* p, size_t idx)
+{
+	*((size_t*) bc_vec_item(&p->func->labels, idx)) = p->func->code.len;
+	bc_vec_push(&p->conds, &idx);
+}
+
 /**
  * Creates an exit label to be filled in later by bc_parse_setLabel(). Also, why
  * create a label to be filled in later? Because exit labels are meant to be
@@ -320,8 +336,9 @@ bc_parse_rightParen(BcParse* p, size_t* nexprs)
  * @param p      The parser.
  * @param flags  Flags restricting what kind of expressions the arguments can
  *               be.
+ * @return       The number of arguments.
  */
-static void
+static size_t
 bc_parse_args(BcParse* p, uint8_t flags)
 {
 	bool comma = false;
@@ -346,9 +363,174 @@ bc_parse_args(BcParse* p, uint8_t flags)
 	// An ending comma is FAIL.
 	if (BC_ERR(comma)) bc_parse_err(p, BC_ERR_PARSE_TOKEN);
 
-	// Now do the call with the number of arguments.
-	bc_parse_push(p, BC_INST_CALL);
+	return nargs;
+}
+
+/**
+ * Decodes the bytecode index at @a idx, like bc_program_index() does.
+ * @param code  The bytecode.
+ * @param idx   The index of the length byte of the bytecode index.
+ * @return      The decoded index.
+ */
+static size_t
+bc_parse_index(const uchar* code, size_t idx)
+{
+	uchar i, amt = code[idx];
+	size_t res = 0;
+
+	for (i = 0; i < amt; ++i)
+	{
+		res |= ((size_t) code[idx + 1 + i]) << (i * CHAR_BIT);
+	}
+
+	return res;
+}
+
+/**
+ * Returns true if an instruction can be in the body of an inlined function.
+ * These only read variables and compute values; anything that calls, jumps,
+ * or assigns is not allowed.
+ * @param inst  The instruction.
+ * @return      True if @a inst can be inlined, false otherwise.
+ */
+static bool
+bc_parse_inlinable(uchar inst)
+{
+	return (inst >= BC_INST_NEG && inst <= BC_INST_BOOL_AND) ||
+	       inst == BC_INST_NUM || inst == BC_INST_VAR ||
+	       inst == BC_INST_ARRAY_ELEM ||
+	       (inst >= BC_INST_ZERO && inst <= BC_INST_SCALE) ||
+	       (inst >= BC_INST_LENGTH && inst <= BC_INST_IS_STRING);
+}
+
+/**
+ * Returns true if an instruction pushes a reference to something that can
+ * change, instead of a temporary. A call returns a copy of its value, so an
+ * inlined body must not leave one of these as its result; a later inlined call
+ * or assignment in the same expression could change it before it is read.
+ * @param inst  The instruction.
+ * @return      True if @a inst pushes a reference, false otherwise.
+ */
+static bool
+bc_parse_inlineRef(uchar inst)
+{
+	return inst == BC_INST_VAR || inst == BC_INST_ARRAY_ELEM ||
+	       (inst >= BC_INST_LAST && inst <= BC_INST_SCALE);
+}
+
+/**
+ * Returns the length of the body of a function if it can be inlined, or 0 if
+ * it cannot. A function can be inlined if its body is just the return of an
+ * expression made of inlinable instructions whose value is a temporary, and it
+ * has no autos and no array parameters. Because nothing in such a body can
+ * call a function, nothing can see the parameters through dynamic scoping, so
+ * they can be replaced.
+ * @param f      The function.
+ * @param nargs  The number of arguments of the call.
+ * @return       The length of the expression in the body of @a f, or 0.
+ */
+static size_t
+bc_parse_inlineLen(const BcFunc* f, size_t nargs)
+{
+	const uchar* code = (const uchar*) f->code.v;
+	size_t i, last = 0, len = f->code.len;
+
+	if (f->voidfn || f->memo || nargs != f->nparams ||
+	    f->autos.len != f->nparams || f->labels.len || len < 3 ||
+	    len - 2 > BC_PARSE_INLINE_MAX)
+	{
+		return 0;
+	}
+
+	for (i = 0; i < f->autos.len; ++i)
+	{
+		const BcAuto* a = bc_vec_item(&f->autos, i);
+		if (a->type != BC_TYPE_VAR) return 0;
+	}
+
+	// The body must be the expression, BC_INST_RET, and the BC_INST_RET0 that
+	// ends every function.
+	for (i = 0; i < len - 2; i += bc_parse_instLen(code, i))
+	{
+		if (!bc_parse_inlinable(code[i])) return 0;
+		last = i;
+	}
+
+	if (i != len - 2 || code[i] != BC_INST_RET || code[i + 1] != BC_INST_RET0 ||
+	    bc_parse_inlineRef(code[last]))
+	{
+		return 0;
+	}
+
+	return i;
+}
+
+/**
+ * Inlines a call if possible. The arguments are already on the stack, and the
+ * call becomes BC_INST_INLINE, followed by the body of the function with its
+ * parameters replaced by hidden variables. A label after the body lets
+ * BC_INST_INLINE skip it and make a normal call if the function is redefined.
+ * @param p      The parser.
+ * @param fidx   The index of the function to call.
+ * @param nargs  The number of arguments.
+ * @return       True if the call was inlined, false otherwise.
+ */
+static bool
+bc_parse_inline(BcParse* p, size_t fidx, size_t nargs)
+{
+	BcFunc* f = bc_vec_item(&p->prog->fns, fidx);
+	const uchar* code = (const uchar*) f->code.v;
+	size_t i, j, label, len;
+
+	if (BC_PARSE_STACK_ONLY || fidx == p->fidx) return false;
+
+	len = bc_parse_inlineLen(f, nargs);
+	if (!len) return false;
+
+	label = p->func->labels.len;
+	bc_parse_createLabel(p, SIZE_MAX);
+
+	bc_parse_push(p, BC_INST_INLINE);
 	bc_parse_pushIndex(p, nargs);
+	bc_parse_pushIndex(p, fidx);
+	bc_parse_pushIndex(p, f->version);
+	bc_parse_pushIndex(p, label);
+
+	// The last argument is on top of the stack, so it is stored first.
+	for (i = nargs; i > 0; --i)
+	{
+		bc_parse_pushIndex(p, bc_program_inlineVar(p->prog, i - 1));
+	}
+
+	// Copy the body, replacing the parameters.
+	for (i = 0; i < len; i += j)
+	{
+		j = bc_parse_instLen(code, i);
+
+		if (code[i] == BC_INST_VAR)
+		{
+			size_t k, idx = bc_parse_index(code, i + 1);
+
+			for (k = 0; k < f->nparams; ++k)
+			{
+				const BcAuto* a = bc_vec_item(&f->autos, k);
+				if (a->idx == idx) break;
+			}
+
+			if (k < f->nparams)
+			{
+				bc_parse_push(p, BC_INST_VAR);
+				bc_parse_pushIndex(p, bc_program_inlineVar(p->prog, k));
+				continue;
+			}
+		}
+
+		bc_vec_npush(&p->func->code, j, code + i);
+	}
+
+	*((size_t*) bc_vec_item(&p->func->labels, label)) = p->func->code.len;
+
+	return true;
 }
 
 /**
@@ -360,9 +542,9 @@ bc_parse_args(BcParse* p, uint8_t flags)
 static void
 bc_parse_call(BcParse* p, const char* name, uint8_t flags)
 {
-	size_t idx;
+	size_t idx, nargs;
 
-	bc_parse_args(p, flags);
+	nargs = bc_parse_args(p, flags);
 
 	// We just assert this because bc_parse_args() should
 	// ensure that the next token is what it should be.
@@ -384,9 +566,16 @@ bc_parse_call(BcParse* p, const char* name, uint8_t flags)
 		p->func = bc_vec_item(&p->prog->fns, p->fidx);
 	}
 	// The function exists, so set the right function index.
-	else idx = ((BcId*) bc_vec_item(&p->prog->fn_map, idx))->idx;
+	else idx = ((BcId*) bc_vec_item(&p->prog->fn_map.ids, idx))->idx;
 
-	bc_parse_pushIndex(p, idx);
+	// Small functions can be inlined; otherwise, do the call with the number
+	// of arguments.
+	if (!bc_parse_inline(p, idx, nargs))
+	{
+		bc_parse_push(p, BC_INST_CALL);
+		bc_parse_pushIndex(p, nargs);
+		bc_parse_pushIndex(p, idx);
+	}
 
 	// Make sure to get the next token.
 	bc_lex_next(&p->l);
@@ -553,8 +742,8 @@ bc_parse_builtin(BcParse* p, BcLexType type, uint8_t flags, BcInst* prev)
 }
 
 /**
- * Parses a builtin function that takes 3 arguments. This includes modexp() and
- * divmod().
+ * Parses a builtin function that takes 2 or 3 arguments. This includes
+ * modexp(), divmod(), modinv(), and egcd().
  * @param p      The parser.
  * @param type   The lex token.
  * @param flags  The expression parsing flags for parsing the argument.
@@ -563,7 +752,13 @@ bc_parse_builtin(BcParse* p, BcLexType type, uint8_t flags, BcInst* prev)
 static void
 bc_parse_builtin3(BcParse* p, BcLexType type, uint8_t flags, BcInst* prev)
 {
-	assert(type == BC_LEX_KW_MODEXP || type == BC_LEX_KW_DIVMOD);
+	bool arr;
+
+	assert(type == BC_LEX_KW_MODEXP || type == BC_LEX_KW_DIVMOD ||
+	       type == BC_LEX_KW_MODINV || type == BC_LEX_KW_EGCD);
+
+	// divmod() and egcd() return extra values through an array.
+	arr = (type == BC_LEX_KW_DIVMOD || type == BC_LEX_KW_EGCD);
 
 	// Must have a left paren.
 	bc_lex_next(&p->l);
@@ -582,16 +777,27 @@ bc_parse_builtin3(BcParse* p, BcLexType type, uint8_t flags, BcInst* prev)
 
 	bc_lex_next(&p->l);
 
-	bc_parse_expr_status(p, flags, bc_parse_next_builtin);
+	// modinv() only takes two arguments.
+	if (type == BC_LEX_KW_MODINV)
+	{
+		bc_parse_expr_status(p, flags, bc_parse_next_rel);
+	}
+	else bc_parse_expr_status(p, flags, bc_parse_next_builtin);
 
-	// Must have a comma.
-	if (BC_ERR(p->l.t != BC_LEX_COMMA)) bc_parse_err(p, BC_ERR_PARSE_TOKEN);
+	// If it has a third argument, it must have a comma.
+	if (type != BC_LEX_KW_MODINV)
+	{
+		if (BC_ERR(p->l.t != BC_LEX_COMMA))
+		{
+			bc_parse_err(p, BC_ERR_PARSE_TOKEN);
+		}
 
-	bc_lex_next(&p->l);
+		bc_lex_next(&p->l);
+	}
 
-	// If it is a divmod, parse an array name. Otherwise, just parse another
-	// expression.
-	if (type == BC_LEX_KW_DIVMOD)
+	// If it is a divmod or egcd, parse an array name. If it is a modexp, just
+	// parse another expression.
+	if (arr)
 	{
 		// Must have a name.
 		if (BC_ERR(p->l.t != BC_LEX_NAME)) bc_parse_err(p, BC_ERR_PARSE_TOKEN);
@@ -617,7 +823,10 @@ bc_parse_builtin3(BcParse* p, BcLexType type, uint8_t flags, BcInst* prev)
 		// This is safe because the next token should not overwrite the name.
 		bc_lex_next(&p->l);
 	}
-	else bc_parse_expr_status(p, flags, bc_parse_next_rel);
+	else if (type == BC_LEX_KW_MODEXP)
+	{
+		bc_parse_expr_status(p, flags, bc_parse_next_rel);
+	}
 
 	// Must have a right paren.
 	if (BC_ERR(p->l.t != BC_LEX_RPAREN)) bc_parse_err(p, BC_ERR_PARSE_TOKEN);
@@ -626,9 +835,28 @@ bc_parse_builtin3(BcParse* p, BcLexType type, uint8_t flags, BcInst* prev)
 	*prev = type - BC_LEX_KW_MODEXP + BC_INST_MODEXP;
 	bc_parse_push(p, *prev);
 
+	// If we have egcd, we need to assign the second cofactor to the first
+	// array element, and then the first cofactor falls through to the code
+	// below for the zeroth element.
+	if (type == BC_LEX_KW_EGCD)
+	{
+		// The first element.
+		bc_parse_push(p, BC_INST_ONE);
+		bc_parse_push(p, BC_INST_ARRAY_ELEM);
+
+		// Push the array.
+		bc_parse_pushName(p, p->l.str.v, false);
+
+		// Swap them and assign. After this, the top item on the stack should
+		// be the first cofactor.
+		bc_parse_push(p, BC_INST_SWAP);
+		bc_parse_push(p, BC_INST_ASSIGN_NO_VAL);
+	}
+
 	// If we have divmod, we need to assign the modulus to the array element, so
-	// we need to push the instructions for doing so.
-	if (type == BC_LEX_KW_DIVMOD)
+	// we need to push the instructions for doing so. egcd also needs to assign
+	// the first cofactor.
+	if (arr)
 	{
 		// The zeroth element.
 		bc_parse_push(p, BC_INST_ZERO);
@@ -871,6 +1099,33 @@ bc_parse_print(BcParse* p, BcLexType type)
 	if (BC_ERR(comma)) bc_parse_err(p, BC_ERR_PARSE_TOKEN);
 }
 
+/**
+ * Turns the call at the end of the return expression that starts at @a idx
+ * into BC_INST_TAIL_CALL if it is a call to the function being parsed.
+ * @param p    The parser.
+ * @param idx  The index of the start of the return expression.
+ */
+static void
+bc_parse_tailCall(BcParse* p, size_t idx)
+{
+	uchar* code = (uchar*) p->func->code.v;
+	size_t len = p->func->code.len, last = idx;
+
+	// Find the last instruction.
+	while (idx < len)
+	{
+		last = idx;
+		idx += bc_parse_instLen(code, idx);
+	}
+
+	if (last >= len || code[last] != BC_INST_CALL) return;
+
+	// The function index is the second index.
+	idx = bc_parse_index(code, last + 2 + code[last + 1]);
+
+	if (idx == p->fidx) code[last] = BC_INST_TAIL_CALL;
+}
+
 /**
  * Parses a return statement.
  * @param p  The parser.
@@ -898,6 +1153,7 @@ bc_parse_return(BcParse* p)
 	else
 	{
 		BcParseStatus s;
+		size_t start = p->func->code.len;
 
 		// Need to parse the expression whose value will be returned.
 		s = bc_parse_expr_err(p, BC_PARSE_NEEDVAL, bc_parse_next_expr);
@@ -923,10 +1179,665 @@ bc_parse_return(BcParse* p)
 				bc_parse_verr(p, BC_ERR_PARSE_RET_VOID, p->func->name);
 			}
 		}
-		// If we got here, we want to be sure to end the function with a real
-		// return instruction, just in case.
-		else bc_parse_push(p, BC_INST_RET);
+		else
+		{
+			// A call to this function can reuse its frame. The return
+			// instruction is still needed in case it can't.
+			if (!BC_PARSE_STACK_ONLY && s != BC_PARSE_STATUS_EMPTY_EXPR)
+			{
+				bc_parse_tailCall(p, start);
+			}
+
+			// If we got here, we want to be sure to end the function with a
+			// real return instruction, just in case.
+			bc_parse_push(p, BC_INST_RET);
+		}
+	}
+}
+
+/**
+ * Returns the length of the instruction at @a idx in @a code, including any
+ * indices that follow it. A superinstruction only counts its first index; the
+ * rest of its fused sequence is made of ordinary instructions, except for the
+ * relational operator after BC_INST_REL_JUMP_ZERO.
+ * @param code  The bytecode.
+ * @param idx   The index of the instruction.
+ * @return      The length of the instruction.
+ */
+static size_t
+bc_parse_instLen(const uchar* code, size_t idx)
+{
+	uchar inst = code[idx];
+	size_t len = 1;
+
+	// These have something else before their last index: the relational
+	// operator and the first index, respectively.
+	if (inst == BC_INST_REL_JUMP_ZERO) len += 1;
+	else if (inst == BC_INST_CALL || inst == BC_INST_TAIL_CALL)
+	{
+		len += 1 + code[idx + len];
+	}
+
+	switch (inst)
+	{
+		case BC_INST_NUM:
+		case BC_INST_VAR:
+		case BC_INST_ARRAY_ELEM:
+		case BC_INST_ARRAY:
+		case BC_INST_STR:
+		case BC_INST_JUMP:
+		case BC_INST_JUMP_ZERO:
+		case BC_INST_CALL:
+		case BC_INST_TAIL_CALL:
+		case BC_INST_VAR_OP_CONST:
+		case BC_INST_ARRAY_OP_CONST:
+		case BC_INST_REL_JUMP_ZERO:
+		case BC_INST_VAR_ASSIGN_REGS:
+		case BC_INST_VAR_ADDMUL:
+		{
+			len += 1 + code[idx + len];
+			break;
+		}
+
+		case BC_INST_INLINE:
+		{
+			size_t i, n = bc_parse_index(code, idx + 1);
+
+			// The number of arguments, the function, the version, the label,
+			// and a variable for each argument.
+			for (i = 0; i < n + 4; ++i)
+			{
+				len += 1 + code[idx + len];
+			}
+
+			break;
+		}
+
+		default:
+		{
+			break;
+		}
+	}
+
+	return len;
+}
+
+/**
+ * Returns true if the instruction at @a idx in @a code pushes a constant, which
+ * means that it is BC_INST_NUM, BC_INST_ZERO, or BC_INST_ONE.
+ * @param code  The bytecode.
+ * @param idx   The index of the instruction.
+ * @return      True if the instruction pushes a constant, false otherwise.
+ */
+static bool
+bc_parse_isConst(const uchar* code, size_t idx)
+{
+	uchar inst = code[idx];
+	return inst == BC_INST_NUM || inst == BC_INST_ZERO || inst == BC_INST_ONE;
+}
+
+/**
+ * Returns the length of the instruction sequence at @a idx in @a code that
+ * can be replaced by a superinstruction, or 0 if there is none. For the
+ * sequences that are recognized, see the development manual
+ * (manuals/development.md#superinstructions).
+ * @param code  The bytecode.
+ * @param idx   The index of the first instruction in the sequence.
+ * @param len   The length of the bytecode.
+ * @return      The length of the sequence, or 0 if there is no sequence.
+ */
+static size_t
+bc_parse_fusable(const uchar* code, size_t idx, size_t len)
+{
+	uchar inst = code[idx];
+	size_t i, first;
+
+	// Relational operator followed by a conditional jump.
+	if (inst >= BC_INST_REL_EQ && inst <= BC_INST_REL_GT)
+	{
+		return (idx + 1 < len && code[idx + 1] == BC_INST_JUMP_ZERO) ? 2 : 0;
+	}
+
+	if (inst != BC_INST_VAR && inst != BC_INST_ARRAY_ELEM) return 0;
+
+	first = bc_parse_instLen(code, idx);
+	i = idx + first;
+
+	// Check for the x = x op c form. The variable has to be the same, which
+	// means that the index bytes must be the same as well.
+	if (inst == BC_INST_VAR && i < len && code[i] == BC_INST_VAR &&
+	    i + first <= len && !memcmp(code + idx + 1, code + i + 1, first - 1))
+	{
+		i += first;
+
+		if (i >= len || !bc_parse_isConst(code, i)) return 0;
+
+		i += bc_parse_instLen(code, i);
+
+		if (i + 1 >= len || code[i] < BC_INST_POWER ||
+		    code[i] >= BC_INST_REL_EQ || code[i + 1] != BC_INST_ASSIGN_NO_VAL)
+		{
+			return 0;
+		}
+
+		return i + 2 - idx;
+	}
+
+	// Check for the x op= c and a[i] op= c forms.
+	if (i >= len || !bc_parse_isConst(code, i)) return 0;
+
+	i += bc_parse_instLen(code, i);
+
+	if (i >= len || code[i] < BC_INST_ASSIGN_POWER_NO_VAL ||
+	    code[i] >= BC_INST_ASSIGN_NO_VAL)
+	{
+		return 0;
+	}
+
+	return i + 1 - idx;
+}
+
+/**
+ * Returns the length of the instruction sequence at @a idx in @a code that can
+ * be replaced by BC_INST_VAR_ASSIGN_REGS, or 0 if there is none. The sequence
+ * is an assignment to a variable whose value is not used, and the expression
+ * on the right can only have variables, constants, and binary operators, and
+ * it must fit in the registers.
+ * @param code  The bytecode.
+ * @param idx   The index of the first instruction in the sequence.
+ * @param len   The length of the bytecode.
+ * @return      The length of the sequence, or 0 if there is no sequence.
+ */
+static size_t
+bc_parse_regs(const uchar* code, size_t idx, size_t len)
+{
+	size_t i, depth = 0;
+	bool op = false;
+
+	if (code[idx] != BC_INST_VAR) return 0;
+
+	i = idx + bc_parse_instLen(code, idx);
+
+	// Track the depth that the results stack would have.
+	while (i < len)
+	{
+		uchar inst = code[i];
+
+		if (inst == BC_INST_VAR || bc_parse_isConst(code, i))
+		{
+			if (depth == BC_PROG_REG_DEPTH) return 0;
+
+			depth += 1;
+			i += bc_parse_instLen(code, i);
+		}
+		else if (inst >= BC_INST_POWER && inst < BC_INST_REL_EQ)
+		{
+			if (depth < 2) return 0;
+
+			depth -= 1;
+			op = true;
+			i += 1;
+		}
+		else break;
 	}
+
+	if (i >= len || depth != 1) return 0;
+
+	// A plain assignment without an operator would just be a copy.
+	if (code[i] == BC_INST_ASSIGN_NO_VAL) return op ? i + 1 - idx : 0;
+
+	if (code[i] < BC_INST_ASSIGN_POWER_NO_VAL ||
+	    code[i] >= BC_INST_ASSIGN_NO_VAL)
+	{
+		return 0;
+	}
+
+	return i + 1 - idx;
+}
+
+/**
+ * Returns the length of the instruction sequence at @a idx in @a code that can
+ * be replaced by BC_INST_VAR_ADDMUL, or 0 if there is none. The sequence is
+ * x += a * b or x -= a * b, where the value is not used, and where a and b are
+ * variables or constants.
+ * @param code  The bytecode.
+ * @param idx   The index of the first instruction in the sequence.
+ * @param len   The length of the bytecode.
+ * @return      The length of the sequence, or 0 if there is no sequence.
+ */
+static size_t
+bc_parse_addmul(const uchar* code, size_t idx, size_t len)
+{
+	size_t i, j;
+
+	if (code[idx] != BC_INST_VAR) return 0;
+
+	i = idx + bc_parse_instLen(code, idx);
+
+	// The two factors.
+	for (j = 0; j < 2; ++j)
+	{
+		if (i >= len || (code[i] != BC_INST_VAR && !bc_parse_isConst(code, i)))
+		{
+			return 0;
+		}
+
+		i += bc_parse_instLen(code, i);
+	}
+
+	if (i + 1 >= len || code[i] != BC_INST_MULTIPLY) return 0;
+
+	i += 1;
+
+	if (code[i] != BC_INST_ASSIGN_PLUS_NO_VAL &&
+	    code[i] != BC_INST_ASSIGN_MINUS_NO_VAL)
+	{
+		return 0;
+	}
+
+	return i + 1 - idx;
+}
+
+/**
+ * Returns the index of the constant that the instruction at @a idx in @a code
+ * pushes. BC_INST_ZERO and BC_INST_ONE are turned into real constants.
+ * @param p     The parser.
+ * @param code  The bytecode.
+ * @param idx   The index of the instruction.
+ * @return      The index of the constant.
+ */
+static size_t
+bc_parse_constIdx(BcParse* p, const uchar* code, size_t idx)
+{
+	if (code[idx] == BC_INST_ZERO) return bc_parse_addConst(p, bc_parse_zero);
+	if (code[idx] == BC_INST_ONE) return bc_parse_addConst(p, bc_parse_one);
+
+	return bc_parse_index(code, idx + 1);
+}
+
+/**
+ * Adds a folded constant for an operator on constants and returns its index.
+ * The value is not computed here; see bc_program_constFold().
+ * @param p    The parser.
+ * @param op   The operator.
+ * @param lhs  The index of the left (or only) operand.
+ * @param rhs  The index of the right operand, if any.
+ * @return     The index of the folded constant.
+ */
+static size_t
+bc_parse_foldConst(BcParse* p, uchar op, size_t lhs, size_t rhs)
+{
+	BcConst* c = bc_vec_item(&p->prog->consts, lhs);
+	size_t idx;
+
+	// The name of a folded constant is its expression in parentheses, which
+	// cannot collide with the name of a real constant, and which makes equal
+	// expressions share a constant.
+	bc_vec_string(&p->buf, 1, "(");
+
+	if (op == BC_INST_NEG)
+	{
+		bc_vec_concat(&p->buf, "-");
+		bc_vec_concat(&p->buf, c->val);
+	}
+	else
+	{
+		bc_vec_concat(&p->buf, c->val);
+		bc_vec_concat(&p->buf, bc_parse_fold_ops[op - BC_INST_POWER]);
+		c = bc_vec_item(&p->prog->consts, rhs);
+		bc_vec_concat(&p->buf, c->val);
+	}
+
+	bc_vec_concat(&p->buf, ")");
+
+	idx = bc_parse_addConst(p, p->buf.v);
+
+	c = bc_vec_item(&p->prog->consts, idx);
+	c->op = op;
+	c->lhs = lhs;
+	c->rhs = rhs;
+
+	return idx;
+}
+
+/**
+ * Folds operators on constants in the bytecode of the current function from
+ * @a idx to the end. Each operator and its constant operands are replaced by
+ * BC_INST_NUM with a folded constant, and labels after them are moved. The
+ * bytecode must end on a statement boundary.
+ * @param p    The parser.
+ * @param idx  The index of the first instruction to look at.
+ */
+static void
+bc_parse_fold(BcParse* p, size_t idx)
+{
+	BcFunc* f = p->func;
+	BcVec* code = &f->code;
+
+	bc_vec_popAll(&p->folds);
+
+	while (idx < code->len)
+	{
+		uchar* c = (uchar*) code->v;
+		uchar inst = c[idx];
+		uchar bytes[sizeof(size_t) + 2];
+		size_t i, start, lhs, rhs = 0, n = 0, old, len;
+		bool good;
+
+		// Constants are kept as long as they are in an unbroken run.
+		if (bc_parse_isConst(c, idx))
+		{
+			bc_vec_push(&p->folds, &idx);
+			idx += bc_parse_instLen(c, idx);
+			continue;
+		}
+
+		// Figure out how many constants the operator needs, if it is one that
+		// can be folded at all.
+		if (inst >= BC_INST_POWER && inst < BC_INST_REL_EQ) n = 2;
+		else if (inst == BC_INST_NEG) n = 1;
+
+		good = (n && p->folds.len >= n && idx + 1 < code->len);
+
+		start = good ? *((size_t*) bc_vec_item_rev(&p->folds, n - 1)) : idx;
+
+		// Make sure that nothing jumps into the middle of the sequence.
+		for (i = 0; good && i < f->labels.len; ++i)
+		{
+			size_t addr = *((size_t*) bc_vec_item(&f->labels, i));
+			good = (addr <= start || addr > idx);
+		}
+
+		if (!good)
+		{
+			bc_vec_popAll(&p->folds);
+			idx += bc_parse_instLen(c, idx);
+			continue;
+		}
+
+		lhs = bc_parse_constIdx(p, c, start);
+		if (n == 2)
+		{
+			rhs = bc_parse_constIdx(p, c, *((size_t*) bc_vec_top(&p->folds)));
+		}
+
+		// Encode the instruction for the folded constant like
+		// bc_vec_pushIndex() does.
+		i = bc_parse_foldConst(p, inst, lhs, rhs);
+
+		bytes[0] = BC_INST_NUM;
+
+		for (len = 2; i; ++len, i >>= CHAR_BIT)
+		{
+			bytes[len] = (uchar) i;
+		}
+
+		bytes[1] = (uchar) (len - 2);
+
+		old = idx + 1 - start;
+
+		// Replace the sequence. The new instruction could be longer.
+		if (len > old) bc_vec_grow(code, len - old);
+
+		c = (uchar*) code->v;
+
+		// NOLINTNEXTLINE
+		memmove(c + start + len, c + idx + 1, code->len - idx - 1);
+		// NOLINTNEXTLINE
+		memcpy(c + start, bytes, len);
+
+		code->len = code->len - old + len;
+
+		// Move the labels that were after the sequence.
+		for (i = 0; i < f->labels.len; ++i)
+		{
+			size_t* addr = bc_vec_item(&f->labels, i);
+			if (*addr != SIZE_MAX && *addr > idx) *addr = *addr - old + len;
+		}
+
+		// The folded constant can be an operand of the next operator.
+		bc_vec_npop(&p->folds, n);
+		bc_vec_push(&p->folds, &start);
+
+		idx = start + len;
+	}
+}
+
+/**
+ * Returns the index of the first instruction in main that has not been
+ * executed yet.
+ * @param p  The parser.
+ * @return   The index of the first instruction that has not been executed.
+ */
+static size_t
+bc_parse_execIdx(const BcParse* p)
+{
+	BcInstPtr* ip = bc_vec_item(&p->prog->stack, 0);
+
+	assert(p->fidx == BC_PROG_MAIN && ip->func == BC_PROG_MAIN);
+
+	return ip->idx;
+}
+
+/**
+ * Runs the optimization passes over the bytecode of the current function from
+ * @a idx to the end. First, operators on constants are folded. Then, common
+ * instruction sequences are replaced with superinstructions without changing
+ * the length of the bytecode, so labels stay valid, but sequences that a label
+ * points into are left alone. The bytecode must end on a statement boundary.
+ * @param p    The parser.
+ * @param idx  The index of the first instruction to look at.
+ */
+static void
+bc_parse_optimize(BcParse* p, size_t idx)
+{
+	BcFunc* f;
+	uchar* code;
+	size_t len;
+
+	// Leave the bytecode alone if we only want to use the results stack.
+	if (BC_PARSE_STACK_ONLY) return;
+
+	bc_parse_fold(p, idx);
+
+	f = p->func;
+	code = (uchar*) f->code.v;
+	len = f->code.len;
+
+	while (idx < len)
+	{
+		size_t i, n = bc_parse_fusable(code, idx, len);
+		bool addmul = false, regs = false;
+
+		// If there is no other superinstruction, try a multiply-accumulate,
+		// and then evaluating an assignment in registers, which is more
+		// general.
+		if (!n)
+		{
+			n = bc_parse_addmul(code, idx, len);
+			addmul = (n != 0);
+		}
+
+		if (!n)
+		{
+			n = bc_parse_regs(code, idx, len);
+			regs = (n != 0);
+		}
+
+		// Make sure that nothing jumps into the middle of the sequence.
+		for (i = 0; n && i < f->labels.len; ++i)
+		{
+			size_t addr = *((size_t*) bc_vec_item(&f->labels, i));
+			if (addr > idx && addr < idx + n) n = 0;
+		}
+
+		if (n)
+		{
+			uchar inst = code[idx];
+
+			if (addmul) code[idx] = BC_INST_VAR_ADDMUL;
+			else if (regs) code[idx] = BC_INST_VAR_ASSIGN_REGS;
+			else if (inst == BC_INST_VAR) code[idx] = BC_INST_VAR_OP_CONST;
+			else if (inst == BC_INST_ARRAY_ELEM)
+			{
+				code[idx] = BC_INST_ARRAY_OP_CONST;
+			}
+			else
+			{
+				code[idx] = BC_INST_REL_JUMP_ZERO;
+				code[idx + 1] = inst;
+			}
+		}
+
+		idx += bc_parse_instLen(code, idx);
+	}
+}
+
+/**
+ * Returns the length of a jump instruction to the label at @a idx, which is the
+ * instruction and the index, encoded like bc_vec_pushIndex() does.
+ * @param idx  The index of the label.
+ * @return     The length of the jump instruction.
+ */
+static size_t
+bc_parse_jumpLen(size_t idx)
+{
+	size_t len;
+
+	for (len = 2; idx; ++len, idx >>= CHAR_BIT)
+	{
+		continue;
+	}
+
+	return len;
+}
+
+/**
+ * Rotates the loop whose body has just been parsed so that its condition comes
+ * after its body. A loop is parsed as
+ *
+ *     C: condition, JUMP_ZERO exit, (JUMP body, U: update, JUMP C,) body, JUMP
+ *
+ * where the parenthesized part is only in for loops, which means that each
+ * iteration takes two or three jumps. After rotation, it is
+ *
+ *     JUMP C, body, (U: update,) C: negated condition, JUMP_ZERO body
+ *
+ * which only takes the one conditional jump per iteration. The condition is
+ * negated by replacing its last relational operator with its complement, which
+ * the optimizer can then fuse with the jump, or, in for loops, by adding a
+ * BC_INST_BOOL_NOT. Labels that point into the loop are moved with the code.
+ * @param p      The parser.
+ * @param label  The index of the label that the end of the body jumps to. This
+ *               is the update label for for loops and the condition label for
+ *               while loops.
+ * @return       True if the loop was rotated, false otherwise.
+ */
+static bool
+bc_parse_rotate(BcParse* p, size_t label)
+{
+	BcFunc* f = p->func;
+	BcInstPtr* ip = bc_vec_top(&p->exits);
+	size_t* labels = (size_t*) f->labels.v;
+	size_t i, n, cidx, bidx, start, cend, uend, body, update, last, len;
+	size_t newb, newu, newc;
+	uchar* code;
+	bool for_loop, rel;
+
+	// Leave the bytecode alone if we only want to use the results stack.
+	if (BC_PARSE_STACK_ONLY) return false;
+
+	// The labels of a for loop are the condition, the update, the body, and
+	// the exit, in that order, and a while loop has the condition, the exit,
+	// and the body.
+	for_loop = (ip->idx == label + 2);
+
+	assert(for_loop || ip->idx == label + 1);
+
+	cidx = for_loop ? label - 1 : label;
+	bidx = for_loop ? label + 1 : label + 2;
+
+	// Labels in the loop that are not set yet would not be moved, so do not
+	// rotate. The labels after the loop's own are the labels in the loop.
+	for (i = label + 3; i < f->labels.len; ++i)
+	{
+		if (labels[i] == SIZE_MAX) return false;
+	}
+
+	start = labels[cidx];
+	body = labels[bidx];
+
+	// Find where the condition and the update end.
+	if (for_loop)
+	{
+		update = labels[label];
+		uend = body - bc_parse_jumpLen(cidx);
+		cend = update - bc_parse_jumpLen(bidx) - bc_parse_jumpLen(ip->idx);
+	}
+	else
+	{
+		update = uend = body;
+		cend = body - bc_parse_jumpLen(ip->idx);
+	}
+
+	code = (uchar*) f->code.v;
+
+	// Find the last instruction of the condition.
+	for (last = start; (n = last + bc_parse_instLen(code, last)) < cend;)
+	{
+		last = n;
+	}
+
+	rel = (code[last] >= BC_INST_REL_EQ && code[last] <= BC_INST_REL_GT);
+
+	// If the condition of a while loop would need a BC_INST_BOOL_NOT, that
+	// would take the place of the jump that is saved.
+	if (!for_loop && !rel) return false;
+
+	len = f->code.len - start;
+
+	// Save the loop and put it back together in the new order.
+	bc_vec_popAll(&p->buf);
+	bc_vec_npush(&p->buf, len, code + start);
+	bc_vec_npop(&f->code, len);
+
+	bc_parse_push(p, BC_INST_JUMP);
+	bc_parse_pushIndex(p, cidx);
+
+	newb = f->code.len;
+	bc_vec_npush(&f->code, start + len - body, p->buf.v + body - start);
+	newu = f->code.len;
+	bc_vec_npush(&f->code, uend - update, p->buf.v + update - start);
+	newc = f->code.len;
+	bc_vec_npush(&f->code, cend - start, p->buf.v);
+
+	// The buffer is expected to hold a string.
+	bc_vec_popAll(&p->buf);
+
+	code = (uchar*) f->code.v;
+	n = newc + last - start;
+
+	// Negate the condition.
+	if (rel) code[n] = bc_parse_rel_nots[code[n] - BC_INST_REL_EQ];
+	else bc_parse_push(p, BC_INST_BOOL_NOT);
+
+	bc_parse_push(p, BC_INST_JUMP_ZERO);
+	bc_parse_pushIndex(p, bidx);
+
+	// Move the labels in the loop. The end of each part is the start of what
+	// comes after it, both before and after rotation.
+	for (i = label + 3; i < f->labels.len; ++i)
+	{
+		if (labels[i] >= body) labels[i] = labels[i] - body + newb;
+		else if (labels[i] >= update) labels[i] = labels[i] - update + newu;
+		else labels[i] = labels[i] - start + newc;
+	}
+
+	labels[cidx] = newc;
+	labels[bidx] = newb;
+	if (for_loop) labels[label] = newu;
+
+	return true;
 }
 
 /**
@@ -992,8 +1903,11 @@ bc_parse_endBody(BcParse* p, bool brace)
 			{
 				size_t* label = bc_vec_top(&p->conds);
 
-				bc_parse_push(p, BC_INST_JUMP);
-				bc_parse_pushIndex(p, *label);
+				if (!bc_parse_rotate(p, *label))
+				{
+					bc_parse_push(p, BC_INST_JUMP);
+					bc_parse_pushIndex(p, *label);
+				}
 
 				bc_vec_pop(&p->conds);
 			}
@@ -1006,6 +1920,7 @@ bc_parse_endBody(BcParse* p, bool brace)
 		{
 			BcInst inst = (p->func->voidfn ? BC_INST_RET_VOID : BC_INST_RET0);
 			bc_parse_push(p, inst);
+			bc_parse_optimize(p, 0);
 			bc_parse_updateFunc(p, BC_PROG_MAIN);
 			bc_vec_pop(&p->flags);
 		}
@@ -1122,6 +2037,8 @@ bc_parse_endif(BcParse* p)
 		}
 
 		vm->mode = (uchar) mode;
+
+		bc_parse_optimize(p, bc_parse_execIdx(p));
 	}
 	// If we reach here, a block was not properly closed, and we should error.
 	else bc_parse_err(&vm->prs, BC_ERR_PARSE_BLOCK);
@@ -1208,10 +2125,13 @@ bc_parse_while(BcParse* p)
 	if (BC_ERR(p->l.t != BC_LEX_LPAREN)) bc_parse_err(p, BC_ERR_PARSE_TOKEN);
 	bc_lex_next(&p->l);
 
-	// Create the labels. Loops need both.
+	// Create the labels. Loops need both, and the body label is for when the
+	// loop is rotated (see bc_parse_rotate()). It is set after the condition
+	// because inlined calls in the condition create labels of their own.
 	bc_parse_createCondLabel(p, p->func->labels.len);
 	idx = p->func->labels.len;
 	bc_parse_createExitLabel(p, idx, true);
+	bc_parse_createLabel(p, SIZE_MAX);
 
 	// Parse the actual condition and barf on non-right paren.
 	bc_parse_expr_status(p, flags, bc_parse_next_rel);
@@ -1221,6 +2141,7 @@ bc_parse_while(BcParse* p)
 	// Now we can push the conditional jump and start the body.
 	bc_parse_push(p, BC_INST_JUMP_ZERO);
 	bc_parse_pushIndex(p, idx);
+	*((size_t*) bc_vec_item(&p->func->labels, idx + 1)) = p->func->code.len;
 	bc_parse_startBody(p, BC_PARSE_FLAG_LOOP | BC_PARSE_FLAG_LOOP_INNER);
 }
 
@@ -1256,8 +2177,13 @@ bc_parse_for(BcParse* p)
 	body_idx = update_idx + 1;
 	exit_idx = body_idx + 1;
 
-	// This creates the condition label.
+	// This creates the condition label. The others are created now too, and
+	// set later, because inlined calls in the condition and update create
+	// labels of their own.
 	bc_parse_createLabel(p, p->func->code.len);
+	bc_parse_createLabel(p, SIZE_MAX);
+	bc_parse_createLabel(p, SIZE_MAX);
+	bc_parse_createExitLabel(p, exit_idx, true);
 
 	// Parse an expression if it exists.
 	if (p->l.t != BC_LEX_SCOLON)
@@ -1291,8 +2217,8 @@ bc_parse_for(BcParse* p)
 	bc_parse_push(p, BC_INST_JUMP);
 	bc_parse_pushIndex(p, body_idx);
 
-	// Now create the label for the update code.
-	bc_parse_createCondLabel(p, update_idx);
+	// Now set the label for the update code.
+	bc_parse_setCondLabel(p, update_idx);
 
 	// Parse if not empty, and if it is, let POSIX yell if necessary.
 	if (p->l.t != BC_LEX_RPAREN) bc_parse_expr_status(p, 0, bc_parse_next_rel);
@@ -1304,10 +2230,9 @@ bc_parse_for(BcParse* p)
 	// Set up a jump to the condition right after the update code.
 	bc_parse_push(p, BC_INST_JUMP);
 	bc_parse_pushIndex(p, cond_idx);
-	bc_parse_createLabel(p, p->func->code.len);
+	*((size_t*) bc_vec_item(&p->func->labels, body_idx)) = p->func->code.len;
 
-	// Create an exit label for the body and start the body.
-	bc_parse_createExitLabel(p, exit_idx, true);
+	// Start the body.
 	bc_lex_next(&p->l);
 	bc_parse_startBody(p, BC_PARSE_FLAG_LOOP | BC_PARSE_FLAG_LOOP_INNER);
 }
@@ -1369,7 +2294,7 @@ bc_parse_loopExit(BcParse* p, BcLexType type)
 static void
 bc_parse_func(BcParse* p)
 {
-	bool comma = false, voidfn;
+	bool comma = false, voidfn, memo;
 	uint16_t flags;
 	size_t idx;
 
@@ -1382,12 +2307,17 @@ bc_parse_func(BcParse* p)
 	voidfn = (!BC_IS_POSIX && p->l.t == BC_LEX_NAME &&
 	          !strcmp(p->l.str.v, "void"));
 
+	// The same goes for "memo" and memoized functions.
+	memo = (!BC_IS_POSIX && p->l.t == BC_LEX_NAME &&
+	        !strcmp(p->l.str.v, "memo"));
+
 	// We can safely do this because the expected token should not overwrite the
 	// function name.
 	bc_lex_next(&p->l);
 
 	// If we *don't* have another name, then void is the name of the function.
 	voidfn = (voidfn && p->l.t == BC_LEX_NAME);
+	memo = (memo && p->l.t == BC_LEX_NAME);
 
 	// With a void function, allow POSIX to complain and get a new token.
 	if (voidfn)
@@ -1398,12 +2328,13 @@ bc_parse_func(BcParse* p)
 		// the function name.
 		bc_lex_next(&p->l);
 	}
+	else if (memo) bc_lex_next(&p->l);
 
 	// Must have a left paren.
 	if (BC_ERR(p->l.t != BC_LEX_LPAREN)) bc_parse_err(p, BC_ERR_PARSE_FUNC);
 
 	// Make sure the functions map and vector are synchronized.
-	assert(p->prog->fns.len == p->prog->fn_map.len);
+	assert(p->prog->fns.len == p->prog->fn_map.ids.len);
 
 	// Insert the function by name into the map and vector.
 	idx = bc_program_insertFunc(p->prog, p->l.str.v);
@@ -1414,6 +2345,7 @@ bc_parse_func(BcParse* p)
 	// Update the function pointer and stuff in the parser and set its void.
 	bc_parse_updateFunc(p, idx);
 	p->func->voidfn = voidfn;
+	p->func->memo = memo;
 
 	bc_lex_next(&p->l);
 
@@ -1470,6 +2402,9 @@ bc_parse_func(BcParse* p)
 		comma = (p->l.t == BC_LEX_COMMA);
 		if (comma) bc_lex_next(&p->l);
 
+		// Calls with arrays are not memoized.
+		if (t != BC_TYPE_VAR) p->func->memo = false;
+
 		// Insert the parameter into the function.
 		bc_func_insert(p->func, p->prog, p->buf.v, t, p->l.line);
 	}
@@ -1610,6 +2545,27 @@ bc_parse_body(BcParse* p, bool brace)
 	}
 }
 
+void
+bc_parse_limits(void)
+{
+	bc_vm_printf("BC_LONG_BIT      = %lu\n", (ulong) BC_LONG_BIT);
+	bc_vm_printf("BC_BASE_DIGS     = %lu\n", (ulong) BC_BASE_DIGS);
+	bc_vm_printf("BC_BASE_POW      = %lu\n", (ulong) BC_BASE_POW);
+	bc_vm_printf("BC_OVERFLOW_MAX  = %lu\n", (ulong) BC_NUM_BIGDIG_MAX);
+	bc_vm_printf("\n");
+	bc_vm_printf("BC_BASE_MAX      = %lu\n", BC_MAX_OBASE);
+	bc_vm_printf("BC_DIM_MAX       = %lu\n", BC_MAX_DIM);
+	bc_vm_printf("BC_SCALE_MAX     = %lu\n", BC_MAX_SCALE);
+	bc_vm_printf("BC_STRING_MAX    = %lu\n", BC_MAX_STRING);
+	bc_vm_printf("BC_NAME_MAX      = %lu\n", BC_MAX_NAME);
+	bc_vm_printf("BC_NUM_MAX       = %lu\n", BC_MAX_NUM);
+#if BC_ENABLE_EXTRA_MATH
+	bc_vm_printf("BC_RAND_MAX      = %lu\n", BC_MAX_RAND);
+#endif // BC_ENABLE_EXTRA_MATH
+	bc_vm_printf("MAX Exponent     = %lu\n", BC_MAX_EXP);
+	bc_vm_printf("Number of vars   = %lu\n", BC_MAX_VARS);
+}
+
 /**
  * Parses a statement. This is the entry point for just about everything, except
  * function definitions.
@@ -1714,12 +2670,16 @@ bc_parse_stmt(BcParse* p)
 		case BC_LEX_KW_ABS:
 		case BC_LEX_KW_IS_NUMBER:
 		case BC_LEX_KW_IS_STRING:
+		case BC_LEX_KW_IS_PRIME:
+		case BC_LEX_KW_NEXT_PRIME:
 #if BC_ENABLE_EXTRA_MATH
 		case BC_LEX_KW_IRAND:
 #endif // BC_ENABLE_EXTRA_MATH
 		case BC_LEX_KW_ASCIIFY:
 		case BC_LEX_KW_MODEXP:
 		case BC_LEX_KW_DIVMOD:
+		case BC_LEX_KW_MODINV:
+		case BC_LEX_KW_EGCD:
 		case BC_LEX_KW_READ:
 #if BC_ENABLE_EXTRA_MATH
 		case BC_LEX_KW_RAND:
@@ -1791,23 +2751,13 @@ bc_parse_stmt(BcParse* p)
 
 		case BC_LEX_KW_LIMITS:
 		{
-			// `limits` is a compile-time command, so execute it right away.
-			bc_vm_printf("BC_LONG_BIT      = %lu\n", (ulong) BC_LONG_BIT);
-			bc_vm_printf("BC_BASE_DIGS     = %lu\n", (ulong) BC_BASE_DIGS);
-			bc_vm_printf("BC_BASE_POW      = %lu\n", (ulong) BC_BASE_POW);
-			bc_vm_printf("BC_OVERFLOW_MAX  = %lu\n", (ulong) BC_NUM_BIGDIG_MAX);
-			bc_vm_printf("\n");
-			bc_vm_printf("BC_BASE_MAX      = %lu\n", BC_MAX_OBASE);
-			bc_vm_printf("BC_DIM_MAX       = %lu\n", BC_MAX_DIM);
-			bc_vm_printf("BC_SCALE_MAX     = %lu\n", BC_MAX_SCALE);
-			bc_vm_printf("BC_STRING_MAX    = %lu\n", BC_MAX_STRING);
-			bc_vm_printf("BC_NAME_MAX      = %lu\n", BC_MAX_NAME);
-			bc_vm_printf("BC_NUM_MAX       = %lu\n", BC_MAX_NUM);
-#if BC_ENABLE_EXTRA_MATH
-			bc_vm_printf("BC_RAND_MAX      = %lu\n", BC_MAX_RAND);
-#endif // BC_ENABLE_EXTRA_MATH
-			bc_vm_printf("MAX Exponent     = %lu\n", BC_MAX_EXP);
-			bc_vm_printf("Number of vars   = %lu\n", BC_MAX_VARS);
+			// `limits` is a compile-time command, so execute it right away,
+			// unless bc is compiling a bytecode cache. Then the cache does it.
+			if (vm->compile != NULL)
+			{
+				bc_cache_event(&vm->cache, BC_CACHE_LIMITS);
+			}
+			else bc_parse_limits();
 
 			bc_lex_next(&p->l);
 
@@ -1971,6 +2921,10 @@ bc_parse_parse(BcParse* p)
 	// Otherwise, parse a normal statement.
 	else bc_parse_stmt(p);
 
+	// If the statement can be executed, optimize everything that has not been
+	// executed yet.
+	if (!BC_PARSE_NO_EXEC(p)) bc_parse_optimize(p, bc_parse_execIdx(p));
+
 exit:
 
 	// We need to reset on error.
@@ -1983,6 +2937,22 @@ exit:
 	BC_SIG_MAYLOCK;
 }
 
+void
+bc_parse_define(BcParse* p)
+{
+	BC_SIG_ASSERT_LOCKED;
+
+	assert(p->l.t == BC_LEX_KW_DEFINE && !BC_PARSE_NO_EXEC(p));
+
+	bc_parse_func(p);
+
+	// The body is done when the parser is back in main.
+	while (BC_PARSE_NO_EXEC(p))
+	{
+		bc_parse_stmt(p);
+	}
+}
+
 /**
  * Parse an expression. This is the actual implementation of the Shunting-Yard
  * Algorithm.
@@ -2337,6 +3307,8 @@ bc_parse_expr_err(BcParse* p, uint8_t flags, BcParseNext next)
 			case BC_LEX_KW_ABS:
 			case BC_LEX_KW_IS_NUMBER:
 			case BC_LEX_KW_IS_STRING:
+			case BC_LEX_KW_IS_PRIME:
+			case BC_LEX_KW_NEXT_PRIME:
 #if BC_ENABLE_EXTRA_MATH
 			case BC_LEX_KW_IRAND:
 #endif // BC_ENABLE_EXTRA_MATH
@@ -2414,6 +3386,8 @@ bc_parse_expr_err(BcParse* p, uint8_t flags, BcParseNext next)
 
 			case BC_LEX_KW_MODEXP:
 			case BC_LEX_KW_DIVMOD:
+			case BC_LEX_KW_MODINV:
+			case BC_LEX_KW_EGCD:
 			{
 				// This is a leaf and cannot come right after a leaf.
 				if (BC_ERR(BC_PARSE_LEAF(prev, bin_last, rprn)))
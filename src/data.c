@@ -160,6 +160,8 @@ const BcOptLong bc_args_lopt[] = {
 #if BC_ENABLED
 	{ "global-stacks", BC_OPT_BC_ONLY, 'g' },
 	{ "mathlib", BC_OPT_BC_ONLY, 'l' },
+	{ "no-optimize", BC_OPT_BC_ONLY, 'N' },
+	{ "compile", BC_OPT_REQUIRED_BC_ONLY, 'o' },
 	{ "quiet", BC_OPT_BC_ONLY, 'q' },
 	{ "redefine", BC_OPT_REQUIRED_BC_ONLY, 'r' },
 	{ "standard", BC_OPT_BC_ONLY, 's' },
@@ -774,6 +776,8 @@ const char* bc_inst_names[] = {
 	"BC_INST_ABS",
 	"BC_INST_IS_NUMBER",
 	"BC_INST_IS_STRING",
+	"BC_INST_IS_PRIME",
+	"BC_INST_NEXT_PRIME",
 #if BC_ENABLE_EXTRA_MATH
 	"BC_INST_IRAND",
 #endif // BC_ENABLE_EXTRA_MATH
@@ -789,6 +793,12 @@ const char* bc_inst_names[] = {
 	"BC_INST_MAXRAND",
 #endif // BC_ENABLE_EXTRA_MATH
 
+	"BC_INST_LINE_LENGTH",
+#if BC_ENABLED
+	"BC_INST_GLOBAL_STACKS",
+#endif // BC_ENABLED
+	"BC_INST_LEADING_ZERO",
+
 	"BC_INST_PRINT",
 	"BC_INST_PRINT_POP",
 	"BC_INST_STR",
@@ -805,15 +815,25 @@ const char* bc_inst_names[] = {
 	"BC_INST_RET_VOID",
 
 	"BC_INST_HALT",
+	"BC_INST_VAR_OP_CONST",
+	"BC_INST_ARRAY_OP_CONST",
+	"BC_INST_REL_JUMP_ZERO",
+	"BC_INST_VAR_ASSIGN_REGS",
+	"BC_INST_VAR_ADDMUL",
+	"BC_INST_TAIL_CALL",
+	"BC_INST_INLINE",
 #endif // BC_ENABLED
 
 	"BC_INST_POP",
 	"BC_INST_SWAP",
 	"BC_INST_MODEXP",
 	"BC_INST_DIVMOD",
+	"BC_INST_MODINV",
+	"BC_INST_EGCD",
 	"BC_INST_PRINT_STREAM",
 
 #if DC_ENABLED
+	"BC_INST_EXTENDED_REGISTERS",
 	"BC_INST_POP_EXEC",
 
 	"BC_INST_EXECUTE",
@@ -873,12 +893,16 @@ const BcLexKeyword bc_lex_kws[] = {
 	BC_LEX_KW_ENTRY("abs", 3, 0),
 	BC_LEX_KW_ENTRY("is_number", 9, 0),
 	BC_LEX_KW_ENTRY("is_string", 9, 0),
+	BC_LEX_KW_ENTRY("is_prime", 8, 0),
+	BC_LEX_KW_ENTRY("next_prime", 10, 0),
 #if BC_ENABLE_EXTRA_MATH
 	BC_LEX_KW_ENTRY("irand", 5, 0),
 #endif // BC_ENABLE_EXTRA_MATH
 	BC_LEX_KW_ENTRY("asciify", 7, 0),
 	BC_LEX_KW_ENTRY("modexp", 6, 0),
 	BC_LEX_KW_ENTRY("divmod", 6, 0),
+	BC_LEX_KW_ENTRY("modinv", 6, 0),
+	BC_LEX_KW_ENTRY("egcd", 4, 0),
 	BC_LEX_KW_ENTRY("quit", 4, 1),
 	BC_LEX_KW_ENTRY("read", 4, 0),
 #if BC_ENABLE_EXTRA_MATH
@@ -947,11 +971,11 @@ const uint8_t bc_parse_exprs[] = {
 	// Starts with BC_LEX_KW_SQRT.
 	BC_PARSE_EXPR_ENTRY(1, 1, 1, 1, 1, 1, 1, 1),
 
-	// Starts with BC_LEX_KW_QUIT.
-	BC_PARSE_EXPR_ENTRY(0, 1, 1, 1, 1, 1, 1, 1),
+	// Starts with BC_LEX_KW_MODEXP.
+	BC_PARSE_EXPR_ENTRY(1, 1, 1, 1, 0, 1, 1, 1),
 
-	// Starts with BC_LEX_KW_GLOBAL_STACKS.
-	BC_PARSE_EXPR_ENTRY(1, 1, 0, 0, 0, 0, 0, 0)
+	// Starts with BC_LEX_KW_MAXOBASE.
+	BC_PARSE_EXPR_ENTRY(1, 1, 1, 1, 1, 1, 0, 0)
 
 #else // BC_ENABLE_EXTRA_MATH
 
@@ -968,13 +992,13 @@ const uint8_t bc_parse_exprs[] = {
 	BC_PARSE_EXPR_ENTRY(0, 0, 1, 1, 1, 1, 1, 0),
 
 	// Starts with BC_LEX_KW_SQRT.
-	BC_PARSE_EXPR_ENTRY(1, 1, 1, 1, 1, 1, 1, 0),
+	BC_PARSE_EXPR_ENTRY(1, 1, 1, 1, 1, 1, 1, 1),
 
-	// Starts with BC_LEX_KW_MAXIBASE.
-	BC_PARSE_EXPR_ENTRY(1, 1, 1, 1, 1, 1, 1, 0),
+	// Starts with BC_LEX_KW_DIVMOD.
+	BC_PARSE_EXPR_ENTRY(1, 1, 1, 0, 1, 1, 1, 1),
 
-	// Starts with  BC_LEX_KW_ELSE.
-	BC_PARSE_EXPR_ENTRY(0, 0, 0, 0, 0, 0, 0, 0)
+	// Starts with BC_LEX_KW_LINE_LENGTH.
+	BC_PARSE_EXPR_ENTRY(1, 1, 1, 0, 0, 0, 0, 0)
 
 #endif // BC_ENABLE_EXTRA_MATH
 };
@@ -1003,6 +1027,24 @@ const uchar bc_parse_ops[] = {
 	BC_PARSE_OP(8, 0),
 };
 
+/// The operators that bc_parse_optimize() can fold, as strings, in the order of
+/// their instructions, starting at BC_INST_POWER. These are used to build the
+/// names of folded constants.
+const char* const bc_parse_fold_ops[] = {
+	"^", "*", "/", "%", "+", "-",
+#if BC_ENABLE_EXTRA_MATH
+	"@", "<<", ">>",
+#endif // BC_ENABLE_EXTRA_MATH
+};
+
+/// The complements of the relational operators, in the order of their
+/// instructions, starting at BC_INST_REL_EQ. These are used to negate the
+/// conditions of rotated loops.
+const uchar bc_parse_rel_nots[] = {
+	BC_INST_REL_NE, BC_INST_REL_GT, BC_INST_REL_LT,
+	BC_INST_REL_EQ, BC_INST_REL_GE, BC_INST_REL_LE,
+};
+
 // These identify what tokens can come after expressions in certain cases.
 
 /// The valid next tokens for normal expressions.
@@ -1077,7 +1119,7 @@ const uchar dc_lex_tokens[] = {
 	BC_LEX_INVALID,
 #endif // BC_ENABLE_EXTRA_MATH
 	BC_LEX_OP_MODULUS,
-	BC_LEX_INVALID,
+	BC_LEX_KW_MODINV,
 #if BC_ENABLE_EXTRA_MATH
 	BC_LEX_KW_RAND,
 #else // BC_ENABLE_EXTRA_MATH
@@ -1253,11 +1295,13 @@ const uchar dc_parse_insts[] = {
 	BC_INST_LENGTH,       BC_INST_PRINT,
 	BC_INST_SQRT,         BC_INST_ABS,
 	BC_INST_IS_NUMBER,    BC_INST_IS_STRING,
+	BC_INST_INVALID,      BC_INST_INVALID,
 #if BC_ENABLE_EXTRA_MATH
 	BC_INST_IRAND,
 #endif // BC_ENABLE_EXTRA_MATH
 	BC_INST_ASCIIFY,      BC_INST_MODEXP,
-	BC_INST_DIVMOD,       BC_INST_QUIT,
+	BC_INST_DIVMOD,       BC_INST_MODINV,
+	BC_INST_INVALID,      BC_INST_QUIT,
 	BC_INST_INVALID,
 #if BC_ENABLE_EXTRA_MATH
 	BC_INST_RAND,
@@ -1319,6 +1363,13 @@ const BcDig bc_num_bigdigMax2[] = {
 	340U,
 };
 
+/// A constant array for the deterministic Miller-Rabin bound as a BcDig array.
+const BcDig bc_num_mrBound[] = {
+	385961981U,
+	64679887U,
+	3317044U,
+};
+
 #else // BC_LONG_BIT >= 64
 
 /// A constant array for the max of a bigdig number as a BcDig array.
@@ -1337,6 +1388,17 @@ const BcDig bc_num_bigdigMax2[] = {
 	1844U,
 };
 
+/// A constant array for the deterministic Miller-Rabin bound as a BcDig array.
+const BcDig bc_num_mrBound[] = {
+	1981U,
+	8596U,
+	8873U,
+	4679U,
+	4406U,
+	3170U,
+	3U,
+};
+
 #endif // BC_LONG_BIT >= 64
 
 // clang-format on
@@ -1347,6 +1409,21 @@ const size_t bc_num_bigdigMax_size = sizeof(bc_num_bigdigMax) / sizeof(BcDig);
 /// The size of the bigdig max times 2 array.
 const size_t bc_num_bigdigMax2_size = sizeof(bc_num_bigdigMax2) / sizeof(BcDig);
 
+/// The size of the Miller-Rabin bound array.
+const size_t bc_num_mrBound_size = sizeof(bc_num_mrBound) / sizeof(BcDig);
+
+// clang-format off
+
+/// The primes less than 256.
+const uchar bc_num_primes[BC_NUM_NPRIMES] = {
+	2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67, 71,
+	73, 79, 83, 89, 97, 101, 103, 107, 109, 113, 127, 131, 137, 139, 149, 151,
+	157, 163, 167, 173, 179, 181, 191, 193, 197, 199, 211, 223, 227, 229, 233,
+	239, 241, 251,
+};
+
+// clang-format on
+
 /// A string of digits for easy conversion from characters to digits.
 const char bc_num_hex_digits[] = "0123456789ABCDEF";
 
@@ -1370,8 +1447,6 @@ const BcBigDig bc_num_pow10[BC_BASE_DIGS + 1] = {
 
 // clang-format on
 
-#if !BC_ENABLE_LIBRARY
-
 /// An array of functions for binary operators corresponding to the order of
 /// the instructions for the operators.
 const BcNumBinaryOp bc_program_ops[] = {
@@ -1392,6 +1467,8 @@ const BcNumBinaryOpReq bc_program_opReqs[] = {
 #endif // BC_ENABLE_EXTRA_MATH
 };
 
+#if !BC_ENABLE_LIBRARY
+
 /// An array of unary operator functions corresponding to the order of the
 /// instructions.
 const BcProgramUnary bc_program_unarys[] = {
@@ -326,12 +326,16 @@ dc_parse_token(BcParse* p, BcLexType t, uint8_t flags)
 		case BC_LEX_KW_ABS:
 		case BC_LEX_KW_IS_NUMBER:
 		case BC_LEX_KW_IS_STRING:
+		case BC_LEX_KW_IS_PRIME:
+		case BC_LEX_KW_NEXT_PRIME:
 #if BC_ENABLE_EXTRA_MATH
 		case BC_LEX_KW_IRAND:
 #endif // BC_ENABLE_EXTRA_MATH
 		case BC_LEX_KW_ASCIIFY:
 		case BC_LEX_KW_MODEXP:
 		case BC_LEX_KW_DIVMOD:
+		case BC_LEX_KW_MODINV:
+		case BC_LEX_KW_EGCD:
 		case BC_LEX_KW_QUIT:
 #if BC_ENABLE_EXTRA_MATH
 		case BC_LEX_KW_RAND:
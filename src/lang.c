@@ -110,6 +110,9 @@ bc_func_init(BcFunc* f, const char* name)
 
 		f->nparams = 0;
 		f->voidfn = false;
+		f->memo = false;
+		f->version = 0;
+		f->lib = NULL;
 	}
 
 #endif // BC_ENABLED
@@ -133,6 +136,9 @@ bc_func_reset(BcFunc* f)
 
 		f->nparams = 0;
 		f->voidfn = false;
+		f->memo = false;
+		f->version += 1;
+		f->lib = NULL;
 	}
 #endif // BC_ENABLED
 }
@@ -286,6 +292,7 @@ bc_result_copy(BcResult* d, BcResult* src)
 		case BC_RESULT_VAR:
 		case BC_RESULT_ARRAY:
 		case BC_RESULT_ARRAY_ELEM:
+		case BC_RESULT_CONST:
 		{
 			// NOLINTNEXTLINE
 			memcpy(&d->d.loc, &src->d.loc, sizeof(BcLoc));
@@ -347,6 +354,7 @@ bc_result_free(void* result)
 		case BC_RESULT_ARRAY:
 		case BC_RESULT_ARRAY_ELEM:
 		case BC_RESULT_STR:
+		case BC_RESULT_CONST:
 		case BC_RESULT_ZERO:
 		case BC_RESULT_ONE:
 #if BC_ENABLED
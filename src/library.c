@@ -35,6 +35,7 @@
 
 #if BC_ENABLE_LIBRARY
 
+#include <ctype.h>
 #include <setjmp.h>
 #include <string.h>
 #include <time.h>
@@ -293,6 +294,7 @@ bcl_free(void)
 	bc_rand_free(&vm->rng);
 #endif // BC_ENABLE_EXTRA_MATH
 	bc_vec_free(&vm->out);
+	bc_vm_freeRecips();
 
 	for (i = 0; i < vm->ctxts.len; ++i)
 	{
@@ -329,6 +331,7 @@ bcl_end(void)
 void
 bcl_gc(void)
 {
+	bc_vm_freeRecips();
 	bc_vm_freeTemps();
 }
 
@@ -398,6 +401,7 @@ bcl_ctxt_create(void)
 	ctxt->scale = 0;
 	ctxt->ibase = 10;
 	ctxt->obase = 10;
+	ctxt->vm = vm;
 
 err:
 
@@ -467,10 +471,9 @@ bcl_ctxt_setObase(BclContext ctxt, size_t obase)
 }
 
 BclError
-bcl_err(BclNumber n)
+bcl_ctxt_err(BclContext ctxt, BclNumber n)
 {
-	BclContext ctxt;
-	BcVm* vm = bcl_getspecific();
+	BcVm* vm;
 
 	BC_CHECK_CTXT_ERR(vm, ctxt);
 
@@ -488,6 +491,12 @@ bcl_err(BclNumber n)
 	else return BCL_ERROR_NONE;
 }
 
+BclError
+bcl_err(BclNumber n)
+{
+	return bcl_ctxt_err(NULL, n);
+}
+
 /**
  * Inserts a BcNum into a context's list of numbers.
  * @param ctxt  The context to insert into.
@@ -542,13 +551,12 @@ bcl_num_insert(BclContext ctxt, BclNum* restrict n)
 }
 
 BclNumber
-bcl_num_create(void)
+bcl_ctxt_num_create(BclContext ctxt)
 {
 	BclError e = BCL_ERROR_NONE;
 	BclNum n;
 	BclNumber idx;
-	BclContext ctxt;
-	BcVm* vm = bcl_getspecific();
+	BcVm* vm;
 
 	BC_CHECK_CTXT(vm, ctxt);
 
@@ -566,6 +574,12 @@ err:
 	return idx;
 }
 
+BclNumber
+bcl_num_create(void)
+{
+	return bcl_ctxt_num_create(NULL);
+}
+
 /**
  * Destructs a number and marks its spot as free.
  * @param ctxt  The context.
@@ -588,11 +602,10 @@ bcl_num_dtor(BclContext ctxt, BclNumber n, BclNum* restrict num)
 }
 
 void
-bcl_num_free(BclNumber n)
+bcl_ctxt_num_free(BclContext ctxt, BclNumber n)
 {
 	BclNum* num;
-	BclContext ctxt;
-	BcVm* vm = bcl_getspecific();
+	BcVm* vm;
 
 	BC_CHECK_CTXT_ASSERT(vm, ctxt);
 
@@ -605,20 +618,31 @@ bcl_num_free(BclNumber n)
 	bcl_num_dtor(ctxt, n, num);
 }
 
+void
+bcl_num_free(BclNumber n)
+{
+	bcl_ctxt_num_free(NULL, n);
+}
+
 BclError
-bcl_copy(BclNumber d, BclNumber s)
+bcl_ctxt_copy(BclContext ctxt, BclNumber d, BclNumber s)
 {
 	BclError e = BCL_ERROR_NONE;
 	BclNum* dest;
 	BclNum* src;
-	BclContext ctxt;
-	BcVm* vm = bcl_getspecific();
+	BcVm* vm;
 
 	BC_CHECK_CTXT_ERR(vm, ctxt);
 
 	BCL_CHECK_NUM_VALID(ctxt, d);
 	BCL_CHECK_NUM_VALID(ctxt, s);
 
+	// Shared numbers are read-only.
+	if (BC_ERR(BCL_IS_SHARED(BCL_NUM_NUM(BCL_NUM(ctxt, d)))))
+	{
+		return BCL_ERROR_INVALID_NUM;
+	}
+
 	BC_FUNC_HEADER(vm, err);
 
 	assert(BCL_NO_GEN(d) < ctxt->nums.len);
@@ -639,14 +663,19 @@ err:
 	return e;
 }
 
+BclError
+bcl_copy(BclNumber d, BclNumber s)
+{
+	return bcl_ctxt_copy(NULL, d, s);
+}
+
 BclNumber
-bcl_dup(BclNumber s)
+bcl_ctxt_dup(BclContext ctxt, BclNumber s)
 {
 	BclError e = BCL_ERROR_NONE;
 	BclNum *src, dest;
 	BclNumber idx;
-	BclContext ctxt;
-	BcVm* vm = bcl_getspecific();
+	BcVm* vm;
 
 	BC_CHECK_CTXT(vm, ctxt);
 
@@ -674,6 +703,12 @@ err:
 	return idx;
 }
 
+BclNumber
+bcl_dup(BclNumber s)
+{
+	return bcl_ctxt_dup(NULL, s);
+}
+
 void
 bcl_num_destruct(void* num)
 {
@@ -683,16 +718,21 @@ bcl_num_destruct(void* num)
 
 	if (BCL_NUM_ARRAY(n) == NULL) return;
 
-	bc_num_free(BCL_NUM_NUM(n));
+	// A view of a shared number only has a reference to give up.
+	if (BCL_IS_SHARED(BCL_NUM_NUM(n)))
+	{
+		bcl_shared_free(BCL_SHARED(BCL_NUM_NUM(n)));
+	}
+	else bc_num_free(BCL_NUM_NUM(n));
+
 	bc_num_clear(BCL_NUM_NUM(n));
 }
 
 bool
-bcl_num_neg(BclNumber n)
+bcl_ctxt_num_neg(BclContext ctxt, BclNumber n)
 {
 	BclNum* num;
-	BclContext ctxt;
-	BcVm* vm = bcl_getspecific();
+	BcVm* vm;
 
 	BC_CHECK_CTXT_ASSERT(vm, ctxt);
 
@@ -707,12 +747,17 @@ bcl_num_neg(BclNumber n)
 	return BC_NUM_NEG(BCL_NUM_NUM(num)) != 0;
 }
 
+bool
+bcl_num_neg(BclNumber n)
+{
+	return bcl_ctxt_num_neg(NULL, n);
+}
+
 void
-bcl_num_setNeg(BclNumber n, bool neg)
+bcl_ctxt_num_setNeg(BclContext ctxt, BclNumber n, bool neg)
 {
 	BclNum* num;
-	BclContext ctxt;
-	BcVm* vm = bcl_getspecific();
+	BcVm* vm;
 
 	BC_CHECK_CTXT_ASSERT(vm, ctxt);
 
@@ -727,12 +772,17 @@ bcl_num_setNeg(BclNumber n, bool neg)
 	BCL_NUM_NUM(num)->rdx = BC_NUM_NEG_VAL(BCL_NUM_NUM(num), neg);
 }
 
+void
+bcl_num_setNeg(BclNumber n, bool neg)
+{
+	bcl_ctxt_num_setNeg(NULL, n, neg);
+}
+
 size_t
-bcl_num_scale(BclNumber n)
+bcl_ctxt_num_scale(BclContext ctxt, BclNumber n)
 {
 	BclNum* num;
-	BclContext ctxt;
-	BcVm* vm = bcl_getspecific();
+	BcVm* vm;
 
 	BC_CHECK_CTXT_ASSERT(vm, ctxt);
 
@@ -747,13 +797,18 @@ bcl_num_scale(BclNumber n)
 	return bc_num_scale(BCL_NUM_NUM(num));
 }
 
+size_t
+bcl_num_scale(BclNumber n)
+{
+	return bcl_ctxt_num_scale(NULL, n);
+}
+
 BclError
-bcl_num_setScale(BclNumber n, size_t scale)
+bcl_ctxt_num_setScale(BclContext ctxt, BclNumber n, size_t scale)
 {
 	BclError e = BCL_ERROR_NONE;
 	BclNum* nptr;
-	BclContext ctxt;
-	BcVm* vm = bcl_getspecific();
+	BcVm* vm;
 
 	BC_CHECK_CTXT_ERR(vm, ctxt);
 
@@ -761,14 +816,17 @@ bcl_num_setScale(BclNumber n, size_t scale)
 
 	BCL_CHECK_NUM_VALID(ctxt, n);
 
-	BC_FUNC_HEADER(vm, err);
-
 	assert(BCL_NO_GEN(n) < ctxt->nums.len);
 
 	nptr = BCL_NUM(ctxt, n);
 
 	assert(nptr != NULL && BCL_NUM_ARRAY(nptr) != NULL);
 
+	// Shared numbers are read-only.
+	if (BC_ERR(BCL_IS_SHARED(BCL_NUM_NUM(nptr)))) return BCL_ERROR_INVALID_NUM;
+
+	BC_FUNC_HEADER(vm, err);
+
 	if (scale > BCL_NUM_NUM(nptr)->scale)
 	{
 		bc_num_extend(BCL_NUM_NUM(nptr), scale - BCL_NUM_NUM(nptr)->scale);
@@ -785,12 +843,17 @@ err:
 	return e;
 }
 
+BclError
+bcl_num_setScale(BclNumber n, size_t scale)
+{
+	return bcl_ctxt_num_setScale(NULL, n, scale);
+}
+
 size_t
-bcl_num_len(BclNumber n)
+bcl_ctxt_num_len(BclContext ctxt, BclNumber n)
 {
 	BclNum* num;
-	BclContext ctxt;
-	BcVm* vm = bcl_getspecific();
+	BcVm* vm;
 
 	BC_CHECK_CTXT_ASSERT(vm, ctxt);
 
@@ -805,13 +868,19 @@ bcl_num_len(BclNumber n)
 	return bc_num_len(BCL_NUM_NUM(num));
 }
 
+size_t
+bcl_num_len(BclNumber n)
+{
+	return bcl_ctxt_num_len(NULL, n);
+}
+
 static BclError
-bcl_bigdig_helper(BclNumber n, BclBigDig* result, bool destruct)
+bcl_bigdig_helper(BclContext ctxt, BclNumber n, BclBigDig* result,
+                  bool destruct)
 {
 	BclError e = BCL_ERROR_NONE;
 	BclNum* num;
-	BclContext ctxt;
-	BcVm* vm = bcl_getspecific();
+	BcVm* vm;
 
 	BC_CHECK_CTXT_ERR(vm, ctxt);
 
@@ -843,23 +912,34 @@ err:
 BclError
 bcl_bigdig(BclNumber n, BclBigDig* result)
 {
-	return bcl_bigdig_helper(n, result, true);
+	return bcl_bigdig_helper(NULL, n, result, true);
+}
+
+BclError
+bcl_ctxt_bigdig(BclContext ctxt, BclNumber n, BclBigDig* result)
+{
+	return bcl_bigdig_helper(ctxt, n, result, true);
 }
 
 BclError
 bcl_bigdig_keep(BclNumber n, BclBigDig* result)
 {
-	return bcl_bigdig_helper(n, result, false);
+	return bcl_bigdig_helper(NULL, n, result, false);
+}
+
+BclError
+bcl_ctxt_bigdig_keep(BclContext ctxt, BclNumber n, BclBigDig* result)
+{
+	return bcl_bigdig_helper(ctxt, n, result, false);
 }
 
 BclNumber
-bcl_bigdig2num(BclBigDig val)
+bcl_ctxt_bigdig2num(BclContext ctxt, BclBigDig val)
 {
 	BclError e = BCL_ERROR_NONE;
 	BclNum n;
 	BclNumber idx;
-	BclContext ctxt;
-	BcVm* vm = bcl_getspecific();
+	BcVm* vm;
 
 	BC_CHECK_CTXT(vm, ctxt);
 
@@ -877,345 +957,346 @@ err:
 	return idx;
 }
 
+BclNumber
+bcl_bigdig2num(BclBigDig val)
+{
+	return bcl_ctxt_bigdig2num(NULL, val);
+}
+
 /**
- * Sets up and executes a binary operator operation.
- * @param a         The first operand.
- * @param b         The second operand.
- * @param op        The operation.
- * @param req       The function to get the size of the result for
- *                  preallocation.
- * @param destruct  True if the parameters should be consumed, false otherwise.
- * @return          The result of the operation.
+ * Exports a number as BclLimb's.
+ * @param ctxt      The context, or NULL for the current context.
+ * @param n         The number to export.
+ * @param ipart     The array for the integer part.
+ * @param ilen      An in/out parameter for the number of limbs in @a ipart.
+ * @param fpart     The array for the fractional part.
+ * @param flen      An in/out parameter for the number of limbs in @a fpart.
+ * @param destruct  True if the number should be consumed, false otherwise.
+ * @return          An error code.
  */
-static BclNumber
-bcl_binary(BclNumber a, BclNumber b, const BcNumBinaryOp op,
-           const BcNumBinaryOpReq req, bool destruct)
+static BclError
+bcl_limbs_helper(BclContext ctxt, BclNumber n, BclLimb* ipart, size_t* ilen,
+                 BclLimb* fpart, size_t* flen, bool destruct)
 {
 	BclError e = BCL_ERROR_NONE;
-	BclNum* aptr;
-	BclNum* bptr;
-	BclNum c;
-	BclNumber idx;
-	BclContext ctxt;
-	BcVm* vm = bcl_getspecific();
+	BclNum* num;
+	BcVm* vm;
+	size_t il, fl;
 
-	BC_CHECK_CTXT(vm, ctxt);
+	BC_CHECK_CTXT_ERR(vm, ctxt);
 
-	BC_CHECK_NUM(ctxt, a);
-	BC_CHECK_NUM(ctxt, b);
+	BCL_CHECK_NUM_VALID(ctxt, n);
 
 	BC_FUNC_HEADER(vm, err);
 
-	BCL_GROW_NUMS(ctxt);
+	assert(BCL_NO_GEN(n) < ctxt->nums.len);
+	assert(ilen != NULL && flen != NULL);
 
-	assert(BCL_NO_GEN(a) < ctxt->nums.len && BCL_NO_GEN(b) < ctxt->nums.len);
+	num = BCL_NUM(ctxt, n);
 
-	aptr = BCL_NUM(ctxt, a);
-	bptr = BCL_NUM(ctxt, b);
+	assert(num != NULL && BCL_NUM_ARRAY(num) != NULL);
 
-	assert(aptr != NULL && bptr != NULL);
-	assert(BCL_NUM_ARRAY(aptr) != NULL && BCL_NUM_ARRAY(bptr) != NULL);
+	bc_num_limbsLen(BCL_NUM_NUM(num), &il, &fl);
 
-	// Clear and initialize the result.
-	bc_num_clear(BCL_NUM_NUM_NP(c));
-	bc_num_init(BCL_NUM_NUM_NP(c),
-	            req(BCL_NUM_NUM(aptr), BCL_NUM_NUM(bptr), ctxt->scale));
+	// If the arrays are too small, just tell the caller how big they need to
+	// be.
+	if (BC_ERR(il > *ilen || fl > *flen)) vm->err = BCL_ERROR_MATH_OVERFLOW;
+	else bc_num_toLimbs(BCL_NUM_NUM(num), ipart, fpart);
 
-	op(BCL_NUM_NUM(aptr), BCL_NUM_NUM(bptr), BCL_NUM_NUM_NP(c), ctxt->scale);
+	*ilen = il;
+	*flen = fl;
 
 err:
 
 	if (destruct)
 	{
-		// Eat the operands.
-		bcl_num_dtor(ctxt, a, aptr);
-		if (b.i != a.i) bcl_num_dtor(ctxt, b, bptr);
+		bcl_num_dtor(ctxt, n, num);
 	}
 
 	BC_FUNC_FOOTER(vm, e);
-	BC_MAYBE_SETUP(ctxt, e, c, idx);
 
-	return idx;
+	return e;
 }
 
-BclNumber
-bcl_add(BclNumber a, BclNumber b)
+BclError
+bcl_limbs(BclNumber n, BclLimb* ipart, size_t* ilen, BclLimb* fpart,
+          size_t* flen)
 {
-	return bcl_binary(a, b, bc_num_add, bc_num_addReq, true);
+	return bcl_limbs_helper(NULL, n, ipart, ilen, fpart, flen, true);
 }
 
-BclNumber
-bcl_add_keep(BclNumber a, BclNumber b)
+BclError
+bcl_ctxt_limbs(BclContext ctxt, BclNumber n, BclLimb* ipart, size_t* ilen,
+               BclLimb* fpart, size_t* flen)
 {
-	return bcl_binary(a, b, bc_num_add, bc_num_addReq, false);
+	return bcl_limbs_helper(ctxt, n, ipart, ilen, fpart, flen, true);
 }
 
-BclNumber
-bcl_sub(BclNumber a, BclNumber b)
+BclError
+bcl_limbs_keep(BclNumber n, BclLimb* ipart, size_t* ilen, BclLimb* fpart,
+               size_t* flen)
 {
-	return bcl_binary(a, b, bc_num_sub, bc_num_addReq, true);
+	return bcl_limbs_helper(NULL, n, ipart, ilen, fpart, flen, false);
 }
 
-BclNumber
-bcl_sub_keep(BclNumber a, BclNumber b)
+BclError
+bcl_ctxt_limbs_keep(BclContext ctxt, BclNumber n, BclLimb* ipart,
+                    size_t* ilen, BclLimb* fpart, size_t* flen)
 {
-	return bcl_binary(a, b, bc_num_sub, bc_num_addReq, false);
+	return bcl_limbs_helper(ctxt, n, ipart, ilen, fpart, flen, false);
 }
 
 BclNumber
-bcl_mul(BclNumber a, BclNumber b)
+bcl_ctxt_limbs2num(BclContext ctxt, const BclLimb* ipart, size_t ilen,
+                   const BclLimb* fpart, size_t scale, bool neg)
 {
-	return bcl_binary(a, b, bc_num_mul, bc_num_mulReq, true);
-}
+	BclError e = BCL_ERROR_NONE;
+	BclNum n;
+	BclNumber idx;
+	BcVm* vm;
 
-BclNumber
-bcl_mul_keep(BclNumber a, BclNumber b)
-{
-	return bcl_binary(a, b, bc_num_mul, bc_num_mulReq, false);
-}
+	BC_CHECK_CTXT(vm, ctxt);
 
-BclNumber
-bcl_div(BclNumber a, BclNumber b)
-{
-	return bcl_binary(a, b, bc_num_div, bc_num_divReq, true);
-}
+	BC_FUNC_HEADER(vm, err);
 
-BclNumber
-bcl_div_keep(BclNumber a, BclNumber b)
-{
-	return bcl_binary(a, b, bc_num_div, bc_num_divReq, false);
-}
+	BCL_GROW_NUMS(ctxt);
 
-BclNumber
-bcl_mod(BclNumber a, BclNumber b)
-{
-	return bcl_binary(a, b, bc_num_mod, bc_num_divReq, true);
-}
+	// Clear and initialize the number first so that it can be freed on error.
+	bc_num_clear(BCL_NUM_NUM_NP(n));
+	bc_num_init(BCL_NUM_NUM_NP(n), BC_NUM_DEF_SIZE);
 
-BclNumber
-bcl_mod_keep(BclNumber a, BclNumber b)
-{
-	return bcl_binary(a, b, bc_num_mod, bc_num_divReq, false);
-}
+	bc_num_fromLimbs(BCL_NUM_NUM_NP(n), ipart, ilen, fpart, scale, neg);
 
-BclNumber
-bcl_pow(BclNumber a, BclNumber b)
-{
-	return bcl_binary(a, b, bc_num_pow, bc_num_powReq, true);
-}
+err:
 
-BclNumber
-bcl_pow_keep(BclNumber a, BclNumber b)
-{
-	return bcl_binary(a, b, bc_num_pow, bc_num_powReq, false);
-}
+	BC_FUNC_FOOTER(vm, e);
+	BC_MAYBE_SETUP(ctxt, e, n, idx);
 
-BclNumber
-bcl_lshift(BclNumber a, BclNumber b)
-{
-	return bcl_binary(a, b, bc_num_lshift, bc_num_placesReq, true);
+	return idx;
 }
 
 BclNumber
-bcl_lshift_keep(BclNumber a, BclNumber b)
+bcl_limbs2num(const BclLimb* ipart, size_t ilen, const BclLimb* fpart,
+              size_t scale, bool neg)
 {
-	return bcl_binary(a, b, bc_num_lshift, bc_num_placesReq, false);
+	return bcl_ctxt_limbs2num(NULL, ipart, ilen, fpart, scale, neg);
 }
 
-BclNumber
-bcl_rshift(BclNumber a, BclNumber b)
+/**
+ * Copies bytes from the little-endian @a src into @a dest, reversing them if
+ * @a bigEndian is true.
+ * @param dest       The destination.
+ * @param src        The little-endian source.
+ * @param len        The number of bytes to copy.
+ * @param bigEndian  True if @a dest should be big-endian, false otherwise.
+ */
+static void
+bcl_bytesCopy(unsigned char* dest, const uchar* src, size_t len,
+              bool bigEndian)
 {
-	return bcl_binary(a, b, bc_num_rshift, bc_num_placesReq, true);
-}
+	size_t i;
 
-BclNumber
-bcl_rshift_keep(BclNumber a, BclNumber b)
-{
-	return bcl_binary(a, b, bc_num_rshift, bc_num_placesReq, false);
+	if (!bigEndian)
+	{
+		// NOLINTNEXTLINE
+		memcpy(dest, src, len);
+		return;
+	}
+
+	for (i = 0; i < len; ++i)
+	{
+		dest[i] = src[len - 1 - i];
+	}
 }
 
-static BclNumber
-bcl_sqrt_helper(BclNumber a, bool destruct)
+/**
+ * Exports a number as unsigned binary integers.
+ * @param ctxt       The context, or NULL for the current context.
+ * @param n          The number to export.
+ * @param bigEndian  True if the integers should be big-endian, false for
+ *                   little-endian.
+ * @param ipart      The buffer for the integer part.
+ * @param ilen       An in/out parameter for the number of bytes in @a ipart.
+ * @param fpart      The buffer for the fractional part times 10^scale.
+ * @param flen       An in/out parameter for the number of bytes in @a fpart.
+ * @param destruct   True if the number should be consumed, false otherwise.
+ * @return           An error code.
+ */
+static BclError
+bcl_bytes_helper(BclContext ctxt, BclNumber n, bool bigEndian,
+                 unsigned char* ipart, size_t* ilen, unsigned char* fpart,
+                 size_t* flen, bool destruct)
 {
 	BclError e = BCL_ERROR_NONE;
-	BclNum* aptr;
-	BclNum b;
-	BclNumber idx;
-	BclContext ctxt;
-	BcVm* vm = bcl_getspecific();
+	BclNum* num;
+	BcVm* vm;
+	size_t il;
 
-	BC_CHECK_CTXT(vm, ctxt);
+	BC_CHECK_CTXT_ERR(vm, ctxt);
 
-	BC_CHECK_NUM(ctxt, a);
+	BCL_CHECK_NUM_VALID(ctxt, n);
 
 	BC_FUNC_HEADER(vm, err);
 
-	BCL_GROW_NUMS(ctxt);
+	assert(BCL_NO_GEN(n) < ctxt->nums.len);
+	assert(ilen != NULL && flen != NULL);
 
-	assert(BCL_NO_GEN(a) < ctxt->nums.len);
+	num = BCL_NUM(ctxt, n);
 
-	aptr = BCL_NUM(ctxt, a);
+	assert(num != NULL && BCL_NUM_ARRAY(num) != NULL);
 
-	bc_num_sqrt(BCL_NUM_NUM(aptr), BCL_NUM_NUM_NP(b), ctxt->scale);
+	// Convert into the buffer because the sizes are not known until then.
+	bc_vec_popAll(&vm->out);
+	bc_num_toBytes(BCL_NUM_NUM(num), false, &vm->out);
 
-err:
+	il = vm->out.len;
 
-	if (destruct)
+	if (BC_ERR(il > *ilen)) vm->err = BCL_ERROR_MATH_OVERFLOW;
+	else bcl_bytesCopy(ipart, (uchar*) vm->out.v, il, bigEndian);
+
+	bc_vec_popAll(&vm->out);
+	bc_num_toBytes(BCL_NUM_NUM(num), true, &vm->out);
+
+	if (BC_ERR(vm->out.len > *flen)) vm->err = BCL_ERROR_MATH_OVERFLOW;
+	else if (vm->err == BCL_ERROR_NONE)
 	{
-		bcl_num_dtor(ctxt, a, aptr);
+		bcl_bytesCopy(fpart, (uchar*) vm->out.v, vm->out.len, bigEndian);
+	}
+
+	*ilen = il;
+	*flen = vm->out.len;
+
+err:
+
+	if (destruct)
+	{
+		bcl_num_dtor(ctxt, n, num);
 	}
 
 	BC_FUNC_FOOTER(vm, e);
-	BC_MAYBE_SETUP(ctxt, e, b, idx);
 
-	return idx;
+	return e;
 }
 
-BclNumber
-bcl_sqrt(BclNumber a)
+BclError
+bcl_bytes(BclNumber n, bool bigEndian, unsigned char* ipart, size_t* ilen,
+          unsigned char* fpart, size_t* flen)
 {
-	return bcl_sqrt_helper(a, true);
+	return bcl_bytes_helper(NULL, n, bigEndian, ipart, ilen, fpart, flen,
+	                        true);
 }
 
-BclNumber
-bcl_sqrt_keep(BclNumber a)
+BclError
+bcl_ctxt_bytes(BclContext ctxt, BclNumber n, bool bigEndian,
+               unsigned char* ipart, size_t* ilen, unsigned char* fpart,
+               size_t* flen)
 {
-	return bcl_sqrt_helper(a, false);
+	return bcl_bytes_helper(ctxt, n, bigEndian, ipart, ilen, fpart, flen,
+	                        true);
 }
 
-static BclError
-bcl_divmod_helper(BclNumber a, BclNumber b, BclNumber* c, BclNumber* d,
-                  bool destruct)
+BclError
+bcl_bytes_keep(BclNumber n, bool bigEndian, unsigned char* ipart,
+               size_t* ilen, unsigned char* fpart, size_t* flen)
 {
-	BclError e = BCL_ERROR_NONE;
-	size_t req;
-	BclNum* aptr;
-	BclNum* bptr;
-	BclNum cnum, dnum;
-	BclContext ctxt;
-	BcVm* vm = bcl_getspecific();
+	return bcl_bytes_helper(NULL, n, bigEndian, ipart, ilen, fpart, flen,
+	                        false);
+}
 
-	BC_CHECK_CTXT_ERR(vm, ctxt);
+BclError
+bcl_ctxt_bytes_keep(BclContext ctxt, BclNumber n, bool bigEndian,
+                    unsigned char* ipart, size_t* ilen, unsigned char* fpart,
+                    size_t* flen)
+{
+	return bcl_bytes_helper(ctxt, n, bigEndian, ipart, ilen, fpart, flen,
+	                        false);
+}
 
-	BC_CHECK_NUM_ERR(ctxt, a);
-	BC_CHECK_NUM_ERR(ctxt, b);
+BclNumber
+bcl_ctxt_bytes2num(BclContext ctxt, const unsigned char* ipart, size_t ilen,
+                   const unsigned char* fpart, size_t flen, size_t scale,
+                   bool neg, bool bigEndian)
+{
+	BclError e = BCL_ERROR_NONE;
+	BclNum n;
+	BclNumber idx;
+	BcVm* vm;
+
+	BC_CHECK_CTXT(vm, ctxt);
 
 	BC_FUNC_HEADER(vm, err);
 
 	BCL_GROW_NUMS(ctxt);
 
-	assert(c != NULL && d != NULL);
-
-	aptr = BCL_NUM(ctxt, a);
-	bptr = BCL_NUM(ctxt, b);
-
-	assert(aptr != NULL && bptr != NULL);
-	assert(BCL_NUM_ARRAY(aptr) != NULL && BCL_NUM_ARRAY(bptr) != NULL);
-
-	bc_num_clear(BCL_NUM_NUM_NP(cnum));
-	bc_num_clear(BCL_NUM_NUM_NP(dnum));
-
-	req = bc_num_divReq(BCL_NUM_NUM(aptr), BCL_NUM_NUM(bptr), ctxt->scale);
-
-	// Initialize the numbers.
-	bc_num_init(BCL_NUM_NUM_NP(cnum), req);
-	BC_UNSETJMP(vm);
-	BC_SETJMP(vm, err);
-	bc_num_init(BCL_NUM_NUM_NP(dnum), req);
+	// Clear and initialize the number first so that it can be freed on error.
+	bc_num_clear(BCL_NUM_NUM_NP(n));
+	bc_num_init(BCL_NUM_NUM_NP(n), BC_NUM_DEF_SIZE);
 
-	bc_num_divmod(BCL_NUM_NUM(aptr), BCL_NUM_NUM(bptr), BCL_NUM_NUM_NP(cnum),
-	              BCL_NUM_NUM_NP(dnum), ctxt->scale);
+	bc_num_fromBytes(BCL_NUM_NUM_NP(n), ipart, ilen, fpart, flen, scale, neg,
+	                 bigEndian);
 
 err:
 
-	if (destruct)
-	{
-		// Eat the operands.
-		bcl_num_dtor(ctxt, a, aptr);
-		if (b.i != a.i) bcl_num_dtor(ctxt, b, bptr);
-	}
-
-	// If there was an error...
-	if (BC_ERR(vm->err))
-	{
-		// Free the results.
-		if (BCL_NUM_ARRAY_NP(cnum) != NULL) bc_num_free(&cnum);
-		if (BCL_NUM_ARRAY_NP(cnum) != NULL) bc_num_free(&dnum);
-
-		// Make sure the return values are invalid.
-		c->i = 0 - (size_t) BCL_ERROR_INVALID_NUM;
-		d->i = c->i;
-
-		BC_FUNC_FOOTER(vm, e);
-	}
-	else
-	{
-		BC_FUNC_FOOTER(vm, e);
-
-		// Insert the results into the context.
-		*c = bcl_num_insert(ctxt, &cnum);
-		*d = bcl_num_insert(ctxt, &dnum);
-	}
-
-	return e;
-}
+	BC_FUNC_FOOTER(vm, e);
+	BC_MAYBE_SETUP(ctxt, e, n, idx);
 
-BclError
-bcl_divmod(BclNumber a, BclNumber b, BclNumber* c, BclNumber* d)
-{
-	return bcl_divmod_helper(a, b, c, d, true);
+	return idx;
 }
 
-BclError
-bcl_divmod_keep(BclNumber a, BclNumber b, BclNumber* c, BclNumber* d)
+BclNumber
+bcl_bytes2num(const unsigned char* ipart, size_t ilen,
+              const unsigned char* fpart, size_t flen, size_t scale, bool neg,
+              bool bigEndian)
 {
-	return bcl_divmod_helper(a, b, c, d, false);
+	return bcl_ctxt_bytes2num(NULL, ipart, ilen, fpart, flen, scale, neg,
+	                          bigEndian);
 }
 
+/**
+ * Sets up and executes a binary operator operation.
+ * @param ctxt      The context, or NULL for the current context.
+ * @param a         The first operand.
+ * @param b         The second operand.
+ * @param op        The operation.
+ * @param req       The function to get the size of the result for
+ *                  preallocation.
+ * @param destruct  True if the parameters should be consumed, false otherwise.
+ * @return          The result of the operation.
+ */
 static BclNumber
-bcl_modexp_helper(BclNumber a, BclNumber b, BclNumber c, bool destruct)
+bcl_binary(BclContext ctxt, BclNumber a, BclNumber b, const BcNumBinaryOp op,
+           const BcNumBinaryOpReq req, bool destruct)
 {
 	BclError e = BCL_ERROR_NONE;
-	size_t req;
 	BclNum* aptr;
 	BclNum* bptr;
-	BclNum* cptr;
-	BclNum d;
+	BclNum c;
 	BclNumber idx;
-	BclContext ctxt;
-	BcVm* vm = bcl_getspecific();
+	BcVm* vm;
 
 	BC_CHECK_CTXT(vm, ctxt);
 
 	BC_CHECK_NUM(ctxt, a);
 	BC_CHECK_NUM(ctxt, b);
-	BC_CHECK_NUM(ctxt, c);
 
 	BC_FUNC_HEADER(vm, err);
 
 	BCL_GROW_NUMS(ctxt);
 
 	assert(BCL_NO_GEN(a) < ctxt->nums.len && BCL_NO_GEN(b) < ctxt->nums.len);
-	assert(BCL_NO_GEN(c) < ctxt->nums.len);
 
 	aptr = BCL_NUM(ctxt, a);
 	bptr = BCL_NUM(ctxt, b);
-	cptr = BCL_NUM(ctxt, c);
-
-	assert(aptr != NULL && bptr != NULL && cptr != NULL);
-	assert(BCL_NUM_NUM(aptr) != NULL && BCL_NUM_NUM(bptr) != NULL &&
-	       BCL_NUM_NUM(cptr) != NULL);
-
-	// Prepare the result.
-	bc_num_clear(BCL_NUM_NUM_NP(d));
 
-	req = bc_num_divReq(BCL_NUM_NUM(aptr), BCL_NUM_NUM(cptr), 0);
+	assert(aptr != NULL && bptr != NULL);
+	assert(BCL_NUM_ARRAY(aptr) != NULL && BCL_NUM_ARRAY(bptr) != NULL);
 
-	// Initialize the result.
-	bc_num_init(BCL_NUM_NUM_NP(d), req);
+	// Clear and initialize the result.
+	bc_num_clear(BCL_NUM_NUM_NP(c));
+	bc_num_init(BCL_NUM_NUM_NP(c),
+	            req(BCL_NUM_NUM(aptr), BCL_NUM_NUM(bptr), ctxt->scale));
 
-	bc_num_modexp(BCL_NUM_NUM(aptr), BCL_NUM_NUM(bptr), BCL_NUM_NUM(cptr),
-	              BCL_NUM_NUM_NP(d));
+	op(BCL_NUM_NUM(aptr), BCL_NUM_NUM(bptr), BCL_NUM_NUM_NP(c), ctxt->scale);
 
 err:
 
@@ -1224,526 +1305,3376 @@ err:
 		// Eat the operands.
 		bcl_num_dtor(ctxt, a, aptr);
 		if (b.i != a.i) bcl_num_dtor(ctxt, b, bptr);
-		if (c.i != a.i && c.i != b.i) bcl_num_dtor(ctxt, c, cptr);
 	}
 
 	BC_FUNC_FOOTER(vm, e);
-	BC_MAYBE_SETUP(ctxt, e, d, idx);
+	BC_MAYBE_SETUP(ctxt, e, c, idx);
 
 	return idx;
 }
 
 BclNumber
-bcl_modexp(BclNumber a, BclNumber b, BclNumber c)
+bcl_add(BclNumber a, BclNumber b)
 {
-	return bcl_modexp_helper(a, b, c, true);
+	return bcl_binary(NULL, a, b, bc_num_add, bc_num_addReq, true);
 }
 
 BclNumber
-bcl_modexp_keep(BclNumber a, BclNumber b, BclNumber c)
+bcl_ctxt_add(BclContext ctxt, BclNumber a, BclNumber b)
 {
-	return bcl_modexp_helper(a, b, c, false);
+	return bcl_binary(ctxt, a, b, bc_num_add, bc_num_addReq, true);
 }
 
-ssize_t
-bcl_cmp(BclNumber a, BclNumber b)
+BclNumber
+bcl_add_keep(BclNumber a, BclNumber b)
 {
-	BclNum* aptr;
-	BclNum* bptr;
-	BclContext ctxt;
-	BcVm* vm = bcl_getspecific();
-
-	BC_CHECK_CTXT_ASSERT(vm, ctxt);
+	return bcl_binary(NULL, a, b, bc_num_add, bc_num_addReq, false);
+}
 
-	BCL_CHECK_NUM_VALID(ctxt, a);
-	BCL_CHECK_NUM_VALID(ctxt, b);
+BclNumber
+bcl_ctxt_add_keep(BclContext ctxt, BclNumber a, BclNumber b)
+{
+	return bcl_binary(ctxt, a, b, bc_num_add, bc_num_addReq, false);
+}
 
-	assert(BCL_NO_GEN(a) < ctxt->nums.len && BCL_NO_GEN(b) < ctxt->nums.len);
+BclNumber
+bcl_sub(BclNumber a, BclNumber b)
+{
+	return bcl_binary(NULL, a, b, bc_num_sub, bc_num_addReq, true);
+}
 
-	aptr = BCL_NUM(ctxt, a);
-	bptr = BCL_NUM(ctxt, b);
+BclNumber
+bcl_ctxt_sub(BclContext ctxt, BclNumber a, BclNumber b)
+{
+	return bcl_binary(ctxt, a, b, bc_num_sub, bc_num_addReq, true);
+}
 
-	assert(aptr != NULL && bptr != NULL);
-	assert(BCL_NUM_NUM(aptr) != NULL && BCL_NUM_NUM(bptr));
+BclNumber
+bcl_sub_keep(BclNumber a, BclNumber b)
+{
+	return bcl_binary(NULL, a, b, bc_num_sub, bc_num_addReq, false);
+}
 
-	return bc_num_cmp(BCL_NUM_NUM(aptr), BCL_NUM_NUM(bptr));
+BclNumber
+bcl_ctxt_sub_keep(BclContext ctxt, BclNumber a, BclNumber b)
+{
+	return bcl_binary(ctxt, a, b, bc_num_sub, bc_num_addReq, false);
 }
 
-void
-bcl_zero(BclNumber n)
+BclNumber
+bcl_mul(BclNumber a, BclNumber b)
 {
-	BclNum* nptr;
-	BclContext ctxt;
-	BcVm* vm = bcl_getspecific();
+	return bcl_binary(NULL, a, b, bc_num_mul, bc_num_mulReq, true);
+}
 
-	BC_CHECK_CTXT_ASSERT(vm, ctxt);
+BclNumber
+bcl_ctxt_mul(BclContext ctxt, BclNumber a, BclNumber b)
+{
+	return bcl_binary(ctxt, a, b, bc_num_mul, bc_num_mulReq, true);
+}
 
-	BCL_CHECK_NUM_VALID(ctxt, n);
+BclNumber
+bcl_mul_keep(BclNumber a, BclNumber b)
+{
+	return bcl_binary(NULL, a, b, bc_num_mul, bc_num_mulReq, false);
+}
 
-	assert(BCL_NO_GEN(n) < ctxt->nums.len);
+BclNumber
+bcl_ctxt_mul_keep(BclContext ctxt, BclNumber a, BclNumber b)
+{
+	return bcl_binary(ctxt, a, b, bc_num_mul, bc_num_mulReq, false);
+}
 
-	nptr = BCL_NUM(ctxt, n);
+BclNumber
+bcl_div(BclNumber a, BclNumber b)
+{
+	return bcl_binary(NULL, a, b, bc_num_div, bc_num_divReq, true);
+}
 
-	assert(nptr != NULL && BCL_NUM_NUM(nptr) != NULL);
+BclNumber
+bcl_ctxt_div(BclContext ctxt, BclNumber a, BclNumber b)
+{
+	return bcl_binary(ctxt, a, b, bc_num_div, bc_num_divReq, true);
+}
 
-	bc_num_zero(BCL_NUM_NUM(nptr));
+BclNumber
+bcl_div_keep(BclNumber a, BclNumber b)
+{
+	return bcl_binary(NULL, a, b, bc_num_div, bc_num_divReq, false);
 }
 
-void
-bcl_one(BclNumber n)
+BclNumber
+bcl_ctxt_div_keep(BclContext ctxt, BclNumber a, BclNumber b)
 {
-	BclNum* nptr;
-	BclContext ctxt;
-	BcVm* vm = bcl_getspecific();
+	return bcl_binary(ctxt, a, b, bc_num_div, bc_num_divReq, false);
+}
 
-	BC_CHECK_CTXT_ASSERT(vm, ctxt);
+BclNumber
+bcl_mod(BclNumber a, BclNumber b)
+{
+	return bcl_binary(NULL, a, b, bc_num_mod, bc_num_divReq, true);
+}
 
-	BCL_CHECK_NUM_VALID(ctxt, n);
+BclNumber
+bcl_ctxt_mod(BclContext ctxt, BclNumber a, BclNumber b)
+{
+	return bcl_binary(ctxt, a, b, bc_num_mod, bc_num_divReq, true);
+}
 
-	assert(BCL_NO_GEN(n) < ctxt->nums.len);
+BclNumber
+bcl_mod_keep(BclNumber a, BclNumber b)
+{
+	return bcl_binary(NULL, a, b, bc_num_mod, bc_num_divReq, false);
+}
 
-	nptr = BCL_NUM(ctxt, n);
+BclNumber
+bcl_ctxt_mod_keep(BclContext ctxt, BclNumber a, BclNumber b)
+{
+	return bcl_binary(ctxt, a, b, bc_num_mod, bc_num_divReq, false);
+}
 
-	assert(nptr != NULL && BCL_NUM_NUM(nptr) != NULL);
+BclNumber
+bcl_pow(BclNumber a, BclNumber b)
+{
+	return bcl_binary(NULL, a, b, bc_num_pow, bc_num_powReq, true);
+}
 
-	bc_num_one(BCL_NUM_NUM(nptr));
+BclNumber
+bcl_ctxt_pow(BclContext ctxt, BclNumber a, BclNumber b)
+{
+	return bcl_binary(ctxt, a, b, bc_num_pow, bc_num_powReq, true);
 }
 
 BclNumber
-bcl_parse(const char* restrict val)
+bcl_pow_keep(BclNumber a, BclNumber b)
 {
-	BclError e = BCL_ERROR_NONE;
-	BclNum n;
-	BclNumber idx;
-	BclContext ctxt;
-	BcVm* vm = bcl_getspecific();
-	bool neg;
+	return bcl_binary(NULL, a, b, bc_num_pow, bc_num_powReq, false);
+}
 
-	BC_CHECK_CTXT(vm, ctxt);
+BclNumber
+bcl_ctxt_pow_keep(BclContext ctxt, BclNumber a, BclNumber b)
+{
+	return bcl_binary(ctxt, a, b, bc_num_pow, bc_num_powReq, false);
+}
+
+BclNumber
+bcl_lshift(BclNumber a, BclNumber b)
+{
+	return bcl_binary(NULL, a, b, bc_num_lshift, bc_num_placesReq, true);
+}
+
+BclNumber
+bcl_ctxt_lshift(BclContext ctxt, BclNumber a, BclNumber b)
+{
+	return bcl_binary(ctxt, a, b, bc_num_lshift, bc_num_placesReq, true);
+}
+
+BclNumber
+bcl_lshift_keep(BclNumber a, BclNumber b)
+{
+	return bcl_binary(NULL, a, b, bc_num_lshift, bc_num_placesReq, false);
+}
+
+BclNumber
+bcl_ctxt_lshift_keep(BclContext ctxt, BclNumber a, BclNumber b)
+{
+	return bcl_binary(ctxt, a, b, bc_num_lshift, bc_num_placesReq, false);
+}
+
+BclNumber
+bcl_rshift(BclNumber a, BclNumber b)
+{
+	return bcl_binary(NULL, a, b, bc_num_rshift, bc_num_placesReq, true);
+}
+
+BclNumber
+bcl_ctxt_rshift(BclContext ctxt, BclNumber a, BclNumber b)
+{
+	return bcl_binary(ctxt, a, b, bc_num_rshift, bc_num_placesReq, true);
+}
+
+BclNumber
+bcl_rshift_keep(BclNumber a, BclNumber b)
+{
+	return bcl_binary(NULL, a, b, bc_num_rshift, bc_num_placesReq, false);
+}
+
+BclNumber
+bcl_ctxt_rshift_keep(BclContext ctxt, BclNumber a, BclNumber b)
+{
+	return bcl_binary(ctxt, a, b, bc_num_rshift, bc_num_placesReq, false);
+}
+
+static BclNumber
+bcl_sqrt_helper(BclContext ctxt, BclNumber a, bool destruct)
+{
+	BclError e = BCL_ERROR_NONE;
+	BclNum* aptr;
+	BclNum b;
+	BclNumber idx;
+	BcVm* vm;
+
+	BC_CHECK_CTXT(vm, ctxt);
+
+	BC_CHECK_NUM(ctxt, a);
 
 	BC_FUNC_HEADER(vm, err);
 
 	BCL_GROW_NUMS(ctxt);
 
-	assert(val != NULL);
+	assert(BCL_NO_GEN(a) < ctxt->nums.len);
 
-	// We have to take care of negative here because bc's number parsing does
-	// not.
-	neg = (val[0] == '-');
+	aptr = BCL_NUM(ctxt, a);
 
-	if (neg) val += 1;
+	bc_num_sqrt(BCL_NUM_NUM(aptr), BCL_NUM_NUM_NP(b), ctxt->scale);
 
-	// Clear and initialize the number.
-	bc_num_clear(BCL_NUM_NUM_NP(n));
-	bc_num_init(BCL_NUM_NUM_NP(n), BC_NUM_DEF_SIZE);
+err:
 
-	// XXX: This may look like it can go before the clearing and initialization
-	// of the number. However, it cannot.
-	//
-	// The reason why is because if the string is not valid, then when this
-	// jumps to the `err` label, it will try to free a number that was not
-	// initialized. In the best case, this leads to a crash from heap
-	// corruption, and in the worst case, undefined behavior ruins everything.
-	if (!bc_num_strValid(val))
+	if (destruct)
 	{
-		vm->err = BCL_ERROR_PARSE_INVALID_STR;
-		goto err;
+		bcl_num_dtor(ctxt, a, aptr);
 	}
 
-	bc_num_parse(BCL_NUM_NUM_NP(n), val, (BcBigDig) ctxt->ibase);
+	BC_FUNC_FOOTER(vm, e);
+	BC_MAYBE_SETUP(ctxt, e, b, idx);
 
-	// Set the negative.
-#if BC_ENABLE_MEMCHECK
-	n.n.rdx = BC_NUM_NEG_VAL(BCL_NUM_NUM_NP(n), neg);
-#else // BC_ENABLE_MEMCHECK
-	n.rdx = BC_NUM_NEG_VAL_NP(n, neg);
-#endif // BC_ENABLE_MEMCHECK
+	return idx;
+}
 
-err:
+BclNumber
+bcl_sqrt(BclNumber a)
+{
+	return bcl_sqrt_helper(NULL, a, true);
+}
 
-	BC_FUNC_FOOTER(vm, e);
-	BC_MAYBE_SETUP(ctxt, e, n, idx);
+BclNumber
+bcl_ctxt_sqrt(BclContext ctxt, BclNumber a)
+{
+	return bcl_sqrt_helper(ctxt, a, true);
+}
 
-	return idx;
+BclNumber
+bcl_sqrt_keep(BclNumber a)
+{
+	return bcl_sqrt_helper(NULL, a, false);
 }
 
-static char*
-bcl_string_helper(BclNumber n, bool destruct)
+BclNumber
+bcl_ctxt_sqrt_keep(BclContext ctxt, BclNumber a)
 {
-	BclNum* nptr;
-	char* str = NULL;
-	BclContext ctxt;
-	BcVm* vm = bcl_getspecific();
+	return bcl_sqrt_helper(ctxt, a, false);
+}
 
-	BC_CHECK_CTXT_ASSERT(vm, ctxt);
+static BclError
+bcl_divmod_helper(BclContext ctxt, BclNumber a, BclNumber b, BclNumber* c,
+                  BclNumber* d, bool destruct)
+{
+	BclError e = BCL_ERROR_NONE;
+	size_t req;
+	BclNum* aptr;
+	BclNum* bptr;
+	BclNum cnum, dnum;
+	BcVm* vm;
 
-	BCL_CHECK_NUM_VALID(ctxt, n);
+	BC_CHECK_CTXT_ERR(vm, ctxt);
 
-	if (BC_ERR(BCL_NO_GEN(n) >= ctxt->nums.len)) return str;
+	BC_CHECK_NUM_ERR(ctxt, a);
+	BC_CHECK_NUM_ERR(ctxt, b);
 
 	BC_FUNC_HEADER(vm, err);
 
-	assert(BCL_NO_GEN(n) < ctxt->nums.len);
+	BCL_GROW_NUMS(ctxt);
 
-	nptr = BCL_NUM(ctxt, n);
+	assert(c != NULL && d != NULL);
 
-	assert(nptr != NULL && BCL_NUM_NUM(nptr) != NULL);
+	aptr = BCL_NUM(ctxt, a);
+	bptr = BCL_NUM(ctxt, b);
 
-	// Clear the buffer.
-	bc_vec_popAll(&vm->out);
+	assert(aptr != NULL && bptr != NULL);
+	assert(BCL_NUM_ARRAY(aptr) != NULL && BCL_NUM_ARRAY(bptr) != NULL);
 
-	// Print to the buffer.
-	bc_num_print(BCL_NUM_NUM(nptr), (BcBigDig) ctxt->obase, false);
-	bc_vec_pushByte(&vm->out, '\0');
+	bc_num_clear(BCL_NUM_NUM_NP(cnum));
+	bc_num_clear(BCL_NUM_NUM_NP(dnum));
 
-	// Just dup the string; the caller is responsible for it.
-	str = bc_vm_strdup(vm->out.v);
+	req = bc_num_divReq(BCL_NUM_NUM(aptr), BCL_NUM_NUM(bptr), ctxt->scale);
+
+	// Initialize the numbers.
+	bc_num_init(BCL_NUM_NUM_NP(cnum), req);
+	BC_UNSETJMP(vm);
+	BC_SETJMP(vm, err);
+	bc_num_init(BCL_NUM_NUM_NP(dnum), req);
+
+	bc_num_divmod(BCL_NUM_NUM(aptr), BCL_NUM_NUM(bptr), BCL_NUM_NUM_NP(cnum),
+	              BCL_NUM_NUM_NP(dnum), ctxt->scale);
 
 err:
 
 	if (destruct)
 	{
-		// Eat the operand.
-		bcl_num_dtor(ctxt, n, nptr);
+		// Eat the operands.
+		bcl_num_dtor(ctxt, a, aptr);
+		if (b.i != a.i) bcl_num_dtor(ctxt, b, bptr);
 	}
 
-	BC_FUNC_FOOTER_NO_ERR(vm);
+	// If there was an error...
+	if (BC_ERR(vm->err))
+	{
+		// Free the results.
+		if (BCL_NUM_ARRAY_NP(cnum) != NULL) bc_num_free(&cnum);
+		if (BCL_NUM_ARRAY_NP(cnum) != NULL) bc_num_free(&dnum);
 
-	return str;
+		// Make sure the return values are invalid.
+		c->i = 0 - (size_t) BCL_ERROR_INVALID_NUM;
+		d->i = c->i;
+
+		BC_FUNC_FOOTER(vm, e);
+	}
+	else
+	{
+		BC_FUNC_FOOTER(vm, e);
+
+		// Insert the results into the context.
+		*c = bcl_num_insert(ctxt, &cnum);
+		*d = bcl_num_insert(ctxt, &dnum);
+	}
+
+	return e;
 }
 
-char*
-bcl_string(BclNumber n)
+BclError
+bcl_divmod(BclNumber a, BclNumber b, BclNumber* c, BclNumber* d)
 {
-	return bcl_string_helper(n, true);
+	return bcl_divmod_helper(NULL, a, b, c, d, true);
 }
 
-char*
-bcl_string_keep(BclNumber n)
+BclError
+bcl_ctxt_divmod(BclContext ctxt, BclNumber a, BclNumber b, BclNumber* c,
+                BclNumber* d)
 {
-	return bcl_string_helper(n, false);
+	return bcl_divmod_helper(ctxt, a, b, c, d, true);
 }
 
-#if BC_ENABLE_EXTRA_MATH
+BclError
+bcl_divmod_keep(BclNumber a, BclNumber b, BclNumber* c, BclNumber* d)
+{
+	return bcl_divmod_helper(NULL, a, b, c, d, false);
+}
+
+BclError
+bcl_ctxt_divmod_keep(BclContext ctxt, BclNumber a, BclNumber b, BclNumber* c,
+                     BclNumber* d)
+{
+	return bcl_divmod_helper(ctxt, a, b, c, d, false);
+}
 
 static BclNumber
-bcl_irand_helper(BclNumber a, bool destruct)
+bcl_modexp_helper(BclContext ctxt, BclNumber a, BclNumber b, BclNumber c,
+                  bool destruct)
 {
 	BclError e = BCL_ERROR_NONE;
+	size_t req;
 	BclNum* aptr;
-	BclNum b;
+	BclNum* bptr;
+	BclNum* cptr;
+	BclNum d;
 	BclNumber idx;
-	BclContext ctxt;
-	BcVm* vm = bcl_getspecific();
+	BcVm* vm;
 
 	BC_CHECK_CTXT(vm, ctxt);
 
 	BC_CHECK_NUM(ctxt, a);
+	BC_CHECK_NUM(ctxt, b);
+	BC_CHECK_NUM(ctxt, c);
 
 	BC_FUNC_HEADER(vm, err);
 
 	BCL_GROW_NUMS(ctxt);
 
-	assert(BCL_NO_GEN(a) < ctxt->nums.len);
+	assert(BCL_NO_GEN(a) < ctxt->nums.len && BCL_NO_GEN(b) < ctxt->nums.len);
+	assert(BCL_NO_GEN(c) < ctxt->nums.len);
 
 	aptr = BCL_NUM(ctxt, a);
+	bptr = BCL_NUM(ctxt, b);
+	cptr = BCL_NUM(ctxt, c);
 
-	assert(aptr != NULL && BCL_NUM_NUM(aptr) != NULL);
+	assert(aptr != NULL && bptr != NULL && cptr != NULL);
+	assert(BCL_NUM_NUM(aptr) != NULL && BCL_NUM_NUM(bptr) != NULL &&
+	       BCL_NUM_NUM(cptr) != NULL);
 
-	// Clear and initialize the result.
-	bc_num_clear(BCL_NUM_NUM_NP(b));
-	bc_num_init(BCL_NUM_NUM_NP(b), BC_NUM_DEF_SIZE);
+	// Prepare the result.
+	bc_num_clear(BCL_NUM_NUM_NP(d));
+
+	req = bc_num_divReq(BCL_NUM_NUM(aptr), BCL_NUM_NUM(cptr), 0);
+
+	// Initialize the result.
+	bc_num_init(BCL_NUM_NUM_NP(d), req);
+
+	bc_num_modexp(BCL_NUM_NUM(aptr), BCL_NUM_NUM(bptr), BCL_NUM_NUM(cptr),
+	              BCL_NUM_NUM_NP(d));
+
+err:
+
+	if (destruct)
+	{
+		// Eat the operands.
+		bcl_num_dtor(ctxt, a, aptr);
+		if (b.i != a.i) bcl_num_dtor(ctxt, b, bptr);
+		if (c.i != a.i && c.i != b.i) bcl_num_dtor(ctxt, c, cptr);
+	}
+
+	BC_FUNC_FOOTER(vm, e);
+	BC_MAYBE_SETUP(ctxt, e, d, idx);
+
+	return idx;
+}
+
+BclNumber
+bcl_modexp(BclNumber a, BclNumber b, BclNumber c)
+{
+	return bcl_modexp_helper(NULL, a, b, c, true);
+}
+
+BclNumber
+bcl_ctxt_modexp(BclContext ctxt, BclNumber a, BclNumber b, BclNumber c)
+{
+	return bcl_modexp_helper(ctxt, a, b, c, true);
+}
+
+BclNumber
+bcl_modexp_keep(BclNumber a, BclNumber b, BclNumber c)
+{
+	return bcl_modexp_helper(NULL, a, b, c, false);
+}
+
+BclNumber
+bcl_ctxt_modexp_keep(BclContext ctxt, BclNumber a, BclNumber b, BclNumber c)
+{
+	return bcl_modexp_helper(ctxt, a, b, c, false);
+}
+
+static BclNumber
+bcl_fma_helper(BclContext ctxt, BclNumber a, BclNumber b, BclNumber c,
+               bool destruct)
+{
+	BclError e = BCL_ERROR_NONE;
+	BclNum* aptr;
+	BclNum* bptr;
+	BclNum* cptr;
+	BclNum d;
+	BclNumber idx;
+	size_t req;
+	BcVm* vm;
+
+	BC_CHECK_CTXT(vm, ctxt);
+
+	BC_CHECK_NUM(ctxt, a);
+	BC_CHECK_NUM(ctxt, b);
+	BC_CHECK_NUM(ctxt, c);
+
+	BC_FUNC_HEADER(vm, err);
+
+	BCL_GROW_NUMS(ctxt);
+
+	assert(BCL_NO_GEN(a) < ctxt->nums.len && BCL_NO_GEN(b) < ctxt->nums.len);
+	assert(BCL_NO_GEN(c) < ctxt->nums.len);
+
+	aptr = BCL_NUM(ctxt, a);
+	bptr = BCL_NUM(ctxt, b);
+	cptr = BCL_NUM(ctxt, c);
+
+	assert(aptr != NULL && bptr != NULL && cptr != NULL);
+	assert(BCL_NUM_NUM(aptr) != NULL && BCL_NUM_NUM(bptr) != NULL &&
+	       BCL_NUM_NUM(cptr) != NULL);
+
+	// Prepare the result.
+	bc_num_clear(BCL_NUM_NUM_NP(d));
+
+	req = bc_num_mulReq(BCL_NUM_NUM(aptr), BCL_NUM_NUM(bptr), ctxt->scale);
+
+	bc_num_init(BCL_NUM_NUM_NP(d), req);
+
+	bc_num_fma(BCL_NUM_NUM(aptr), BCL_NUM_NUM(bptr), BCL_NUM_NUM(cptr),
+	           BCL_NUM_NUM_NP(d), ctxt->scale);
+
+err:
+
+	if (destruct)
+	{
+		// Eat the operands.
+		bcl_num_dtor(ctxt, a, aptr);
+		if (b.i != a.i) bcl_num_dtor(ctxt, b, bptr);
+		if (c.i != a.i && c.i != b.i) bcl_num_dtor(ctxt, c, cptr);
+	}
+
+	BC_FUNC_FOOTER(vm, e);
+	BC_MAYBE_SETUP(ctxt, e, d, idx);
+
+	return idx;
+}
+
+BclNumber
+bcl_fma(BclNumber a, BclNumber b, BclNumber c)
+{
+	return bcl_fma_helper(NULL, a, b, c, true);
+}
+
+BclNumber
+bcl_ctxt_fma(BclContext ctxt, BclNumber a, BclNumber b, BclNumber c)
+{
+	return bcl_fma_helper(ctxt, a, b, c, true);
+}
+
+BclNumber
+bcl_fma_keep(BclNumber a, BclNumber b, BclNumber c)
+{
+	return bcl_fma_helper(NULL, a, b, c, false);
+}
+
+BclNumber
+bcl_ctxt_fma_keep(BclContext ctxt, BclNumber a, BclNumber b, BclNumber c)
+{
+	return bcl_fma_helper(ctxt, a, b, c, false);
+}
+
+/**
+ * Adds the product of two numbers to a third number in place, or subtracts it.
+ * @param ctxt  The context.
+ * @param a     The first factor.
+ * @param b     The second factor.
+ * @param c     The number to change.
+ * @param op    bc_num_addmul() or bc_num_submul().
+ * @return      An error code, if any.
+ */
+static BclError
+bcl_mulAccum(BclContext ctxt, BclNumber a, BclNumber b, BclNumber c,
+             const BcNumBinaryOp op)
+{
+	BclError e = BCL_ERROR_NONE;
+	BclNum* aptr;
+	BclNum* bptr;
+	BclNum* cptr;
+	BcVm* vm;
+
+	BC_CHECK_CTXT_ERR(vm, ctxt);
+
+	BC_CHECK_NUM_ERR(ctxt, a);
+	BC_CHECK_NUM_ERR(ctxt, b);
+	BC_CHECK_NUM_ERR(ctxt, c);
+
+	assert(BCL_NO_GEN(a) < ctxt->nums.len && BCL_NO_GEN(b) < ctxt->nums.len);
+	assert(BCL_NO_GEN(c) < ctxt->nums.len);
+
+	aptr = BCL_NUM(ctxt, a);
+	bptr = BCL_NUM(ctxt, b);
+	cptr = BCL_NUM(ctxt, c);
+
+	assert(aptr != NULL && bptr != NULL && cptr != NULL);
+	assert(BCL_NUM_ARRAY(aptr) != NULL && BCL_NUM_ARRAY(bptr) != NULL &&
+	       BCL_NUM_ARRAY(cptr) != NULL);
+
+	// Shared numbers are read-only.
+	if (BC_ERR(BCL_IS_SHARED(BCL_NUM_NUM(cptr)))) return BCL_ERROR_INVALID_NUM;
+
+	BC_FUNC_HEADER(vm, err);
+
+	op(BCL_NUM_NUM(aptr), BCL_NUM_NUM(bptr), BCL_NUM_NUM(cptr), ctxt->scale);
+
+err:
+
+	BC_FUNC_FOOTER(vm, e);
+
+	return e;
+}
+
+BclError
+bcl_addmul(BclNumber a, BclNumber b, BclNumber c)
+{
+	return bcl_mulAccum(NULL, a, b, c, bc_num_addmul);
+}
+
+BclError
+bcl_ctxt_addmul(BclContext ctxt, BclNumber a, BclNumber b, BclNumber c)
+{
+	return bcl_mulAccum(ctxt, a, b, c, bc_num_addmul);
+}
+
+BclError
+bcl_submul(BclNumber a, BclNumber b, BclNumber c)
+{
+	return bcl_mulAccum(NULL, a, b, c, bc_num_submul);
+}
+
+BclError
+bcl_ctxt_submul(BclContext ctxt, BclNumber a, BclNumber b, BclNumber c)
+{
+	return bcl_mulAccum(ctxt, a, b, c, bc_num_submul);
+}
+
+static BclError
+bcl_isprime_helper(BclContext ctxt, BclNumber n, bool bpsw, bool* result,
+                   bool destruct)
+{
+	BclError e = BCL_ERROR_NONE;
+	BclNum* num;
+	BcVm* vm;
+
+	BC_CHECK_CTXT_ERR(vm, ctxt);
+
+	BCL_CHECK_NUM_VALID(ctxt, n);
+
+	BC_FUNC_HEADER(vm, err);
+
+	assert(BCL_NO_GEN(n) < ctxt->nums.len);
+	assert(result != NULL);
+
+	num = BCL_NUM(ctxt, n);
+
+	assert(num != NULL && BCL_NUM_ARRAY(num) != NULL);
+
+	*result = bc_num_isPrime(BCL_NUM_NUM(num), bpsw);
+
+err:
+
+	if (destruct)
+	{
+		bcl_num_dtor(ctxt, n, num);
+	}
+
+	BC_FUNC_FOOTER(vm, e);
+
+	return e;
+}
+
+BclError
+bcl_isprime(BclNumber n, bool bpsw, bool* result)
+{
+	return bcl_isprime_helper(NULL, n, bpsw, result, true);
+}
+
+BclError
+bcl_ctxt_isprime(BclContext ctxt, BclNumber n, bool bpsw, bool* result)
+{
+	return bcl_isprime_helper(ctxt, n, bpsw, result, true);
+}
+
+BclError
+bcl_isprime_keep(BclNumber n, bool bpsw, bool* result)
+{
+	return bcl_isprime_helper(NULL, n, bpsw, result, false);
+}
+
+BclError
+bcl_ctxt_isprime_keep(BclContext ctxt, BclNumber n, bool bpsw, bool* result)
+{
+	return bcl_isprime_helper(ctxt, n, bpsw, result, false);
+}
+
+static BclNumber
+bcl_nextprime_helper(BclContext ctxt, BclNumber a, bool destruct)
+{
+	BclError e = BCL_ERROR_NONE;
+	BclNum* aptr;
+	BclNum b;
+	BclNumber idx;
+	BcVm* vm;
+
+	BC_CHECK_CTXT(vm, ctxt);
+
+	BC_CHECK_NUM(ctxt, a);
+
+	BC_FUNC_HEADER(vm, err);
+
+	BCL_GROW_NUMS(ctxt);
+
+	assert(BCL_NO_GEN(a) < ctxt->nums.len);
+
+	aptr = BCL_NUM(ctxt, a);
+
+	assert(aptr != NULL && BCL_NUM_NUM(aptr) != NULL);
+
+	// Clear and initialize the result.
+	bc_num_clear(BCL_NUM_NUM_NP(b));
+	bc_num_init(BCL_NUM_NUM_NP(b), BCL_NUM_NUM(aptr)->len + 1);
+
+	bc_num_nextPrime(BCL_NUM_NUM(aptr), BCL_NUM_NUM_NP(b));
+
+err:
+
+	if (destruct)
+	{
+		// Eat the operand.
+		bcl_num_dtor(ctxt, a, aptr);
+	}
+
+	BC_FUNC_FOOTER(vm, e);
+	BC_MAYBE_SETUP(ctxt, e, b, idx);
+
+	return idx;
+}
+
+BclNumber
+bcl_nextprime(BclNumber a)
+{
+	return bcl_nextprime_helper(NULL, a, true);
+}
+
+BclNumber
+bcl_ctxt_nextprime(BclContext ctxt, BclNumber a)
+{
+	return bcl_nextprime_helper(ctxt, a, true);
+}
+
+BclNumber
+bcl_nextprime_keep(BclNumber a)
+{
+	return bcl_nextprime_helper(NULL, a, false);
+}
+
+BclNumber
+bcl_ctxt_nextprime_keep(BclContext ctxt, BclNumber a)
+{
+	return bcl_nextprime_helper(ctxt, a, false);
+}
+
+static BclNumber
+bcl_modinv_helper(BclContext ctxt, BclNumber a, BclNumber b, bool destruct)
+{
+	BclError e = BCL_ERROR_NONE;
+	BclNum* aptr;
+	BclNum* bptr;
+	BclNum c;
+	BclNumber idx;
+	BcVm* vm;
+
+	BC_CHECK_CTXT(vm, ctxt);
+
+	BC_CHECK_NUM(ctxt, a);
+	BC_CHECK_NUM(ctxt, b);
+
+	BC_FUNC_HEADER(vm, err);
+
+	BCL_GROW_NUMS(ctxt);
+
+	assert(BCL_NO_GEN(a) < ctxt->nums.len && BCL_NO_GEN(b) < ctxt->nums.len);
+
+	aptr = BCL_NUM(ctxt, a);
+	bptr = BCL_NUM(ctxt, b);
+
+	assert(aptr != NULL && bptr != NULL);
+	assert(BCL_NUM_NUM(aptr) != NULL && BCL_NUM_NUM(bptr) != NULL);
+
+	// Clear and initialize the result.
+	bc_num_clear(BCL_NUM_NUM_NP(c));
+	bc_num_init(BCL_NUM_NUM_NP(c), BCL_NUM_NUM(bptr)->len);
+
+	bc_num_modinv(BCL_NUM_NUM(aptr), BCL_NUM_NUM(bptr), BCL_NUM_NUM_NP(c));
+
+err:
+
+	if (destruct)
+	{
+		// Eat the operands.
+		bcl_num_dtor(ctxt, a, aptr);
+		if (b.i != a.i) bcl_num_dtor(ctxt, b, bptr);
+	}
+
+	BC_FUNC_FOOTER(vm, e);
+	BC_MAYBE_SETUP(ctxt, e, c, idx);
+
+	return idx;
+}
+
+BclNumber
+bcl_modinv(BclNumber a, BclNumber b)
+{
+	return bcl_modinv_helper(NULL, a, b, true);
+}
+
+BclNumber
+bcl_ctxt_modinv(BclContext ctxt, BclNumber a, BclNumber b)
+{
+	return bcl_modinv_helper(ctxt, a, b, true);
+}
+
+BclNumber
+bcl_modinv_keep(BclNumber a, BclNumber b)
+{
+	return bcl_modinv_helper(NULL, a, b, false);
+}
+
+BclNumber
+bcl_ctxt_modinv_keep(BclContext ctxt, BclNumber a, BclNumber b)
+{
+	return bcl_modinv_helper(ctxt, a, b, false);
+}
+
+static BclError
+bcl_egcd_helper(BclContext ctxt, BclNumber a, BclNumber b, BclNumber* g,
+                BclNumber* x, BclNumber* y, bool destruct)
+{
+	BclError e = BCL_ERROR_NONE;
+	size_t req;
+	BclNum* aptr;
+	BclNum* bptr;
+	BclNum gnum, xnum, ynum;
+	BcVm* vm;
+
+	BC_CHECK_CTXT_ERR(vm, ctxt);
+
+	BC_CHECK_NUM_ERR(ctxt, a);
+	BC_CHECK_NUM_ERR(ctxt, b);
+
+	BC_FUNC_HEADER(vm, err);
+
+	BCL_GROW_NUMS(ctxt);
+
+	assert(g != NULL && x != NULL && y != NULL);
+
+	aptr = BCL_NUM(ctxt, a);
+	bptr = BCL_NUM(ctxt, b);
+
+	assert(aptr != NULL && bptr != NULL);
+	assert(BCL_NUM_ARRAY(aptr) != NULL && BCL_NUM_ARRAY(bptr) != NULL);
+
+	bc_num_clear(BCL_NUM_NUM_NP(gnum));
+	bc_num_clear(BCL_NUM_NUM_NP(xnum));
+	bc_num_clear(BCL_NUM_NUM_NP(ynum));
+
+	req = bc_num_addReq(BCL_NUM_NUM(aptr), BCL_NUM_NUM(bptr), 0);
+
+	// Initialize the numbers.
+	bc_num_init(BCL_NUM_NUM_NP(gnum), req);
+	BC_UNSETJMP(vm);
+	BC_SETJMP(vm, err);
+	bc_num_init(BCL_NUM_NUM_NP(xnum), req);
+	BC_UNSETJMP(vm);
+	BC_SETJMP(vm, err);
+	bc_num_init(BCL_NUM_NUM_NP(ynum), req);
+
+	bc_num_egcd(BCL_NUM_NUM(aptr), BCL_NUM_NUM(bptr), BCL_NUM_NUM_NP(gnum),
+	            BCL_NUM_NUM_NP(xnum), BCL_NUM_NUM_NP(ynum));
+
+err:
+
+	if (destruct)
+	{
+		// Eat the operands.
+		bcl_num_dtor(ctxt, a, aptr);
+		if (b.i != a.i) bcl_num_dtor(ctxt, b, bptr);
+	}
+
+	// If there was an error...
+	if (BC_ERR(vm->err))
+	{
+		// Free the results.
+		if (BCL_NUM_ARRAY_NP(gnum) != NULL) bc_num_free(&gnum);
+		if (BCL_NUM_ARRAY_NP(xnum) != NULL) bc_num_free(&xnum);
+		if (BCL_NUM_ARRAY_NP(ynum) != NULL) bc_num_free(&ynum);
+
+		// Make sure the return values are invalid.
+		g->i = 0 - (size_t) BCL_ERROR_INVALID_NUM;
+		x->i = g->i;
+		y->i = g->i;
+
+		BC_FUNC_FOOTER(vm, e);
+	}
+	else
+	{
+		BC_FUNC_FOOTER(vm, e);
+
+		// Insert the results into the context.
+		*g = bcl_num_insert(ctxt, &gnum);
+		*x = bcl_num_insert(ctxt, &xnum);
+		*y = bcl_num_insert(ctxt, &ynum);
+	}
+
+	return e;
+}
+
+BclError
+bcl_egcd(BclNumber a, BclNumber b, BclNumber* g, BclNumber* x, BclNumber* y)
+{
+	return bcl_egcd_helper(NULL, a, b, g, x, y, true);
+}
+
+BclError
+bcl_ctxt_egcd(BclContext ctxt, BclNumber a, BclNumber b, BclNumber* g,
+              BclNumber* x, BclNumber* y)
+{
+	return bcl_egcd_helper(ctxt, a, b, g, x, y, true);
+}
+
+BclError
+bcl_egcd_keep(BclNumber a, BclNumber b, BclNumber* g, BclNumber* x,
+              BclNumber* y)
+{
+	return bcl_egcd_helper(NULL, a, b, g, x, y, false);
+}
+
+BclError
+bcl_ctxt_egcd_keep(BclContext ctxt, BclNumber a, BclNumber b, BclNumber* g,
+                   BclNumber* x, BclNumber* y)
+{
+	return bcl_egcd_helper(ctxt, a, b, g, x, y, false);
+}
+
+/**
+ * Implements the batched elementwise binary operators. Unlike the single
+ * operators, this sets the jump and grows the context's nums once for the
+ * whole batch. It never consumes its operands.
+ * @param ctxt  The context, or NULL to use the current one.
+ * @param a     The array of first operands.
+ * @param b     The array of second operands.
+ * @param c     An out parameter for the array of results.
+ * @param n     The length of all three arrays.
+ * @param op    The operation.
+ * @param req   The function to get the size of each result for init.
+ * @return      An error code, if any.
+ */
+static BclError
+bcl_binary_array(BclContext ctxt, const BclNumber* a, const BclNumber* b,
+                 BclNumber* c, size_t n, const BcNumBinaryOp op,
+                 const BcNumBinaryOpReq req)
+{
+	BclError e = BCL_ERROR_NONE;
+	BclNum* aptr;
+	BclNum* bptr;
+	BclNum cnum;
+	BcVm* vm;
+	// This is volatile to quiet a GCC warning about longjmp() clobbering.
+	volatile size_t i;
+
+	BC_CHECK_CTXT_ERR(vm, ctxt);
+
+	assert(!n || (a != NULL && b != NULL && c != NULL));
+
+	for (i = 0; i < n; ++i)
+	{
+		BC_CHECK_NUM_ERR(ctxt, a[i]);
+		BC_CHECK_NUM_ERR(ctxt, b[i]);
+	}
+
+	bc_num_clear(BCL_NUM_NUM_NP(cnum));
+
+	BC_FUNC_HEADER(vm, err);
+
+	// Make room for all of the results up front so that inserting them never
+	// reallocates the nums.
+	if (ctxt->free_nums.len < n)
+	{
+		bc_vec_grow(&ctxt->nums, n - ctxt->free_nums.len);
+	}
+
+	for (i = 0; i < n; ++i)
+	{
+		aptr = BCL_NUM(ctxt, a[i]);
+		bptr = BCL_NUM(ctxt, b[i]);
+
+		assert(aptr != NULL && bptr != NULL);
+		assert(BCL_NUM_ARRAY(aptr) != NULL && BCL_NUM_ARRAY(bptr) != NULL);
+
+		bc_num_init(BCL_NUM_NUM_NP(cnum),
+		            req(BCL_NUM_NUM(aptr), BCL_NUM_NUM(bptr), ctxt->scale));
+
+		op(BCL_NUM_NUM(aptr), BCL_NUM_NUM(bptr), BCL_NUM_NUM_NP(cnum),
+		   ctxt->scale);
+
+		c[i] = bcl_num_insert(ctxt, &cnum);
+
+		// The context owns the result now.
+		bc_num_clear(BCL_NUM_NUM_NP(cnum));
+	}
+
+err:
+
+	// If there was an error...
+	if (BC_ERR(vm->err))
+	{
+		size_t j;
+
+		if (BCL_NUM_ARRAY_NP(cnum) != NULL)
+		{
+			bc_num_free(BCL_NUM_NUM_NP(cnum));
+		}
+
+		// Free the results that were already made and make sure that all of
+		// the return values are invalid.
+		for (j = 0; j < n; ++j)
+		{
+			if (j < i) bcl_num_dtor(ctxt, c[j], BCL_NUM(ctxt, c[j]));
+			c[j].i = 0 - (size_t) BCL_ERROR_INVALID_NUM;
+		}
+	}
+
+	BC_FUNC_FOOTER(vm, e);
+
+	return e;
+}
+
+BclError
+bcl_add_array(const BclNumber* a, const BclNumber* b, BclNumber* c, size_t n)
+{
+	return bcl_binary_array(NULL, a, b, c, n, bc_num_add, bc_num_addReq);
+}
+
+BclError
+bcl_ctxt_add_array(BclContext ctxt, const BclNumber* a, const BclNumber* b,
+                   BclNumber* c, size_t n)
+{
+	return bcl_binary_array(ctxt, a, b, c, n, bc_num_add, bc_num_addReq);
+}
+
+BclError
+bcl_sub_array(const BclNumber* a, const BclNumber* b, BclNumber* c, size_t n)
+{
+	return bcl_binary_array(NULL, a, b, c, n, bc_num_sub, bc_num_addReq);
+}
+
+BclError
+bcl_ctxt_sub_array(BclContext ctxt, const BclNumber* a, const BclNumber* b,
+                   BclNumber* c, size_t n)
+{
+	return bcl_binary_array(ctxt, a, b, c, n, bc_num_sub, bc_num_addReq);
+}
+
+BclError
+bcl_mul_array(const BclNumber* a, const BclNumber* b, BclNumber* c, size_t n)
+{
+	return bcl_binary_array(NULL, a, b, c, n, bc_num_mul, bc_num_mulReq);
+}
+
+BclError
+bcl_ctxt_mul_array(BclContext ctxt, const BclNumber* a, const BclNumber* b,
+                   BclNumber* c, size_t n)
+{
+	return bcl_binary_array(ctxt, a, b, c, n, bc_num_mul, bc_num_mulReq);
+}
+
+BclError
+bcl_div_array(const BclNumber* a, const BclNumber* b, BclNumber* c, size_t n)
+{
+	return bcl_binary_array(NULL, a, b, c, n, bc_num_div, bc_num_divReq);
+}
+
+BclError
+bcl_ctxt_div_array(BclContext ctxt, const BclNumber* a, const BclNumber* b,
+                   BclNumber* c, size_t n)
+{
+	return bcl_binary_array(ctxt, a, b, c, n, bc_num_div, bc_num_divReq);
+}
+
+/**
+ * Implements the batched reductions. The accumulator and the temporaries are
+ * swapped instead of reallocated, so the whole reduction only allocates a
+ * handful of times. It never consumes its operands.
+ * @param ctxt  The context, or NULL to use the current one.
+ * @param a     The array of operands.
+ * @param b     If not NULL, the array of operands to multiply the elements of
+ *              @a a by before they are accumulated.
+ * @param n     The length of the arrays.
+ * @param op    The operation to accumulate with.
+ * @param one   True if the accumulator should start at one, false for zero.
+ * @return      The result, or an error number.
+ */
+static BclNumber
+bcl_reduce(BclContext ctxt, const BclNumber* a, const BclNumber* b, size_t n,
+           const BcNumBinaryOp op, bool one)
+{
+	BclError e = BCL_ERROR_NONE;
+	BclNum* aptr;
+	BclNum* bptr;
+	BcNum* rhs;
+	BclNum acc, next, prod, temp;
+	BclNumber idx;
+	size_t i;
+	BcVm* vm;
+
+	BC_CHECK_CTXT(vm, ctxt);
+
+	assert(!n || a != NULL);
+
+	for (i = 0; i < n; ++i)
+	{
+		BC_CHECK_NUM(ctxt, a[i]);
+		if (b != NULL) BC_CHECK_NUM(ctxt, b[i]);
+	}
+
+	bc_num_clear(BCL_NUM_NUM_NP(acc));
+	bc_num_clear(BCL_NUM_NUM_NP(next));
+	bc_num_clear(BCL_NUM_NUM_NP(prod));
+
+	BC_FUNC_HEADER(vm, err);
+
+	BCL_GROW_NUMS(ctxt);
+
+	bc_num_init(BCL_NUM_NUM_NP(acc), BC_NUM_DEF_SIZE);
+	bc_num_init(BCL_NUM_NUM_NP(next), BC_NUM_DEF_SIZE);
+	if (b != NULL) bc_num_init(BCL_NUM_NUM_NP(prod), BC_NUM_DEF_SIZE);
+
+	if (one) bc_num_one(BCL_NUM_NUM_NP(acc));
+
+	for (i = 0; i < n; ++i)
+	{
+		aptr = BCL_NUM(ctxt, a[i]);
+
+		assert(aptr != NULL && BCL_NUM_ARRAY(aptr) != NULL);
+
+		rhs = BCL_NUM_NUM(aptr);
+
+		if (b != NULL)
+		{
+			bptr = BCL_NUM(ctxt, b[i]);
+
+			assert(bptr != NULL && BCL_NUM_ARRAY(bptr) != NULL);
+
+			bc_num_mul(rhs, BCL_NUM_NUM(bptr), BCL_NUM_NUM_NP(prod),
+			           ctxt->scale);
+
+			rhs = BCL_NUM_NUM_NP(prod);
+		}
+
+		op(BCL_NUM_NUM_NP(acc), rhs, BCL_NUM_NUM_NP(next), ctxt->scale);
+
+		// Swap so that the old accumulator is reused for the next result.
+		temp = acc;
+		acc = next;
+		next = temp;
+	}
+
+err:
+
+	if (BCL_NUM_ARRAY_NP(next) != NULL) bc_num_free(BCL_NUM_NUM_NP(next));
+	if (BCL_NUM_ARRAY_NP(prod) != NULL) bc_num_free(BCL_NUM_NUM_NP(prod));
+
+	BC_FUNC_FOOTER(vm, e);
+	BC_MAYBE_SETUP(ctxt, e, acc, idx);
+
+	return idx;
+}
+
+BclNumber
+bcl_sum(const BclNumber* a, size_t n)
+{
+	return bcl_reduce(NULL, a, NULL, n, bc_num_add, false);
+}
+
+BclNumber
+bcl_ctxt_sum(BclContext ctxt, const BclNumber* a, size_t n)
+{
+	return bcl_reduce(ctxt, a, NULL, n, bc_num_add, false);
+}
+
+BclNumber
+bcl_prod(const BclNumber* a, size_t n)
+{
+	return bcl_reduce(NULL, a, NULL, n, bc_num_mul, true);
+}
+
+BclNumber
+bcl_ctxt_prod(BclContext ctxt, const BclNumber* a, size_t n)
+{
+	return bcl_reduce(ctxt, a, NULL, n, bc_num_mul, true);
+}
+
+BclNumber
+bcl_dot(const BclNumber* a, const BclNumber* b, size_t n)
+{
+	assert(!n || b != NULL);
+	return bcl_reduce(NULL, a, b, n, bc_num_add, false);
+}
+
+BclNumber
+bcl_ctxt_dot(BclContext ctxt, const BclNumber* a, const BclNumber* b,
+             size_t n)
+{
+	assert(!n || b != NULL);
+	return bcl_reduce(ctxt, a, b, n, bc_num_add, false);
+}
+
+BclError
+bcl_ctxt_axpy(BclContext ctxt, BclNumber a, const BclNumber* x,
+              const BclNumber* y, size_t n)
+{
+	BclError e = BCL_ERROR_NONE;
+	BclNum* aptr;
+	BclNum* xptr;
+	BclNum* yptr;
+	size_t i;
+	BcVm* vm;
+
+	BC_CHECK_CTXT_ERR(vm, ctxt);
+
+	assert(!n || (x != NULL && y != NULL));
+
+	BC_CHECK_NUM_ERR(ctxt, a);
+
+	for (i = 0; i < n; ++i)
+	{
+		BC_CHECK_NUM_ERR(ctxt, x[i]);
+		BC_CHECK_NUM_ERR(ctxt, y[i]);
+
+		// Shared numbers are read-only.
+		if (BC_ERR(BCL_IS_SHARED(BCL_NUM_NUM(BCL_NUM(ctxt, y[i])))))
+		{
+			return BCL_ERROR_INVALID_NUM;
+		}
+	}
+
+	BC_FUNC_HEADER(vm, err);
+
+	for (i = 0; i < n; ++i)
+	{
+		aptr = BCL_NUM(ctxt, a);
+		xptr = BCL_NUM(ctxt, x[i]);
+		yptr = BCL_NUM(ctxt, y[i]);
+
+		assert(aptr != NULL && xptr != NULL && yptr != NULL);
+		assert(BCL_NUM_ARRAY(aptr) != NULL && BCL_NUM_ARRAY(xptr) != NULL &&
+		       BCL_NUM_ARRAY(yptr) != NULL);
+
+		// The product is added to y[i] in place.
+		bc_num_addmul(BCL_NUM_NUM(aptr), BCL_NUM_NUM(xptr), BCL_NUM_NUM(yptr),
+		              ctxt->scale);
+	}
+
+err:
+
+	BC_FUNC_FOOTER(vm, e);
+
+	return e;
+}
+
+BclError
+bcl_axpy(BclNumber a, const BclNumber* x, const BclNumber* y, size_t n)
+{
+	return bcl_ctxt_axpy(NULL, a, x, y, n);
+}
+
+ssize_t
+bcl_ctxt_cmp(BclContext ctxt, BclNumber a, BclNumber b)
+{
+	BclNum* aptr;
+	BclNum* bptr;
+	BcVm* vm;
+
+	BC_CHECK_CTXT_ASSERT(vm, ctxt);
+
+	BCL_CHECK_NUM_VALID(ctxt, a);
+	BCL_CHECK_NUM_VALID(ctxt, b);
+
+	assert(BCL_NO_GEN(a) < ctxt->nums.len && BCL_NO_GEN(b) < ctxt->nums.len);
+
+	aptr = BCL_NUM(ctxt, a);
+	bptr = BCL_NUM(ctxt, b);
+
+	assert(aptr != NULL && bptr != NULL);
+	assert(BCL_NUM_NUM(aptr) != NULL && BCL_NUM_NUM(bptr));
+
+	return bc_num_cmp(BCL_NUM_NUM(aptr), BCL_NUM_NUM(bptr));
+}
+
+ssize_t
+bcl_cmp(BclNumber a, BclNumber b)
+{
+	return bcl_ctxt_cmp(NULL, a, b);
+}
+
+void
+bcl_ctxt_zero(BclContext ctxt, BclNumber n)
+{
+	BclNum* nptr;
+	BcVm* vm;
+
+	BC_CHECK_CTXT_ASSERT(vm, ctxt);
+
+	BCL_CHECK_NUM_VALID(ctxt, n);
+
+	assert(BCL_NO_GEN(n) < ctxt->nums.len);
+
+	nptr = BCL_NUM(ctxt, n);
+
+	assert(nptr != NULL && BCL_NUM_NUM(nptr) != NULL);
+	assert(!BCL_IS_SHARED(BCL_NUM_NUM(nptr)));
+
+	bc_num_zero(BCL_NUM_NUM(nptr));
+}
+
+void
+bcl_zero(BclNumber n)
+{
+	bcl_ctxt_zero(NULL, n);
+}
+
+void
+bcl_ctxt_one(BclContext ctxt, BclNumber n)
+{
+	BclNum* nptr;
+	BcVm* vm;
+
+	BC_CHECK_CTXT_ASSERT(vm, ctxt);
+
+	BCL_CHECK_NUM_VALID(ctxt, n);
+
+	assert(BCL_NO_GEN(n) < ctxt->nums.len);
+
+	nptr = BCL_NUM(ctxt, n);
+
+	assert(nptr != NULL && BCL_NUM_NUM(nptr) != NULL);
+	assert(!BCL_IS_SHARED(BCL_NUM_NUM(nptr)));
+
+	bc_num_one(BCL_NUM_NUM(nptr));
+}
+
+void
+bcl_one(BclNumber n)
+{
+	bcl_ctxt_one(NULL, n);
+}
+
+BclNumber
+bcl_ctxt_parse(BclContext ctxt, const char* restrict val)
+{
+	BclError e = BCL_ERROR_NONE;
+	BclNum n;
+	BclNumber idx;
+	BcVm* vm;
+	bool neg;
+
+	BC_CHECK_CTXT(vm, ctxt);
+
+	BC_FUNC_HEADER(vm, err);
+
+	BCL_GROW_NUMS(ctxt);
+
+	assert(val != NULL);
+
+	// We have to take care of negative here because bc's number parsing does
+	// not.
+	neg = (val[0] == '-');
+
+	if (neg) val += 1;
+
+	// Clear and initialize the number.
+	bc_num_clear(BCL_NUM_NUM_NP(n));
+	bc_num_init(BCL_NUM_NUM_NP(n), BC_NUM_DEF_SIZE);
+
+	// XXX: This may look like it can go before the clearing and initialization
+	// of the number. However, it cannot.
+	//
+	// The reason why is because if the string is not valid, then when this
+	// jumps to the `err` label, it will try to free a number that was not
+	// initialized. In the best case, this leads to a crash from heap
+	// corruption, and in the worst case, undefined behavior ruins everything.
+	if (!bc_num_strValid(val))
+	{
+		vm->err = BCL_ERROR_PARSE_INVALID_STR;
+		goto err;
+	}
+
+	bc_num_parse(BCL_NUM_NUM_NP(n), val, (BcBigDig) ctxt->ibase);
+
+	// Set the negative.
+#if BC_ENABLE_MEMCHECK
+	n.n.rdx = BC_NUM_NEG_VAL(BCL_NUM_NUM_NP(n), neg);
+#else // BC_ENABLE_MEMCHECK
+	n.rdx = BC_NUM_NEG_VAL_NP(n, neg);
+#endif // BC_ENABLE_MEMCHECK
+
+err:
+
+	BC_FUNC_FOOTER(vm, e);
+	BC_MAYBE_SETUP(ctxt, e, n, idx);
+
+	return idx;
+}
+
+BclNumber
+bcl_parse(const char* restrict val)
+{
+	return bcl_ctxt_parse(NULL, val);
+}
+
+static char*
+bcl_string_helper(BclContext ctxt, BclNumber n, bool destruct)
+{
+	BclNum* nptr;
+	char* str = NULL;
+	BcVm* vm;
+
+	BC_CHECK_CTXT_ASSERT(vm, ctxt);
+
+	BCL_CHECK_NUM_VALID(ctxt, n);
+
+	if (BC_ERR(BCL_NO_GEN(n) >= ctxt->nums.len)) return str;
+
+	BC_FUNC_HEADER(vm, err);
+
+	assert(BCL_NO_GEN(n) < ctxt->nums.len);
+
+	nptr = BCL_NUM(ctxt, n);
+
+	assert(nptr != NULL && BCL_NUM_NUM(nptr) != NULL);
+
+	// Clear the buffer.
+	bc_vec_popAll(&vm->out);
+
+	// Print to the buffer.
+	bc_num_print(BCL_NUM_NUM(nptr), (BcBigDig) ctxt->obase, false);
+	bc_vec_pushByte(&vm->out, '\0');
+
+	// Just dup the string; the caller is responsible for it.
+	str = bc_vm_strdup(vm->out.v);
+
+err:
+
+	if (destruct)
+	{
+		// Eat the operand.
+		bcl_num_dtor(ctxt, n, nptr);
+	}
+
+	BC_FUNC_FOOTER_NO_ERR(vm);
+
+	return str;
+}
+
+char*
+bcl_string(BclNumber n)
+{
+	return bcl_string_helper(NULL, n, true);
+}
+
+char*
+bcl_ctxt_string(BclContext ctxt, BclNumber n)
+{
+	return bcl_string_helper(ctxt, n, true);
+}
+
+char*
+bcl_string_keep(BclNumber n)
+{
+	return bcl_string_helper(NULL, n, false);
+}
+
+char*
+bcl_ctxt_string_keep(BclContext ctxt, BclNumber n)
+{
+	return bcl_string_helper(ctxt, n, false);
+}
+
+/**
+ * Converts a number to a string in a caller-supplied buffer.
+ * @param ctxt      The context, or NULL for the current context.
+ * @param n         The number to convert.
+ * @param buf       The buffer.
+ * @param size      The size of @a buf, including space for the nul byte.
+ * @param len       An out parameter for the length of the string, without the
+ *                  nul byte. This is set even if @a buf is too small. It may
+ *                  be NULL.
+ * @param destruct  True if the number should be consumed, false otherwise.
+ * @return          An error code.
+ */
+static BclError
+bcl_string_into_helper(BclContext ctxt, BclNumber n, char* buf, size_t size,
+                       size_t* len, bool destruct)
+{
+	BclError e = BCL_ERROR_NONE;
+	BclNum* nptr;
+	BcVm* vm;
+
+	BC_CHECK_CTXT_ERR(vm, ctxt);
+
+	BCL_CHECK_NUM_VALID(ctxt, n);
+
+	BC_FUNC_HEADER(vm, err);
+
+	assert(BCL_NO_GEN(n) < ctxt->nums.len);
+
+	nptr = BCL_NUM(ctxt, n);
+
+	assert(nptr != NULL && BCL_NUM_NUM(nptr) != NULL);
+
+	// Clear the buffer.
+	bc_vec_popAll(&vm->out);
+
+	// Print to the buffer.
+	bc_num_print(BCL_NUM_NUM(nptr), (BcBigDig) ctxt->obase, false);
+
+	if (len != NULL) *len = vm->out.len;
+
+	// There must be room for the nul byte too.
+	if (BC_ERR(vm->out.len >= size)) vm->err = BCL_ERROR_MATH_OVERFLOW;
+	else
+	{
+		// NOLINTNEXTLINE
+		memcpy(buf, vm->out.v, vm->out.len);
+		buf[vm->out.len] = '\0';
+	}
+
+err:
+
+	if (destruct)
+	{
+		// Eat the operand.
+		bcl_num_dtor(ctxt, n, nptr);
+	}
+
+	BC_FUNC_FOOTER(vm, e);
+
+	return e;
+}
+
+BclError
+bcl_string_into(BclNumber n, char* buf, size_t size, size_t* len)
+{
+	return bcl_string_into_helper(NULL, n, buf, size, len, true);
+}
+
+BclError
+bcl_ctxt_string_into(BclContext ctxt, BclNumber n, char* buf, size_t size,
+                     size_t* len)
+{
+	return bcl_string_into_helper(ctxt, n, buf, size, len, true);
+}
+
+BclError
+bcl_string_into_keep(BclNumber n, char* buf, size_t size, size_t* len)
+{
+	return bcl_string_into_helper(NULL, n, buf, size, len, false);
+}
+
+BclError
+bcl_ctxt_string_into_keep(BclContext ctxt, BclNumber n, char* buf,
+                          size_t size, size_t* len)
+{
+	return bcl_string_into_helper(ctxt, n, buf, size, len, false);
+}
+
+#if BC_ENABLE_EXTRA_MATH
+
+static BclNumber
+bcl_irand_helper(BclContext ctxt, BclNumber a, bool destruct)
+{
+	BclError e = BCL_ERROR_NONE;
+	BclNum* aptr;
+	BclNum b;
+	BclNumber idx;
+	BcVm* vm;
+
+	BC_CHECK_CTXT(vm, ctxt);
+
+	BC_CHECK_NUM(ctxt, a);
+
+	BC_FUNC_HEADER(vm, err);
+
+	BCL_GROW_NUMS(ctxt);
+
+	assert(BCL_NO_GEN(a) < ctxt->nums.len);
+
+	aptr = BCL_NUM(ctxt, a);
+
+	assert(aptr != NULL && BCL_NUM_NUM(aptr) != NULL);
+
+	// Clear and initialize the result.
+	bc_num_clear(BCL_NUM_NUM_NP(b));
+	bc_num_init(BCL_NUM_NUM_NP(b), BC_NUM_DEF_SIZE);
+
+	bc_num_irand(BCL_NUM_NUM(aptr), BCL_NUM_NUM_NP(b), &vm->rng);
+
+err:
+
+	if (destruct)
+	{
+		// Eat the operand.
+		bcl_num_dtor(ctxt, a, aptr);
+	}
+
+	BC_FUNC_FOOTER(vm, e);
+	BC_MAYBE_SETUP(ctxt, e, b, idx);
+
+	return idx;
+}
+
+BclNumber
+bcl_irand(BclNumber a)
+{
+	return bcl_irand_helper(NULL, a, true);
+}
+
+BclNumber
+bcl_ctxt_irand(BclContext ctxt, BclNumber a)
+{
+	return bcl_irand_helper(ctxt, a, true);
+}
+
+BclNumber
+bcl_irand_keep(BclNumber a)
+{
+	return bcl_irand_helper(NULL, a, false);
+}
+
+BclNumber
+bcl_ctxt_irand_keep(BclContext ctxt, BclNumber a)
+{
+	return bcl_irand_helper(ctxt, a, false);
+}
+
+/**
+ * Helps bcl_frand(). This is separate because the error handling is easier that
+ * way. It is also easier to do ifrand that way.
+ * @param vm      The thread data.
+ * @param b       The return parameter.
+ * @param places  The number of decimal places to generate.
+ */
+static void
+bcl_frandHelper(BcVm* vm, BcNum* restrict b, size_t places)
+{
+	BcNum exp, pow, ten;
+	BcDig exp_digs[BC_NUM_BIGDIG_LOG10];
+	BcDig ten_digs[BC_NUM_BIGDIG_LOG10];
+
+	// Set up temporaries.
+	bc_num_setup(&exp, exp_digs, BC_NUM_BIGDIG_LOG10);
+	bc_num_setup(&ten, ten_digs, BC_NUM_BIGDIG_LOG10);
+
+	ten.num[0] = 10;
+	ten.len = 1;
+
+	bc_num_bigdig2num(&exp, (BcBigDig) places);
+
+	// Clear the temporary that might need to grow.
+	bc_num_clear(&pow);
+
+	// Initialize the temporary that might need to grow.
+	bc_num_init(&pow, bc_num_powReq(&ten, &exp, 0));
+
+	BC_SETJMP(vm, err);
+
+	// Generate the number.
+	bc_num_pow(&ten, &exp, &pow, 0);
+	bc_num_irand(&pow, b, &vm->rng);
+
+	// Make the number entirely fraction.
+	bc_num_shiftRight(b, places);
+
+err:
+
+	bc_num_free(&pow);
+	BC_LONGJMP_CONT(vm);
+}
+
+BclNumber
+bcl_ctxt_frand(BclContext ctxt, size_t places)
+{
+	BclError e = BCL_ERROR_NONE;
+	BclNum n;
+	BclNumber idx;
+	BcVm* vm;
+
+	BC_CHECK_CTXT(vm, ctxt);
+
+	BC_FUNC_HEADER(vm, err);
+
+	BCL_GROW_NUMS(ctxt);
+
+	// Clear and initialize the number.
+	bc_num_clear(BCL_NUM_NUM_NP(n));
+	bc_num_init(BCL_NUM_NUM_NP(n), BC_NUM_DEF_SIZE);
+
+	bcl_frandHelper(vm, BCL_NUM_NUM_NP(n), places);
+
+err:
+
+	BC_FUNC_FOOTER(vm, e);
+	BC_MAYBE_SETUP(ctxt, e, n, idx);
+
+	return idx;
+}
+
+BclNumber
+bcl_frand(size_t places)
+{
+	return bcl_ctxt_frand(NULL, places);
+}
+
+/**
+ * Helps bc_ifrand(). This is separate because error handling is easier that
+ * way.
+ * @param vm      The thread data.
+ * @param a       The limit for bc_num_irand().
+ * @param b       The return parameter.
+ * @param places  The number of decimal places to generate.
+ */
+static void
+bcl_ifrandHelper(BcVm* vm, BcNum* restrict a, BcNum* restrict b, size_t places)
+{
+	BcNum ir, fr;
+
+	// Clear the integer and fractional numbers.
+	bc_num_clear(&ir);
+	bc_num_clear(&fr);
+
+	// Initialize the integer and fractional numbers.
+	bc_num_init(&ir, BC_NUM_DEF_SIZE);
+	bc_num_init(&fr, BC_NUM_DEF_SIZE);
+
+	BC_SETJMP(vm, err);
+
+	bc_num_irand(a, &ir, &vm->rng);
+	bcl_frandHelper(vm, &fr, places);
+
+	bc_num_add(&ir, &fr, b, 0);
+
+err:
+
+	bc_num_free(&fr);
+	bc_num_free(&ir);
+	BC_LONGJMP_CONT(vm);
+}
+
+static BclNumber
+bcl_ifrand_helper(BclContext ctxt, BclNumber a, size_t places, bool destruct)
+{
+	BclError e = BCL_ERROR_NONE;
+	BclNum* aptr;
+	BclNum b;
+	BclNumber idx;
+	BcVm* vm;
+
+	BC_CHECK_CTXT(vm, ctxt);
+	BC_CHECK_NUM(ctxt, a);
+
+	BC_FUNC_HEADER(vm, err);
+
+	BCL_GROW_NUMS(ctxt);
+
+	assert(BCL_NO_GEN(a) < ctxt->nums.len);
+
+	aptr = BCL_NUM(ctxt, a);
+
+	assert(aptr != NULL && BCL_NUM_NUM(aptr) != NULL);
+
+	// Clear and initialize the number.
+	bc_num_clear(BCL_NUM_NUM_NP(b));
+	bc_num_init(BCL_NUM_NUM_NP(b), BC_NUM_DEF_SIZE);
+
+	bcl_ifrandHelper(vm, BCL_NUM_NUM(aptr), BCL_NUM_NUM_NP(b), places);
+
+err:
+
+	if (destruct)
+	{
+		// Eat the oprand.
+		bcl_num_dtor(ctxt, a, aptr);
+	}
+
+	BC_FUNC_FOOTER(vm, e);
+	BC_MAYBE_SETUP(ctxt, e, b, idx);
+
+	return idx;
+}
+
+BclNumber
+bcl_ifrand(BclNumber a, size_t places)
+{
+	return bcl_ifrand_helper(NULL, a, places, true);
+}
+
+BclNumber
+bcl_ctxt_ifrand(BclContext ctxt, BclNumber a, size_t places)
+{
+	return bcl_ifrand_helper(ctxt, a, places, true);
+}
+
+BclNumber
+bcl_ifrand_keep(BclNumber a, size_t places)
+{
+	return bcl_ifrand_helper(NULL, a, places, false);
+}
+
+BclNumber
+bcl_ctxt_ifrand_keep(BclContext ctxt, BclNumber a, size_t places)
+{
+	return bcl_ifrand_helper(ctxt, a, places, false);
+}
+
+static BclError
+bcl_rand_seedWithNum_helper(BclContext ctxt, BclNumber n, bool destruct)
+{
+	BclError e = BCL_ERROR_NONE;
+	BclNum* nptr;
+	BcVm* vm;
+
+	BC_CHECK_CTXT_ERR(vm, ctxt);
+	BC_CHECK_NUM_ERR(ctxt, n);
+
+	BC_FUNC_HEADER(vm, err);
+
+	assert(BCL_NO_GEN(n) < ctxt->nums.len);
+
+	nptr = BCL_NUM(ctxt, n);
+
+	assert(nptr != NULL && BCL_NUM_NUM(nptr) != NULL);
+
+	bc_num_rng(BCL_NUM_NUM(nptr), &vm->rng);
+
+err:
+
+	if (destruct)
+	{
+		// Eat the oprand.
+		bcl_num_dtor(ctxt, n, nptr);
+	}
+
+	BC_FUNC_FOOTER(vm, e);
+
+	return e;
+}
+
+BclError
+bcl_rand_seedWithNum(BclNumber n)
+{
+	return bcl_rand_seedWithNum_helper(NULL, n, true);
+}
+
+BclError
+bcl_ctxt_rand_seedWithNum(BclContext ctxt, BclNumber n)
+{
+	return bcl_rand_seedWithNum_helper(ctxt, n, true);
+}
+
+BclError
+bcl_rand_seedWithNum_keep(BclNumber n)
+{
+	return bcl_rand_seedWithNum_helper(NULL, n, false);
+}
+
+BclError
+bcl_ctxt_rand_seedWithNum_keep(BclContext ctxt, BclNumber n)
+{
+	return bcl_rand_seedWithNum_helper(ctxt, n, false);
+}
+
+BclError
+bcl_rand_seed(unsigned char seed[BCL_SEED_SIZE])
+{
+	BclError e = BCL_ERROR_NONE;
+	size_t i;
+	ulong vals[BCL_SEED_ULONGS];
+	BcVm* vm = bcl_getspecific();
+
+	BC_FUNC_HEADER(vm, err);
+
+	// Fill the array.
+	for (i = 0; i < BCL_SEED_SIZE; ++i)
+	{
+		ulong val = ((ulong) seed[i])
+		            << (((ulong) CHAR_BIT) * (i % sizeof(ulong)));
+		vals[i / sizeof(long)] = val;
+	}
+
+	bc_rand_seed(&vm->rng, vals[0], vals[1], vals[2], vals[3]);
+
+err:
+
+	BC_FUNC_FOOTER(vm, e);
+
+	return e;
+}
+
+void
+bcl_rand_reseed(void)
+{
+	BcVm* vm = bcl_getspecific();
+
+	bc_rand_srand(bc_vec_top(&vm->rng.v));
+}
+
+BclNumber
+bcl_ctxt_rand_seed2num(BclContext ctxt)
+{
+	BclError e = BCL_ERROR_NONE;
+	BclNum n;
+	BclNumber idx;
+	BcVm* vm;
+
+	BC_CHECK_CTXT(vm, ctxt);
+
+	BC_FUNC_HEADER(vm, err);
+
+	// Clear and initialize the number.
+	bc_num_clear(BCL_NUM_NUM_NP(n));
+	bc_num_init(BCL_NUM_NUM_NP(n), BC_NUM_DEF_SIZE);
+
+	bc_num_createFromRNG(BCL_NUM_NUM_NP(n), &vm->rng);
+
+err:
+
+	BC_FUNC_FOOTER(vm, e);
+	BC_MAYBE_SETUP(ctxt, e, n, idx);
+
+	return idx;
+}
+
+BclNumber
+bcl_rand_seed2num(void)
+{
+	return bcl_ctxt_rand_seed2num(NULL);
+}
+
+BclRandInt
+bcl_rand_int(void)
+{
+	BcVm* vm = bcl_getspecific();
+
+	return (BclRandInt) bc_rand_int(&vm->rng);
+}
+
+BclRandInt
+bcl_rand_bounded(BclRandInt bound)
+{
+	BcVm* vm = bcl_getspecific();
+
+	if (bound <= 1) return 0;
+	return (BclRandInt) bc_rand_bounded(&vm->rng, (BcRand) bound);
+}
+
+#endif // BC_ENABLE_EXTRA_MATH
+
+/**
+ * Reads a bytecode index from an expression's code and advances past it. This
+ * decodes what bc_vec_pushIndex() encodes, just like bc_program_index().
+ * @param code  The code.
+ * @param bgn   An in/out parameter; the index into the code that will be
+ *              updated.
+ * @return      The index at @a bgn in the code.
+ */
+static size_t
+bcl_expr_index(const char* restrict code, size_t* restrict bgn)
+{
+	uchar amt = (uchar) code[(*bgn)++], i = 0;
+	size_t res = 0;
+
+	for (; i < amt; ++i, ++(*bgn))
+	{
+		size_t temp = ((size_t) ((int) (uchar) code[*bgn]) & UCHAR_MAX);
+		res |= (temp << (i * CHAR_BIT));
+	}
+
+	return res;
+}
+
+/**
+ * Returns the precedence of an operator instruction while compiling an
+ * expression. Higher binds tighter. These match bc's.
+ * @param inst  The instruction.
+ * @return      The precedence of @a inst.
+ */
+static uchar
+bcl_expr_prec(uchar inst)
+{
+	switch (inst)
+	{
+		case BC_INST_NEG:
+		{
+			return 4;
+		}
+
+		case BC_INST_POWER:
+		{
+			return 3;
+		}
+
+		case BC_INST_MULTIPLY:
+		case BC_INST_DIVIDE:
+		case BC_INST_MODULUS:
+		{
+			return 2;
+		}
+
+		default:
+		{
+			assert(inst == BC_INST_PLUS || inst == BC_INST_MINUS);
+			return 1;
+		}
+	}
+}
+
+/**
+ * Pushes an instruction onto an expression's code and keeps track of how deep
+ * the evaluation stack will get.
+ * @param expr   The expression.
+ * @param inst   The instruction.
+ * @param depth  An in/out parameter for the current depth of the stack.
+ */
+static void
+bcl_expr_emit(BclExpr expr, uchar inst, size_t* depth)
+{
+	bc_vec_pushByte(&expr->code, inst);
+
+	// Binary operators take two operands and leave one. Unary operators do not
+	// change the depth.
+	if (inst != BC_INST_NEG && inst != BC_INST_SQRT) *depth -= 1;
+}
+
+/**
+ * Pops operators off of the operator stack and emits them until the top is a
+ * parenthesis or an operator that binds less tightly than @a prec.
+ * @param expr   The expression.
+ * @param ops    The operator stack.
+ * @param prec   The precedence of the incoming operator, or 0 to pop all
+ *               operators.
+ * @param right  True if the incoming operator is right associative.
+ * @param depth  An in/out parameter for the current depth of the stack.
+ */
+static void
+bcl_expr_popOps(BclExpr expr, BcVec* ops, uchar prec, bool right,
+                size_t* depth)
+{
+	while (ops->len)
+	{
+		uchar top = *((uchar*) bc_vec_top(ops));
+		uchar p;
+
+		if (top == BC_INST_SQRT || top == BC_INST_INVALID) break;
+
+		p = bcl_expr_prec(top);
+
+		if (p < prec || (p == prec && right)) break;
+
+		bcl_expr_emit(expr, top, depth);
+		bc_vec_pop(ops);
+	}
+}
+
+/**
+ * Compiles the text of an expression into postfix code, the same way that
+ * bc's parser does with its operator stack. Throws on an invalid expression.
+ * @param expr  The expression to compile into.
+ * @param text  The text of the expression.
+ * @param ops   The operator stack. It must be empty.
+ * @return      The maximum depth that the evaluation stack will get to.
+ */
+static size_t
+bcl_expr_parse(BclExpr expr, const char* restrict text, BcVec* ops)
+{
+	BcVm* vm = expr->ctxt->vm;
+	size_t depth = 0, max = 0, i, len;
+	bool operand = true;
+	uchar inst;
+	const char* s = text;
+	BcNum* num;
+
+	while (*s)
+	{
+		char c = *s;
+
+		if (isspace(c))
+		{
+			s += 1;
+			continue;
+		}
+
+		// bc lexes these as increment and decrement, which need variables that
+		// can be assigned to.
+		if (BC_ERR((c == '-' || c == '+') && s[1] == c))
+		{
+			bc_err(BC_ERR_PARSE_TOKEN);
+		}
+
+		if (operand)
+		{
+			if (c == '(' || c == '-')
+			{
+				// The open parenthesis is marked by BC_INST_INVALID.
+				inst = c == '(' ? BC_INST_INVALID : BC_INST_NEG;
+				bc_vec_push(ops, &inst);
+				s += 1;
+			}
+			else if (isdigit(c) || isupper(c) || c == '.')
+			{
+				bool pt = (c == '.');
+
+				// These are the same characters that bc_num_strValid() allows.
+				for (len = 1; isdigit(s[len]) || isupper(s[len]) ||
+				              (s[len] == '.' && !pt);
+				     ++len)
+				{
+					pt = pt || s[len] == '.';
+				}
+
+				bc_vec_string(&vm->out, len, s);
+
+				// The constant is parsed in the context's ibase, just like
+				// bcl_parse(), so that evaluation does not need to parse.
+				num = bc_vec_pushEmpty(&expr->consts);
+				bc_num_clear(num);
+				bc_num_init(num, BC_NUM_DEF_SIZE);
+				bc_num_parse(num, vm->out.v, (BcBigDig) expr->ctxt->ibase);
+
+				bc_vec_pushByte(&expr->code, BC_INST_NUM);
+				bc_vec_pushIndex(&expr->code, expr->consts.len - 1);
+
+				depth += 1;
+				operand = false;
+				s += len;
+			}
+			else if (islower(c))
+			{
+				BcVec* name;
+
+				for (len = 1;
+				     islower(s[len]) || isdigit(s[len]) || s[len] == '_'; ++len)
+				{
+					continue;
+				}
+
+				if (len == 4 && !strncmp(s, "sqrt", 4))
+				{
+					s += len;
+
+					while (isspace(*s))
+					{
+						s += 1;
+					}
+
+					if (BC_ERR(*s != '(')) bc_err(BC_ERR_PARSE_TOKEN);
+
+					// The function goes under its parenthesis so that it is
+					// emitted when the parenthesis is closed.
+					inst = BC_INST_SQRT;
+					bc_vec_push(ops, &inst);
+					continue;
+				}
+
+				// Look for the variable, and add it if it is new.
+				for (i = 0; i < expr->vars.len; ++i)
+				{
+					name = bc_vec_item(&expr->vars, i);
+					if (name->len == len + 1 && !strncmp(name->v, s, len))
+					{
+						break;
+					}
+				}
+
+				if (i == expr->vars.len)
+				{
+					name = bc_vec_pushEmpty(&expr->vars);
+					bc_vec_init(name, sizeof(char), BC_DTOR_NONE);
+					bc_vec_string(name, len, s);
+				}
+
+				bc_vec_pushByte(&expr->code, BC_INST_VAR);
+				bc_vec_pushIndex(&expr->code, i);
+
+				depth += 1;
+				operand = false;
+				s += len;
+			}
+			else if (c == ')') bc_err(BC_ERR_PARSE_TOKEN);
+			else bc_err(BC_ERR_PARSE_CHAR);
+		}
+		else if (c == ')')
+		{
+			bcl_expr_popOps(expr, ops, 0, false, &depth);
+
+			if (BC_ERR(!ops->len)) bc_err(BC_ERR_PARSE_TOKEN);
+
+			assert(*((uchar*) bc_vec_top(ops)) == BC_INST_INVALID);
+
+			bc_vec_pop(ops);
+
+			// If this closes a function call, the function goes now.
+			if (ops->len && *((uchar*) bc_vec_top(ops)) == BC_INST_SQRT)
+			{
+				bcl_expr_emit(expr, BC_INST_SQRT, &depth);
+				bc_vec_pop(ops);
+			}
+
+			s += 1;
+		}
+		else
+		{
+			switch (c)
+			{
+				case '^':
+				{
+					inst = BC_INST_POWER;
+					break;
+				}
+
+				case '*':
+				{
+					inst = BC_INST_MULTIPLY;
+					break;
+				}
+
+				case '/':
+				{
+					inst = BC_INST_DIVIDE;
+					break;
+				}
+
+				case '%':
+				{
+					inst = BC_INST_MODULUS;
+					break;
+				}
+
+				case '+':
+				{
+					inst = BC_INST_PLUS;
+					break;
+				}
+
+				case '-':
+				{
+					inst = BC_INST_MINUS;
+					break;
+				}
+
+				default:
+				{
+					bc_err(BC_ERR_PARSE_CHAR);
+				}
+			}
+
+			// Power is the only right associative operator.
+			bcl_expr_popOps(expr, ops, bcl_expr_prec(inst),
+			                inst == BC_INST_POWER, &depth);
+
+			bc_vec_push(ops, &inst);
+
+			operand = true;
+			s += 1;
+		}
+
+		max = BC_MAX(max, depth);
+	}
+
+	if (BC_ERR(operand)) bc_err(BC_ERR_PARSE_EOF);
+
+	bcl_expr_popOps(expr, ops, 0, false, &depth);
+
+	// Any leftover operator must be an unclosed parenthesis or function.
+	if (BC_ERR(ops->len)) bc_err(BC_ERR_PARSE_EOF);
+
+	assert(depth == 1);
+
+	return max;
+}
+
+BclError
+bcl_ctxt_expr_compile(BclContext ctxt, const char* restrict text,
+                      BclExpr* expr)
+{
+	BclError e = BCL_ERROR_NONE;
+	BclExpr ex = NULL;
+	BcVec ops;
+	size_t i, max;
+	BcVm* vm;
+
+	BC_CHECK_CTXT_ERR(vm, ctxt);
+
+	assert(text != NULL && expr != NULL);
+
+	ops.v = NULL;
+
+	BC_FUNC_HEADER(vm, err);
+
+	// We want the expression to be free of any interference of other parties,
+	// so malloc() is appropriate here.
+	ex = bc_vm_malloc(sizeof(BclExpression));
+
+	// Everything is NULL so that the error path knows what to free.
+	memset(ex, 0, sizeof(BclExpression));
+
+	ex->ctxt = ctxt;
+
+	bc_vec_init(&ex->code, sizeof(uchar), BC_DTOR_NONE);
+	bc_vec_init(&ex->consts, sizeof(BcNum), BC_DTOR_NUM);
+	bc_vec_init(&ex->vars, sizeof(BcVec), BC_DTOR_VEC);
+	bc_vec_init(&ex->temps, sizeof(BcNum), BC_DTOR_NUM);
+	bc_vec_init(&ex->stack, sizeof(BcNum*), BC_DTOR_NONE);
+	bc_vec_init(&ops, sizeof(uchar), BC_DTOR_NONE);
+
+	max = bcl_expr_parse(ex, text, &ops);
+
+	// Allocate the stack and two temporaries for each level of it now so that
+	// evaluation does not have to.
+	bc_vec_grow(&ex->stack, max);
+
+	for (i = 0; i < 2 * max; ++i)
+	{
+		BcNum* n = bc_vec_pushEmpty(&ex->temps);
+		bc_num_clear(n);
+		bc_num_init(n, BC_NUM_DEF_SIZE);
+	}
+
+err:
+
+	if (ops.v != NULL) bc_vec_free(&ops);
+
+	if (BC_ERR(vm->err))
+	{
+		bcl_expr_free(ex);
+		ex = NULL;
+	}
+
+	*expr = ex;
+
+	BC_FUNC_FOOTER(vm, e);
+
+	return e;
+}
+
+BclError
+bcl_expr_compile(const char* restrict text, BclExpr* expr)
+{
+	return bcl_ctxt_expr_compile(NULL, text, expr);
+}
+
+size_t
+bcl_expr_nvars(BclExpr expr)
+{
+	return expr->vars.len;
+}
+
+const char*
+bcl_expr_var(BclExpr expr, size_t i)
+{
+	if (i >= expr->vars.len) return NULL;
+
+	return ((BcVec*) bc_vec_item(&expr->vars, i))->v;
+}
+
+/**
+ * Returns the temporary to put the result of an operation in. Each level of
+ * the stack has two, and the one that is not the operand at that level is
+ * used, so the result never aliases an operand. That lets the operators reuse
+ * the temporary's memory instead of reallocating.
+ * @param expr  The expression.
+ * @param lvl   The level of the stack that the result goes to.
+ * @return      The temporary for the result.
+ */
+static BcNum*
+bcl_expr_temp(BclExpr expr, size_t lvl)
+{
+	BcNum* t = bc_vec_item(&expr->temps, 2 * lvl);
+	BcNum* operand = *((BcNum**) bc_vec_item(&expr->stack, lvl));
+
+	return t == operand ? t + 1 : t;
+}
+
+BclNumber
+bcl_expr_eval(BclExpr expr, const BclNumber* vals, size_t n)
+{
+	BclError e = BCL_ERROR_NONE;
+	BclContext ctxt = expr->ctxt;
+	const char* code = expr->code.v;
+	BcNum* a;
+	BcNum* b;
+	BcNum* res;
+	BcNum root;
+	BclNum num;
+	BclNumber idx;
+	size_t i, ip;
+	BcVm* vm;
+
+	BC_CHECK_CTXT(vm, ctxt);
+
+	if (BC_ERR(n != expr->vars.len))
+	{
+		idx.i = 0 - (size_t) BCL_ERROR_INVALID_NUM;
+		return idx;
+	}
+
+	assert(!n || vals != NULL);
+
+	for (i = 0; i < n; ++i)
+	{
+		BC_CHECK_NUM(ctxt, vals[i]);
+	}
+
+	bc_num_clear(BCL_NUM_NUM_NP(num));
+
+	BC_FUNC_HEADER(vm, err);
+
+	BCL_GROW_NUMS(ctxt);
+
+	bc_vec_popAll(&expr->stack);
+
+	for (ip = 0; ip < expr->code.len;)
+	{
+		uchar inst = (uchar) code[ip++];
+
+		switch (inst)
+		{
+			case BC_INST_NUM:
+			{
+				a = bc_vec_item(&expr->consts, bcl_expr_index(code, &ip));
+				bc_vec_push(&expr->stack, &a);
+				break;
+			}
+
+			case BC_INST_VAR:
+			{
+				i = bcl_expr_index(code, &ip);
+
+				a = BCL_NUM_NUM(BCL_NUM(ctxt, vals[i]));
+				bc_vec_push(&expr->stack, &a);
+				break;
+			}
+
+			case BC_INST_NEG:
+			{
+				a = *((BcNum**) bc_vec_top(&expr->stack));
+				res = bcl_expr_temp(expr, expr->stack.len - 1);
+
+				bc_num_copy(res, a);
+				if (BC_NUM_NONZERO(res)) BC_NUM_NEG_TGL(res);
+
+				*((BcNum**) bc_vec_top(&expr->stack)) = res;
+				break;
+			}
+
+			case BC_INST_SQRT:
+			{
+				a = *((BcNum**) bc_vec_top(&expr->stack));
+				res = bcl_expr_temp(expr, expr->stack.len - 1);
+
+				// Square root expects its result to not be allocated, so swap
+				// it into the temporary afterward.
+				bc_num_sqrt(a, &root, ctxt->scale);
+
+				BC_SIG_LOCK;
+
+				bc_num_free(res);
+				memcpy(res, &root, sizeof(BcNum));
+
+				BC_SIG_UNLOCK;
+
+				*((BcNum**) bc_vec_top(&expr->stack)) = res;
+				break;
+			}
+
+			default:
+			{
+				assert(inst >= BC_INST_POWER && inst <= BC_INST_MINUS);
+
+				b = *((BcNum**) bc_vec_top(&expr->stack));
+				bc_vec_pop(&expr->stack);
+				a = *((BcNum**) bc_vec_top(&expr->stack));
+				res = bcl_expr_temp(expr, expr->stack.len - 1);
+
+				bc_program_ops[inst - BC_INST_POWER](a, b, res, ctxt->scale);
+
+				*((BcNum**) bc_vec_top(&expr->stack)) = res;
+				break;
+			}
+		}
+	}
+
+	assert(expr->stack.len == 1);
+
+	bc_num_createCopy(BCL_NUM_NUM_NP(num),
+	                  *((BcNum**) bc_vec_top(&expr->stack)));
+
+err:
+
+	BC_FUNC_FOOTER(vm, e);
+	BC_MAYBE_SETUP(ctxt, e, num, idx);
+
+	return idx;
+}
+
+void
+bcl_expr_free(BclExpr expr)
+{
+	if (expr == NULL) return;
+
+	if (expr->code.v != NULL) bc_vec_free(&expr->code);
+	if (expr->consts.v != NULL) bc_vec_free(&expr->consts);
+	if (expr->vars.v != NULL) bc_vec_free(&expr->vars);
+	if (expr->temps.v != NULL) bc_vec_free(&expr->temps);
+	if (expr->stack.v != NULL) bc_vec_free(&expr->stack);
+
+	free(expr);
+}
+
+
+/// The worker pool, or NULL if it has not been started.
+static BclPool* pool = NULL;
+
+/**
+ * Locks the worker pool.
+ */
+static void
+bcl_pool_lock(void)
+{
+#ifndef _WIN32
+	pthread_mutex_lock(&pool->lock);
+#else // _WIN32
+	EnterCriticalSection(&pool->lock);
+#endif // _WIN32
+}
+
+/**
+ * Unlocks the worker pool.
+ */
+static void
+bcl_pool_unlock(void)
+{
+#ifndef _WIN32
+	pthread_mutex_unlock(&pool->lock);
+#else // _WIN32
+	LeaveCriticalSection(&pool->lock);
+#endif // _WIN32
+}
+
+/**
+ * Waits on a condition of the worker pool. The pool must be locked.
+ * @param c  The condition to wait on.
+ */
+static void
+bcl_pool_wait(BclCond* c)
+{
+#ifndef _WIN32
+	pthread_cond_wait(c, &pool->lock);
+#else // _WIN32
+	SleepConditionVariableCS(c, &pool->lock, INFINITE);
+#endif // _WIN32
+}
+
+/**
+ * Wakes one thread that is waiting on a condition of the worker pool.
+ * @param c  The condition to signal.
+ */
+static void
+bcl_pool_signal(BclCond* c)
+{
+#ifndef _WIN32
+	pthread_cond_signal(c);
+#else // _WIN32
+	WakeConditionVariable(c);
+#endif // _WIN32
+}
+
+/**
+ * Wakes all threads that are waiting on a condition of the worker pool.
+ * @param c  The condition to broadcast.
+ */
+static void
+bcl_pool_broadcast(BclCond* c)
+{
+#ifndef _WIN32
+	pthread_cond_broadcast(c);
+#else // _WIN32
+	WakeAllConditionVariable(c);
+#endif // _WIN32
+}
+
+/**
+ * Frees a future and everything that it still owns.
+ * @param f  The future to free.
+ */
+static void
+bcl_future_free(BclFut* f)
+{
+	size_t i;
+
+	for (i = 0; i < f->nargs; ++i)
+	{
+		bcl_num_destruct(&f->args[i]);
+	}
+
+	bcl_num_destruct(&f->res);
+	free(f->str);
+	free(f);
+}
+
+/**
+ * Moves the operands of a job into a worker's context.
+ * @param ctxt  The worker's context.
+ * @param f     The future of the job.
+ * @param n     An out parameter for the operands in @a ctxt.
+ * @return      An error code, if any.
+ */
+static BclError
+bcl_pool_give(BclContext ctxt, BclFut* f, BclNumber* n)
+{
+	BclError e = BCL_ERROR_NONE;
+	size_t i;
+	BcVm* vm = ctxt->vm;
+
+	BC_FUNC_HEADER(vm, err);
+
+	// After this, the inserts cannot fail.
+	bc_vec_grow(&ctxt->nums, f->nargs);
+
+	for (i = 0; i < f->nargs; ++i)
+	{
+		n[i] = bcl_num_insert(ctxt, &f->args[i]);
+	}
+
+	f->nargs = 0;
+
+err:
+
+	BC_FUNC_FOOTER(vm, e);
+
+	return e;
+}
+
+/**
+ * Moves a number out of a worker's context without freeing it.
+ * @param ctxt  The worker's context.
+ * @param n     The number to move.
+ * @param res   The place to move the number to.
+ * @return      An error code, if any.
+ */
+static BclError
+bcl_pool_take(BclContext ctxt, BclNumber n, BclNum* res)
+{
+	BclError e = BCL_ERROR_NONE;
+	BclNum* ptr;
+	BcVm* vm = ctxt->vm;
+
+	BC_FUNC_HEADER(vm, err);
+
+	ptr = BCL_NUM(ctxt, n);
+
+	// Mark the spot free first; if that fails, the number is left alone.
+	BCL_CLEAR_GEN(n);
+	bc_vec_push(&ctxt->free_nums, &n);
+
+	memcpy(res, ptr, sizeof(BclNum));
+	bc_num_clear(BCL_NUM_NUM(ptr));
+
+err:
+
+	BC_FUNC_FOOTER(vm, e);
+
+	return e;
+}
+
+/**
+ * Runs a job on a worker. The operands are moved into the worker's context,
+ * and the operation consumes them.
+ * @param ctxt  The worker's context.
+ * @param f     The future of the job.
+ */
+static void
+bcl_pool_run(BclContext ctxt, BclFut* f)
+{
+	BclNumber n[3];
+	BclNumber r;
+	BcVm* vm = ctxt->vm;
+
+	ctxt->scale = f->scale;
+	ctxt->ibase = f->ibase;
+	ctxt->obase = f->obase;
+	vm->leading_zeroes = f->leading_zeroes;
+	vm->digit_clamp = f->digit_clamp;
+
+	f->err = bcl_pool_give(ctxt, f, n);
+	if (BC_ERR(f->err != BCL_ERROR_NONE)) return;
+
+	switch (f->job)
+	{
+		case BCL_JOB_MUL:
+		{
+			r = bcl_ctxt_mul(ctxt, n[0], n[1]);
+			break;
+		}
+
+		case BCL_JOB_DIV:
+		{
+			r = bcl_ctxt_div(ctxt, n[0], n[1]);
+			break;
+		}
+
+		case BCL_JOB_POW:
+		{
+			r = bcl_ctxt_pow(ctxt, n[0], n[1]);
+			break;
+		}
+
+		case BCL_JOB_SQRT:
+		{
+			r = bcl_ctxt_sqrt(ctxt, n[0]);
+			break;
+		}
+
+		case BCL_JOB_MODEXP:
+		{
+			r = bcl_ctxt_modexp(ctxt, n[0], n[1], n[2]);
+			break;
+		}
+
+		case BCL_JOB_PARSE:
+		{
+			r = bcl_ctxt_parse(ctxt, f->str);
+
+			free(f->str);
+			f->str = NULL;
+
+			break;
+		}
+
+		case BCL_JOB_STRING:
+		default:
+		{
+			assert(f->job == BCL_JOB_STRING);
+
+			// The string is the result, so there is nothing to move.
+			f->str = bcl_ctxt_string(ctxt, n[0]);
+			if (BC_ERR(f->str == NULL)) f->err = BCL_ERROR_FATAL_ALLOC_ERR;
+
+			return;
+		}
+	}
+
+	f->err = bcl_ctxt_err(ctxt, r);
+	if (BC_ERR(f->err != BCL_ERROR_NONE)) return;
+
+	f->err = bcl_pool_take(ctxt, r, &f->res);
+}
+
+/**
+ * The function that the worker threads run. Each worker has its own thread
+ * data and context, and it runs jobs from the queue until the pool is stopped
+ * and the queue is empty.
+ * @param arg  Unused.
+ * @return     Nothing of importance.
+ */
+#ifndef _WIN32
+static void*
+bcl_pool_worker(void* arg)
+#else // _WIN32
+static DWORD WINAPI
+bcl_pool_worker(LPVOID arg)
+#endif // _WIN32
+{
+	BclContext ctxt = NULL;
+	BclError e;
+	BclFut* f;
+
+	BC_UNUSED(arg);
+
+	e = bcl_init();
+
+	if (BC_NO_ERR(e == BCL_ERROR_NONE))
+	{
+		ctxt = bcl_ctxt_create();
+
+		if (BC_ERR(ctxt == NULL))
+		{
+			e = BCL_ERROR_FATAL_ALLOC_ERR;
+			bcl_free();
+		}
+	}
+
+	bcl_pool_lock();
+
+	// Report that this worker has started, and how.
+	pool->started += 1;
+	if (BC_ERR(e != BCL_ERROR_NONE)) pool->err = e;
+	bcl_pool_broadcast(&pool->done);
+
+	while (ctxt != NULL)
+	{
+		while (pool->head == NULL && !pool->stop)
+		{
+			bcl_pool_wait(&pool->work);
+		}
+
+		f = pool->head;
+		if (f == NULL) break;
+
+		pool->head = f->next;
+		if (pool->head == NULL) pool->tail = NULL;
+
+		f->state = BCL_FUT_RUNNING;
+
+		bcl_pool_unlock();
+
+		bcl_pool_run(ctxt, f);
+
+		bcl_pool_lock();
+
+		f->state = BCL_FUT_DONE;
+
+		// Nobody will collect a cancelled future.
+		if (f->cancelled) bcl_future_free(f);
+		else bcl_pool_broadcast(&pool->done);
+	}
+
+	bcl_pool_unlock();
+
+	if (ctxt != NULL)
+	{
+		bcl_ctxt_free(ctxt);
+		bcl_free();
+	}
+
+	return 0;
+}
+
+BclError
+bcl_pool_start(size_t threads)
+{
+	BclError e = BCL_ERROR_NONE;
+	size_t i;
+
+	assert(tls != NULL);
+
+	if (pool != NULL) return e;
+
+	if (!threads) threads = 1;
+
+	pool = malloc(sizeof(BclPool));
+	if (BC_ERR(pool == NULL)) return BCL_ERROR_FATAL_ALLOC_ERR;
+
+	memset(pool, 0, sizeof(BclPool));
+
+	pool->threads = malloc(threads * sizeof(BclThread));
+	if (BC_ERR(pool->threads == NULL))
+	{
+		free(pool);
+		pool = NULL;
+		return BCL_ERROR_FATAL_ALLOC_ERR;
+	}
+
+#ifndef _WIN32
+
+	// These can only fail for lack of resources, and then the threads below
+	// fail to start too.
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_cond_init(&pool->work, NULL);
+	pthread_cond_init(&pool->done, NULL);
+
+#else // _WIN32
+
+	InitializeCriticalSection(&pool->lock);
+	InitializeConditionVariable(&pool->work);
+	InitializeConditionVariable(&pool->done);
+
+#endif // _WIN32
+
+	for (i = 0; i < threads; ++i)
+	{
+#ifndef _WIN32
+
+		int r = pthread_create(pool->threads + i, NULL, bcl_pool_worker, NULL);
+
+		if (BC_ERR(r != 0))
+		{
+			e = BCL_ERROR_FATAL_ALLOC_ERR;
+			break;
+		}
+
+#else // _WIN32
+
+		pool->threads[i] = CreateThread(NULL, 0, bcl_pool_worker, NULL, 0,
+		                                NULL);
+
+		if (BC_ERR(pool->threads[i] == NULL))
+		{
+			e = BCL_ERROR_FATAL_ALLOC_ERR;
+			break;
+		}
+
+#endif // _WIN32
+
+		pool->nthreads += 1;
+	}
+
+	// Wait for the workers to start so that their errors can be reported.
+	bcl_pool_lock();
+
+	while (pool->started < pool->nthreads)
+	{
+		bcl_pool_wait(&pool->done);
+	}
+
+	if (e == BCL_ERROR_NONE) e = pool->err;
+
+	bcl_pool_unlock();
+
+	if (BC_ERR(e != BCL_ERROR_NONE)) bcl_pool_end();
+
+	return e;
+}
+
+void
+bcl_pool_end(void)
+{
+	size_t i;
+
+	if (pool == NULL) return;
+
+	bcl_pool_lock();
+
+	pool->stop = true;
+	bcl_pool_broadcast(&pool->work);
+
+	bcl_pool_unlock();
+
+	for (i = 0; i < pool->nthreads; ++i)
+	{
+#ifndef _WIN32
+		pthread_join(pool->threads[i], NULL);
+#else // _WIN32
+		WaitForSingleObject(pool->threads[i], INFINITE);
+		CloseHandle(pool->threads[i]);
+#endif // _WIN32
+	}
+
+#ifndef _WIN32
+
+	pthread_cond_destroy(&pool->done);
+	pthread_cond_destroy(&pool->work);
+	pthread_mutex_destroy(&pool->lock);
+
+#else // _WIN32
+
+	DeleteCriticalSection(&pool->lock);
+
+#endif // _WIN32
+
+	free(pool->threads);
+	free(pool);
+	pool = NULL;
+}
+
+/**
+ * Submits a job to the worker pool.
+ * @param ctxt  The context, or NULL for the current context.
+ * @param job   The job.
+ * @param args  The operands. They are copied, not consumed.
+ * @param n     The number of operands.
+ * @param val   The string to parse, or NULL if the job does not parse.
+ * @param f     An out parameter for the future of the job.
+ * @return      An error code, if any.
+ */
+static BclError
+bcl_async(BclContext ctxt, BclJob job, const BclNumber* args, size_t n,
+          const char* restrict val, BclFuture* f)
+{
+	BclError e = BCL_ERROR_NONE;
+	BclFut* fut = NULL;
+	BclNum* ptr;
+	size_t i;
+	BcVm* vm;
+
+	assert(pool != NULL && f != NULL);
+
+	*f = NULL;
+
+	BC_CHECK_CTXT_ERR(vm, ctxt);
+
+	for (i = 0; i < n; ++i)
+	{
+		BC_CHECK_NUM_ERR(ctxt, args[i]);
+	}
+
+	BC_FUNC_HEADER(vm, err);
+
+	fut = bc_vm_malloc(sizeof(BclFut));
+
+	// This clears the numbers and the string so that the future can be freed
+	// no matter how far this gets.
+	memset(fut, 0, sizeof(BclFut));
+
+	// The worker cannot use the caller's context, so it gets copies.
+	for (i = 0; i < n; ++i)
+	{
+		ptr = BCL_NUM(ctxt, args[i]);
+
+		// A shared number does not need to be copied; the worker can use
+		// another view of it.
+		if (BCL_IS_SHARED(BCL_NUM_NUM(ptr)))
+		{
+			memcpy(BCL_NUM_NUM(&fut->args[i]), BCL_NUM_NUM(ptr), sizeof(BcNum));
+			BCL_REFS_INC(BCL_SHARED(BCL_NUM_NUM(ptr))->refs);
+		}
+		else bc_num_createCopy(BCL_NUM_NUM(&fut->args[i]), BCL_NUM_NUM(ptr));
+
+		fut->nargs += 1;
+	}
+
+	if (val != NULL) fut->str = bc_vm_strdup(val);
+
+	fut->job = job;
+	fut->scale = ctxt->scale;
+	fut->ibase = ctxt->ibase;
+	fut->obase = ctxt->obase;
+	fut->leading_zeroes = vm->leading_zeroes;
+	fut->digit_clamp = vm->digit_clamp;
+	fut->state = BCL_FUT_QUEUED;
+
+err:
+
+	BC_FUNC_FOOTER(vm, e);
+
+	if (BC_ERR(e != BCL_ERROR_NONE))
+	{
+		if (fut != NULL) bcl_future_free(fut);
+		return e;
+	}
+
+	bcl_pool_lock();
+
+	if (pool->tail != NULL) pool->tail->next = fut;
+	else pool->head = fut;
+
+	pool->tail = fut;
+
+	bcl_pool_signal(&pool->work);
+
+	bcl_pool_unlock();
+
+	*f = fut;
+
+	return e;
+}
+
+BclError
+bcl_async_mul(BclNumber a, BclNumber b, BclFuture* f)
+{
+	BclNumber args[2] = { a, b };
+	return bcl_async(NULL, BCL_JOB_MUL, args, 2, NULL, f);
+}
+
+BclError
+bcl_ctxt_async_mul(BclContext ctxt, BclNumber a, BclNumber b, BclFuture* f)
+{
+	BclNumber args[2] = { a, b };
+	return bcl_async(ctxt, BCL_JOB_MUL, args, 2, NULL, f);
+}
+
+BclError
+bcl_async_div(BclNumber a, BclNumber b, BclFuture* f)
+{
+	BclNumber args[2] = { a, b };
+	return bcl_async(NULL, BCL_JOB_DIV, args, 2, NULL, f);
+}
+
+BclError
+bcl_ctxt_async_div(BclContext ctxt, BclNumber a, BclNumber b, BclFuture* f)
+{
+	BclNumber args[2] = { a, b };
+	return bcl_async(ctxt, BCL_JOB_DIV, args, 2, NULL, f);
+}
 
-	bc_num_irand(BCL_NUM_NUM(aptr), BCL_NUM_NUM_NP(b), &vm->rng);
+BclError
+bcl_async_pow(BclNumber a, BclNumber b, BclFuture* f)
+{
+	BclNumber args[2] = { a, b };
+	return bcl_async(NULL, BCL_JOB_POW, args, 2, NULL, f);
+}
 
-err:
+BclError
+bcl_ctxt_async_pow(BclContext ctxt, BclNumber a, BclNumber b, BclFuture* f)
+{
+	BclNumber args[2] = { a, b };
+	return bcl_async(ctxt, BCL_JOB_POW, args, 2, NULL, f);
+}
 
-	if (destruct)
-	{
-		// Eat the operand.
-		bcl_num_dtor(ctxt, a, aptr);
-	}
+BclError
+bcl_async_sqrt(BclNumber a, BclFuture* f)
+{
+	return bcl_async(NULL, BCL_JOB_SQRT, &a, 1, NULL, f);
+}
 
-	BC_FUNC_FOOTER(vm, e);
-	BC_MAYBE_SETUP(ctxt, e, b, idx);
+BclError
+bcl_ctxt_async_sqrt(BclContext ctxt, BclNumber a, BclFuture* f)
+{
+	return bcl_async(ctxt, BCL_JOB_SQRT, &a, 1, NULL, f);
+}
 
-	return idx;
+BclError
+bcl_async_modexp(BclNumber a, BclNumber b, BclNumber c, BclFuture* f)
+{
+	BclNumber args[3] = { a, b, c };
+	return bcl_async(NULL, BCL_JOB_MODEXP, args, 3, NULL, f);
 }
 
-BclNumber
-bcl_irand(BclNumber a)
+BclError
+bcl_ctxt_async_modexp(BclContext ctxt, BclNumber a, BclNumber b, BclNumber c,
+                      BclFuture* f)
 {
-	return bcl_irand_helper(a, true);
+	BclNumber args[3] = { a, b, c };
+	return bcl_async(ctxt, BCL_JOB_MODEXP, args, 3, NULL, f);
 }
 
-BclNumber
-bcl_irand_keep(BclNumber a)
+BclError
+bcl_async_parse(const char* restrict val, BclFuture* f)
 {
-	return bcl_irand_helper(a, false);
+	assert(val != NULL);
+	return bcl_async(NULL, BCL_JOB_PARSE, NULL, 0, val, f);
 }
 
-/**
- * Helps bcl_frand(). This is separate because the error handling is easier that
- * way. It is also easier to do ifrand that way.
- * @param b       The return parameter.
- * @param places  The number of decimal places to generate.
- */
-static void
-bcl_frandHelper(BcNum* restrict b, size_t places)
+BclError
+bcl_ctxt_async_parse(BclContext ctxt, const char* restrict val, BclFuture* f)
 {
-	BcNum exp, pow, ten;
-	BcDig exp_digs[BC_NUM_BIGDIG_LOG10];
-	BcDig ten_digs[BC_NUM_BIGDIG_LOG10];
-	BcVm* vm = bcl_getspecific();
+	assert(val != NULL);
+	return bcl_async(ctxt, BCL_JOB_PARSE, NULL, 0, val, f);
+}
 
-	// Set up temporaries.
-	bc_num_setup(&exp, exp_digs, BC_NUM_BIGDIG_LOG10);
-	bc_num_setup(&ten, ten_digs, BC_NUM_BIGDIG_LOG10);
+BclError
+bcl_async_string(BclNumber n, BclFuture* f)
+{
+	return bcl_async(NULL, BCL_JOB_STRING, &n, 1, NULL, f);
+}
 
-	ten.num[0] = 10;
-	ten.len = 1;
+BclError
+bcl_ctxt_async_string(BclContext ctxt, BclNumber n, BclFuture* f)
+{
+	return bcl_async(ctxt, BCL_JOB_STRING, &n, 1, NULL, f);
+}
 
-	bc_num_bigdig2num(&exp, (BcBigDig) places);
+bool
+bcl_future_done(BclFuture f)
+{
+	bool done;
 
-	// Clear the temporary that might need to grow.
-	bc_num_clear(&pow);
+	bcl_pool_lock();
 
-	// Initialize the temporary that might need to grow.
-	bc_num_init(&pow, bc_num_powReq(&ten, &exp, 0));
+	done = (f->state == BCL_FUT_DONE);
 
-	BC_SETJMP(vm, err);
+	bcl_pool_unlock();
 
-	// Generate the number.
-	bc_num_pow(&ten, &exp, &pow, 0);
-	bc_num_irand(&pow, b, &vm->rng);
+	return done;
+}
 
-	// Make the number entirely fraction.
-	bc_num_shiftRight(b, places);
+BclError
+bcl_future_wait(BclFuture f)
+{
+	bcl_pool_lock();
 
-err:
+	while (f->state != BCL_FUT_DONE)
+	{
+		bcl_pool_wait(&pool->done);
+	}
 
-	bc_num_free(&pow);
-	BC_LONGJMP_CONT(vm);
+	bcl_pool_unlock();
+
+	// The worker is done with the future, so this is safe.
+	return f->err;
 }
 
 BclNumber
-bcl_frand(size_t places)
+bcl_ctxt_future_num(BclContext ctxt, BclFuture f)
 {
-	BclError e = BCL_ERROR_NONE;
-	BclNum n;
+	BclError e;
 	BclNumber idx;
-	BclContext ctxt;
-	BcVm* vm = bcl_getspecific();
+	BcVm* vm;
 
-	BC_CHECK_CTXT(vm, ctxt);
+	assert(f->job != BCL_JOB_STRING);
 
-	BC_FUNC_HEADER(vm, err);
+	e = bcl_future_wait(f);
 
-	BCL_GROW_NUMS(ctxt);
+	BCL_CTXT(vm, ctxt);
 
-	// Clear and initialize the number.
-	bc_num_clear(BCL_NUM_NUM_NP(n));
-	bc_num_init(BCL_NUM_NUM_NP(n), BC_NUM_DEF_SIZE);
+	if (BC_ERR(ctxt == NULL)) e = BCL_ERROR_INVALID_CONTEXT;
+
+	if (BC_ERR(e != BCL_ERROR_NONE))
+	{
+		bcl_future_free(f);
+		idx.i = 0 - (size_t) e;
+		return idx;
+	}
+
+	BC_FUNC_HEADER(vm, err);
 
-	bcl_frandHelper(BCL_NUM_NUM_NP(n), places);
+	BCL_GROW_NUMS(ctxt);
 
 err:
 
 	BC_FUNC_FOOTER(vm, e);
-	BC_MAYBE_SETUP(ctxt, e, n, idx);
+	BC_MAYBE_SETUP(ctxt, e, f->res, idx);
+
+	// The result either belongs to the context now or was freed.
+	bc_num_clear(BCL_NUM_NUM(&f->res));
+	bcl_future_free(f);
 
 	return idx;
 }
 
-/**
- * Helps bc_ifrand(). This is separate because error handling is easier that
- * way.
- * @param a       The limit for bc_num_irand().
- * @param b       The return parameter.
- * @param places  The number of decimal places to generate.
- */
-static void
-bcl_ifrandHelper(BcNum* restrict a, BcNum* restrict b, size_t places)
+BclNumber
+bcl_future_num(BclFuture f)
 {
-	BcNum ir, fr;
-	BcVm* vm = bcl_getspecific();
-
-	// Clear the integer and fractional numbers.
-	bc_num_clear(&ir);
-	bc_num_clear(&fr);
-
-	// Initialize the integer and fractional numbers.
-	bc_num_init(&ir, BC_NUM_DEF_SIZE);
-	bc_num_init(&fr, BC_NUM_DEF_SIZE);
-
-	BC_SETJMP(vm, err);
-
-	bc_num_irand(a, &ir, &vm->rng);
-	bcl_frandHelper(&fr, places);
-
-	bc_num_add(&ir, &fr, b, 0);
-
-err:
-
-	bc_num_free(&fr);
-	bc_num_free(&ir);
-	BC_LONGJMP_CONT(vm);
+	return bcl_ctxt_future_num(NULL, f);
 }
 
-static BclNumber
-bcl_ifrand_helper(BclNumber a, size_t places, bool destruct)
+char*
+bcl_future_string(BclFuture f)
 {
-	BclError e = BCL_ERROR_NONE;
-	BclNum* aptr;
-	BclNum b;
-	BclNumber idx;
-	BclContext ctxt;
-	BcVm* vm = bcl_getspecific();
-
-	BC_CHECK_CTXT(vm, ctxt);
-	BC_CHECK_NUM(ctxt, a);
+	char* str;
 
-	BC_FUNC_HEADER(vm, err);
+	assert(f->job == BCL_JOB_STRING);
 
-	BCL_GROW_NUMS(ctxt);
+	bcl_future_wait(f);
 
-	assert(BCL_NO_GEN(a) < ctxt->nums.len);
+	str = f->str;
+	f->str = NULL;
 
-	aptr = BCL_NUM(ctxt, a);
+	bcl_future_free(f);
 
-	assert(aptr != NULL && BCL_NUM_NUM(aptr) != NULL);
+	return str;
+}
 
-	// Clear and initialize the number.
-	bc_num_clear(BCL_NUM_NUM_NP(b));
-	bc_num_init(BCL_NUM_NUM_NP(b), BC_NUM_DEF_SIZE);
+void
+bcl_future_cancel(BclFuture f)
+{
+	BclFut* prev = NULL;
+	BclFut* cur;
+	bool running;
 
-	bcl_ifrandHelper(BCL_NUM_NUM(aptr), BCL_NUM_NUM_NP(b), places);
+	bcl_pool_lock();
 
-err:
+	running = (f->state == BCL_FUT_RUNNING);
 
-	if (destruct)
+	// A running job cannot be interrupted, so the worker frees its future
+	// when it finishes.
+	if (running) f->cancelled = true;
+	else if (f->state == BCL_FUT_QUEUED)
 	{
-		// Eat the oprand.
-		bcl_num_dtor(ctxt, a, aptr);
-	}
+		for (cur = pool->head; cur != f; cur = cur->next)
+		{
+			prev = cur;
+		}
 
-	BC_FUNC_FOOTER(vm, e);
-	BC_MAYBE_SETUP(ctxt, e, b, idx);
+		if (prev == NULL) pool->head = f->next;
+		else prev->next = f->next;
 
-	return idx;
-}
+		if (pool->tail == f) pool->tail = prev;
+	}
 
-BclNumber
-bcl_ifrand(BclNumber a, size_t places)
-{
-	return bcl_ifrand_helper(a, places, true);
-}
+	bcl_pool_unlock();
 
-BclNumber
-bcl_ifrand_keep(BclNumber a, size_t places)
-{
-	return bcl_ifrand_helper(a, places, false);
+	if (!running) bcl_future_free(f);
 }
 
+/**
+ * Makes a shared number from a number and, if requested, frees the number.
+ * @param ctxt      The context.
+ * @param n         The number to share.
+ * @param s         An out parameter for the shared number.
+ * @param destruct  True if @a n should be freed.
+ * @return          An error code, if any.
+ */
 static BclError
-bcl_rand_seedWithNum_helper(BclNumber n, bool destruct)
+bcl_share_helper(BclContext ctxt, BclNumber n, BclShared* s, bool destruct)
 {
 	BclError e = BCL_ERROR_NONE;
-	BclNum* nptr;
-	BclContext ctxt;
-	BcVm* vm = bcl_getspecific();
+	BclShr* shr = NULL;
+	BclNum* num;
+	size_t len;
+	BcVm* vm;
+
+	assert(s != NULL);
+
+	*s = NULL;
 
 	BC_CHECK_CTXT_ERR(vm, ctxt);
+
 	BC_CHECK_NUM_ERR(ctxt, n);
 
+	assert(BCL_NO_GEN(n) < ctxt->nums.len);
+
+	num = BCL_NUM(ctxt, n);
+
+	assert(num != NULL && BCL_NUM_ARRAY(num) != NULL);
+
 	BC_FUNC_HEADER(vm, err);
 
-	assert(BCL_NO_GEN(n) < ctxt->nums.len);
+	// Sharing a view of a shared number just takes another reference.
+	if (BCL_IS_SHARED(BCL_NUM_NUM(num)))
+	{
+		shr = BCL_SHARED(BCL_NUM_NUM(num));
+		BCL_REFS_INC(shr->refs);
+	}
+	else
+	{
+		len = BCL_NUM_NUM(num)->len;
 
-	nptr = BCL_NUM(ctxt, n);
+		shr = bc_vm_malloc(sizeof(BclShr) + BC_NUM_SIZE(len));
 
-	assert(nptr != NULL && BCL_NUM_NUM(nptr) != NULL);
+		shr->refs = 1;
 
-	bc_num_rng(BCL_NUM_NUM(nptr), &vm->rng);
+		// The limbs are copied exactly; the capacity marks every view as one
+		// that does not own them.
+		memcpy(&shr->n, BCL_NUM_NUM(num), sizeof(BcNum));
+		shr->n.num = shr->num;
+		shr->n.cap = BCL_SHARED_CAP;
+
+		// NOLINTNEXTLINE
+		if (len) memcpy(shr->num, BCL_NUM_ARRAY(num), BC_NUM_SIZE(len));
+	}
 
 err:
 
 	if (destruct)
 	{
-		// Eat the oprand.
-		bcl_num_dtor(ctxt, n, nptr);
+		bcl_num_dtor(ctxt, n, num);
 	}
 
 	BC_FUNC_FOOTER(vm, e);
 
+	if (BC_NO_ERR(e == BCL_ERROR_NONE)) *s = shr;
+
 	return e;
 }
 
 BclError
-bcl_rand_seedWithNum(BclNumber n)
+bcl_share(BclNumber n, BclShared* s)
 {
-	return bcl_rand_seedWithNum_helper(n, true);
+	return bcl_share_helper(NULL, n, s, true);
 }
 
 BclError
-bcl_rand_seedWithNum_keep(BclNumber n)
+bcl_ctxt_share(BclContext ctxt, BclNumber n, BclShared* s)
 {
-	return bcl_rand_seedWithNum_helper(n, false);
+	return bcl_share_helper(ctxt, n, s, true);
 }
 
 BclError
-bcl_rand_seed(unsigned char seed[BCL_SEED_SIZE])
+bcl_share_keep(BclNumber n, BclShared* s)
 {
-	BclError e = BCL_ERROR_NONE;
-	size_t i;
-	ulong vals[BCL_SEED_ULONGS];
-	BcVm* vm = bcl_getspecific();
-
-	BC_FUNC_HEADER(vm, err);
-
-	// Fill the array.
-	for (i = 0; i < BCL_SEED_SIZE; ++i)
-	{
-		ulong val = ((ulong) seed[i])
-		            << (((ulong) CHAR_BIT) * (i % sizeof(ulong)));
-		vals[i / sizeof(long)] = val;
-	}
-
-	bc_rand_seed(&vm->rng, vals[0], vals[1], vals[2], vals[3]);
-
-err:
-
-	BC_FUNC_FOOTER(vm, e);
-
-	return e;
+	return bcl_share_helper(NULL, n, s, false);
 }
 
-void
-bcl_rand_reseed(void)
+BclError
+bcl_ctxt_share_keep(BclContext ctxt, BclNumber n, BclShared* s)
 {
-	BcVm* vm = bcl_getspecific();
-
-	bc_rand_srand(bc_vec_top(&vm->rng.v));
+	return bcl_share_helper(ctxt, n, s, false);
 }
 
 BclNumber
-bcl_rand_seed2num(void)
+bcl_ctxt_shared_num(BclContext ctxt, BclShared s)
 {
 	BclError e = BCL_ERROR_NONE;
 	BclNum n;
 	BclNumber idx;
-	BclContext ctxt;
-	BcVm* vm = bcl_getspecific();
+	BcVm* vm;
 
 	BC_CHECK_CTXT(vm, ctxt);
 
-	BC_FUNC_HEADER(vm, err);
+	assert(s != NULL);
 
-	// Clear and initialize the number.
 	bc_num_clear(BCL_NUM_NUM_NP(n));
-	bc_num_init(BCL_NUM_NUM_NP(n), BC_NUM_DEF_SIZE);
 
-	bc_num_createFromRNG(BCL_NUM_NUM_NP(n), &vm->rng);
+	BC_FUNC_HEADER(vm, err);
+
+	BCL_GROW_NUMS(ctxt);
+
+	// The view is just a copy of the struct, and nothing after the reference
+	// is taken can fail.
+	memcpy(BCL_NUM_NUM_NP(n), &s->n, sizeof(BcNum));
+	BCL_REFS_INC(s->refs);
 
 err:
 
@@ -1753,23 +4684,18 @@ err:
 	return idx;
 }
 
-BclRandInt
-bcl_rand_int(void)
+BclNumber
+bcl_shared_num(BclShared s)
 {
-	BcVm* vm = bcl_getspecific();
-
-	return (BclRandInt) bc_rand_int(&vm->rng);
+	return bcl_ctxt_shared_num(NULL, s);
 }
 
-BclRandInt
-bcl_rand_bounded(BclRandInt bound)
+void
+bcl_shared_free(BclShared s)
 {
-	BcVm* vm = bcl_getspecific();
+	assert(s != NULL);
 
-	if (bound <= 1) return 0;
-	return (BclRandInt) bc_rand_bounded(&vm->rng, (BcRand) bound);
+	if (!BCL_REFS_DEC(s->refs)) free(s);
 }
 
-#endif // BC_ENABLE_EXTRA_MATH
-
 #endif // BC_ENABLE_LIBRARY
@@ -112,13 +112,34 @@ bc_num_expand(BcNum* restrict n, size_t req)
 {
 	assert(n != NULL);
 
+	// There must always be some limbs, even for zero. A number without any,
+	// like a variable that held a string, must get some here.
 	req = req >= BC_NUM_DEF_SIZE ? req : BC_NUM_DEF_SIZE;
 
 	if (req > n->cap)
 	{
+		BcDig* num;
+
+		req = bc_vm_tempCap(req);
+
 		BC_SIG_LOCK;
 
-		n->num = bc_vm_realloc(n->num, BC_NUM_SIZE(req));
+		// Use a temp if there is one, so the old limb array can become a temp.
+		num = bc_vm_takeTemp(req);
+
+		if (num == NULL) n->num = bc_vm_realloc(n->num, BC_NUM_SIZE(req));
+		else
+		{
+			if (n->cap)
+			{
+				// NOLINTNEXTLINE
+				memcpy(num, n->num, BC_NUM_SIZE(n->cap));
+				bc_vm_addTemp(n->num, n->cap);
+			}
+
+			n->num = num;
+		}
+
 		n->cap = req;
 
 		BC_SIG_UNLOCK;
@@ -1237,12 +1258,14 @@ bc_num_as(BcNum* a, BcNum* b, BcNum* restrict c, size_t sub)
  * The simple multiplication that karatsuba dishes out to when the length of the
  * numbers gets low enough. This doesn't use scale because it treats the
  * operands as though they are integers.
- * @param a  The first operand.
- * @param b  The second operand.
- * @param c  The return parameter.
+ * @param a      The first operand.
+ * @param b      The second operand.
+ * @param c      The return parameter.
+ * @param start  The first limb of the product to calculate. The limbs below it
+ *               are set to zero, and the carry out of them is ignored.
  */
 static void
-bc_num_m_simp(const BcNum* a, const BcNum* b, BcNum* restrict c)
+bc_num_m_simp(const BcNum* a, const BcNum* b, BcNum* restrict c, size_t start)
 {
 	size_t i, alen = a->len, blen = b->len, clen;
 	BcDig* ptr_a = a->num;
@@ -1266,7 +1289,7 @@ bc_num_m_simp(const BcNum* a, const BcNum* b, BcNum* restrict c)
 	// multiplication (see the explanation on the web page at
 	// https://knilt.arcc.albany.edu/What_is_Lattice_Multiplication or the
 	// explanation at Wikipedia).
-	for (i = 0; i < clen; ++i)
+	for (i = start; i < clen; ++i)
 	{
 		ssize_t sidx = (ssize_t) (i - blen + 1);
 		size_t j, k;
@@ -1357,7 +1380,7 @@ bc_num_k(const BcNum* a, const BcNum* b, BcNum* restrict c)
 	// Shell out to the simple algorithm with certain conditions.
 	if (a->len < BC_NUM_KARATSUBA_LEN || b->len < BC_NUM_KARATSUBA_LEN)
 	{
-		bc_num_m_simp(a, b, c);
+		bc_num_m_simp(a, b, c, 0);
 		return;
 	}
 
@@ -1469,6 +1492,72 @@ err:
 	BC_LONGJMP_CONT(vm);
 }
 
+/**
+ * Calculates a short product, which is a product where the bottom limbs are
+ * going to be truncated anyway. Only the limbs that are kept, plus
+ * BC_NUM_SHORT_MUL_GUARD guard limbs, are calculated; the rest are left as
+ * zero. The carry out of the limbs that are not calculated is bounded, so if
+ * the guard limbs are far enough from overflowing, the kept limbs are exactly
+ * what they would be in the full product. If not, or if the short product
+ * would not be faster, this returns false without touching @a c, and the
+ * caller needs to calculate the full product.
+ * @param a      The first operand. It must be an integer.
+ * @param b      The second operand. It must be an integer.
+ * @param c      The return parameter. It must be zero.
+ * @param trunc  The number of limbs at the bottom of the product that will be
+ *               truncated.
+ * @return       True if the short product was calculated, false otherwise.
+ */
+static bool
+bc_num_m_short(const BcNum* a, const BcNum* b, BcNum* restrict c, size_t trunc)
+{
+	size_t start, n, clen = bc_vm_growSize(a->len, b->len);
+	BcBigDig top;
+
+	assert(BC_NUM_ZERO(c));
+	assert(!BC_NUM_RDX_VAL(a) && !BC_NUM_RDX_VAL(b));
+
+	// If the whole product is truncated, it is zero.
+	if (trunc >= clen) return true;
+
+	// Karatsuba is faster for big numbers, and there's nothing to gain if we
+	// would calculate all of the limbs anyway.
+	if (trunc <= BC_NUM_SHORT_MUL_GUARD) return false;
+	if (a->len >= BC_NUM_KARATSUBA_LEN && b->len >= BC_NUM_KARATSUBA_LEN &&
+	    BC_MAX(a->len, b->len) > BC_NUM_SHORT_MUL_LEN)
+	{
+		return false;
+	}
+
+	// Each limb that is not calculated has at most n partial products, so the
+	// carry out of all of them, in units of the bottom guard limb, is less than
+	// n * BC_BASE_POW. That means that the limbs above the guard limbs are
+	// correct unless the top guard limb is within n + 1 of overflowing.
+	n = BC_MIN(a->len, b->len);
+	if (n + 1 >= BC_BASE_POW) return false;
+
+	start = trunc - BC_NUM_SHORT_MUL_GUARD;
+
+	bc_num_m_simp(a, b, c, start);
+
+	top = (BcBigDig) c->num[trunc - 1];
+
+	if (top + n + 1 >= BC_BASE_POW)
+	{
+		bc_num_zero(c);
+		return false;
+	}
+
+	// Clear the guard limbs so the product is exactly the full product with the
+	// truncated limbs cleared.
+	// NOLINTNEXTLINE
+	memset(c->num + start, 0, BC_NUM_SIZE(BC_NUM_SHORT_MUL_GUARD));
+
+	bc_num_clean(c);
+
+	return true;
+}
+
 /**
  * Does checks for Karatsuba. It also changes things to ensure that the
  * Karatsuba and simple multiplication can treat the numbers as integers. This
@@ -1482,7 +1571,7 @@ static void
 bc_num_m(BcNum* a, BcNum* b, BcNum* restrict c, size_t scale)
 {
 	BcNum cpa, cpb;
-	size_t ascale, bscale, ardx, brdx, zero, len, rscale;
+	size_t ascale, bscale, ardx, brdx, zero, len, rscale, trunc;
 	// These are meant to quiet warnings on GCC about longjmp() clobbering.
 	// The problem is real here.
 	size_t scale1, scale2, realscale;
@@ -1491,7 +1580,7 @@ bc_num_m(BcNum* a, BcNum* b, BcNum* restrict c, size_t scale)
 	volatile size_t azero;
 	volatile size_t bzero;
 #if BC_ENABLE_LIBRARY
-	BcVm* vm = bcl_getspecific();
+	BcVm* vm;
 #endif // BC_ENABLE_LIBRARY
 
 	assert(BC_NUM_RDX_VALID(a));
@@ -1541,6 +1630,11 @@ bc_num_m(BcNum* a, BcNum* b, BcNum* restrict c, size_t scale)
 	assert(BC_NUM_RDX_VALID(a));
 	assert(BC_NUM_RDX_VALID(b));
 
+#if BC_ENABLE_LIBRARY
+	// This is only looked up when needed because it is not free in bcl.
+	vm = bcl_getspecific();
+#endif // BC_ENABLE_LIBRARY
+
 	BC_SIG_LOCK;
 
 	// We need copies because of all of the mutation needed to make Karatsuba
@@ -1589,12 +1683,19 @@ bc_num_m(BcNum* a, BcNum* b, BcNum* restrict c, size_t scale)
 	bc_num_clean(&cpa);
 	bc_num_clean(&cpb);
 
-	bc_num_k(&cpa, &cpb, c);
+	// Figure out how many limbs of the product will be truncated by
+	// bc_num_retireMul() below. If there are enough, use a short product.
+	trunc = BC_NUM_RDX_VAL(a) + BC_NUM_RDX_VAL(b) - BC_NUM_RDX(realscale);
+	zero = bc_vm_growSize(azero, bzero);
+
+	if (trunc <= zero || !bc_num_m_short(&cpa, &cpb, c, trunc - zero))
+	{
+		bc_num_k(&cpa, &cpb, c);
+	}
 
 	// The return parameter needs to have its scale set. This is the start. It
 	// also needs to be shifted by the same amount as a and b have limbs after
 	// the decimal point.
-	zero = bc_vm_growSize(azero, bzero);
 	len = bc_vm_growSize(c->len, zero);
 
 	bc_num_expand(c, len);
@@ -1868,6 +1969,232 @@ err:
 	BC_LONGJMP_CONT(vm);
 }
 
+/**
+ * Calculates a reciprocal for the reciprocal cache. The reciprocal is
+ * floor(BC_BASE_POW^prec / b).
+ * @param b     The divisor. It must be an integer.
+ * @param r     The return parameter.
+ * @param prec  The precision of the reciprocal, in limbs.
+ */
+static void
+bc_num_recip(const BcNum* b, BcNum* restrict r, size_t prec)
+{
+	BcNum pow, cpb;
+#if BC_ENABLE_LIBRARY
+	BcVm* vm = bcl_getspecific();
+#endif // BC_ENABLE_LIBRARY
+
+	assert(prec >= b->len);
+
+	BC_SIG_LOCK;
+
+	// The extra limb is the leading zero limb that bc_num_d_long() expects.
+	bc_num_init(&pow, prec + 2);
+	bc_num_createCopy(&cpb, b);
+
+	BC_SETJMP_LOCKED(vm, err);
+
+	BC_SIG_UNLOCK;
+
+	// NOLINTNEXTLINE
+	memset(pow.num, 0, BC_NUM_SIZE(prec + 2));
+	pow.num[prec] = 1;
+	pow.len = prec + 2;
+
+	bc_num_d_long(&pow, &cpb, r, 0);
+	bc_num_clean(r);
+
+err:
+	BC_SIG_MAYLOCK;
+	bc_num_free(&cpb);
+	bc_num_free(&pow);
+	BC_LONGJMP_CONT(vm);
+}
+
+/**
+ * Does the same thing as bc_num_d_long(), but with a cached reciprocal of the
+ * divisor, which turns the division into a multiplication and a correction of
+ * at most two subtractions. If the divisor is not in the cache, it is only
+ * remembered, and the reciprocal is calculated if it shows up again, so
+ * one-off divisions do not pay for it.
+ * @param a      The first operand.
+ * @param b      The second operand. It must be an integer.
+ * @param c      The return parameter.
+ * @param scale  The current scale.
+ * @return       True if the division was done, false if bc_num_d_long() needs
+ *               to do it.
+ */
+static bool
+bc_num_d_recip(const BcNum* a, const BcNum* b, BcNum* restrict c, size_t scale)
+{
+	size_t i, rdx, k, m, q, skip, len;
+	BcNumRecip* r;
+	BcNum n1, rv, qv, prod, low, rem;
+	BcBigDig carry;
+#if BC_ENABLE_LIBRARY
+	BcVm* vm = bcl_getspecific();
+#endif // BC_ENABLE_LIBRARY
+
+	k = b->len;
+
+	if (k < BC_NUM_RECIP_LEN) return false;
+
+	assert(b->num[k - 1]);
+	assert(a->scale >= scale);
+
+	// These are the same as in bc_num_d_long(): the quotient limbs from rdx up
+	// are floor(A / B), where A is the limbs of a from rdx up, and B is b.
+	rdx = BC_NUM_RDX_VAL(a) - BC_NUM_RDX(scale);
+
+	for (m = a->len; m > rdx && !a->num[m - 1]; --m)
+	{
+		continue;
+	}
+
+	// A has m limbs, so the quotient has at most q limbs. If it has too many,
+	// multiplying by the reciprocal is slower than long division.
+	m -= rdx;
+	if (m < k) return false;
+	q = m - k + 1;
+	if (q > k * BC_NUM_RECIP_QUOT) return false;
+
+	for (i = 0; i < BC_NUM_RECIP_SLOTS; ++i)
+	{
+		r = vm->recips + i;
+
+		// NOLINTNEXTLINE
+		if (r->div.len == k && !memcmp(r->div.num, b->num, BC_NUM_SIZE(k)))
+		{
+			break;
+		}
+	}
+
+	// If the divisor is not in the cache, remember it for next time.
+	if (i == BC_NUM_RECIP_SLOTS)
+	{
+		r = vm->recips + vm->recips_next;
+		vm->recips_next = (vm->recips_next + 1) % BC_NUM_RECIP_SLOTS;
+
+		BC_SIG_LOCK;
+
+		if (r->div.num == NULL)
+		{
+			bc_num_init(&r->div, k);
+			bc_num_init(&r->recip, BC_NUM_DEF_SIZE);
+		}
+
+		r->prec = 0;
+
+		BC_SIG_UNLOCK;
+
+		bc_num_copy(&r->div, b);
+
+		return false;
+	}
+
+	// Calculate the reciprocal if it has not been or if it is not precise
+	// enough. The entry is marked invalid first in case this is interrupted.
+	if (r->prec < m)
+	{
+		r->prec = 0;
+		bc_num_recip(b, &r->recip, m);
+		r->prec = m;
+	}
+
+	// If the cached reciprocal has more precision than needed, the one with the
+	// right precision is just its top limbs.
+	skip = r->prec - m;
+	assert(r->recip.len > skip);
+
+	bc_num_setup(&rv, r->recip.num + skip, r->recip.len - skip);
+	rv.len = rv.cap;
+
+	// This is the top of A, the part that the reciprocal multiplies.
+	bc_num_setup(&n1, a->num + rdx + k - 1, q);
+	n1.len = q;
+
+	BC_SIG_LOCK;
+
+	bc_num_init(&prod, bc_vm_growSize(n1.len, rv.len));
+	bc_num_init(&low, bc_vm_growSize(k, k + 1));
+	bc_num_init(&rem, k + 2);
+
+	BC_SETJMP_LOCKED(vm, err);
+
+	BC_SIG_UNLOCK;
+
+	// The estimate of the quotient is the top of the product, and only the top
+	// is needed. The estimate is at most 2 less than the real quotient.
+	if (!bc_num_m_short(&n1, &rv, &prod, q)) bc_num_k(&n1, &rv, &prod);
+
+	bc_num_clean(&prod);
+
+	len = prod.len > q ? prod.len - q : 0;
+	assert(len <= q);
+
+	bc_num_setup(&qv, prod.num + q, len);
+	qv.len = BC_MIN(len, k + 1);
+	bc_num_clean(&qv);
+
+	// The remainder of the estimate is less than 3 * B, so it fits in k + 1
+	// limbs, and it can be calculated with the bottom limbs of everything.
+	// The extra 1 at the top absorbs the borrow when the bottom of the product
+	// is bigger than the bottom of A.
+	bc_num_k(&qv, b, &low);
+
+	len = BC_MIN(a->len - rdx, k + 1);
+
+	// NOLINTNEXTLINE
+	memset(rem.num, 0, BC_NUM_SIZE(k + 2));
+	// NOLINTNEXTLINE
+	memcpy(rem.num, a->num + rdx, BC_NUM_SIZE(len));
+	rem.num[k + 1] = 1;
+
+	bc_num_subArrays(rem.num, low.num, BC_MIN(low.len, k + 1));
+	rem.num[k + 1] = 0;
+
+	// Correct the estimate.
+	for (carry = 0; bc_num_divCmp(rem.num, b, k) >= 0; ++carry)
+	{
+		bc_num_subArrays(rem.num, b->num, k);
+	}
+
+	assert(carry <= 2);
+
+	// Set up c like bc_num_d_long() would.
+	bc_num_expand(c, a->len);
+	// NOLINTNEXTLINE
+	memset(c->num, 0, BC_NUM_SIZE(c->cap));
+
+	BC_NUM_RDX_SET(c, BC_NUM_RDX_VAL(a));
+	c->scale = a->scale;
+	c->len = a->len;
+
+	len = prod.len > q ? prod.len - q : 0;
+
+	// NOLINTNEXTLINE
+	if (len) memcpy(c->num + rdx, prod.num + q, BC_NUM_SIZE(len));
+
+	// Add the correction to the estimate.
+	for (i = rdx; carry; ++i)
+	{
+		assert(i < rdx + q);
+
+		carry += (BcBigDig) c->num[i];
+		c->num[i] = (BcDig) (carry % BC_BASE_POW);
+		carry /= BC_BASE_POW;
+	}
+
+err:
+	BC_SIG_MAYLOCK;
+	bc_num_free(&rem);
+	bc_num_free(&low);
+	bc_num_free(&prod);
+	BC_LONGJMP_CONT(vm);
+
+	return true;
+}
+
 /**
  * Implements division. This is a BcNumBinOp function.
  * @param a      The first operand.
@@ -1881,7 +2208,7 @@ bc_num_d(BcNum* a, BcNum* b, BcNum* restrict c, size_t scale)
 	size_t len, cpardx;
 	BcNum cpa, cpb;
 #if BC_ENABLE_LIBRARY
-	BcVm* vm = bcl_getspecific();
+	BcVm* vm;
 #endif // BC_ENABLE_LIBRARY
 
 	if (BC_NUM_ZERO(b)) bc_err(BC_ERR_MATH_DIVIDE_BY_ZERO);
@@ -1910,6 +2237,11 @@ bc_num_d(BcNum* a, BcNum* b, BcNum* restrict c, size_t scale)
 
 	len = bc_num_divReq(a, b, scale);
 
+#if BC_ENABLE_LIBRARY
+	// This is only looked up when needed because it is not free in bcl.
+	vm = bcl_getspecific();
+#endif // BC_ENABLE_LIBRARY
+
 	BC_SIG_LOCK;
 
 	// Initialize copies of the parameters. We want the length of the first
@@ -1969,7 +2301,10 @@ bc_num_d(BcNum* a, BcNum* b, BcNum* restrict c, size_t scale)
 	cpb.scale = 0;
 	BC_NUM_RDX_SET_NP(cpb, 0);
 
-	bc_num_d_long(&cpa, &cpb, c, scale);
+	if (!bc_num_d_recip(&cpa, &cpb, c, scale))
+	{
+		bc_num_d_long(&cpa, &cpb, c, scale);
+	}
 
 	bc_num_retireMul(c, scale, BC_NUM_NEG(a), BC_NUM_NEG(b));
 
@@ -2347,6 +2682,157 @@ err:
 	}
 }
 
+/**
+ * Sets a number to a small result of machine arithmetic. The result must be
+ * less than BC_BASE_POW squared, which means it fits in at most two limbs.
+ * @param n    The number to set.
+ * @param val  The absolute value of the result.
+ * @param neg  True if the result is negative, false otherwise.
+ */
+static void
+bc_num_setSmall(BcNum* restrict n, BcBigDig val, bool neg)
+{
+	n->scale = 0;
+
+	if (!val)
+	{
+		n->len = n->rdx = 0;
+		return;
+	}
+
+	bc_num_expand(n, 2);
+
+	n->num[0] = (BcDig) (val % BC_BASE_POW);
+	n->num[1] = (BcDig) (val / BC_BASE_POW);
+	n->len = 1 + (n->num[1] != 0);
+	n->rdx = (size_t) neg;
+}
+
+/**
+ * Adds or subtracts two small integers with machine arithmetic. This is the
+ * fast path for counters and indices. It is safe for @a c to be the same as
+ * @a a or @a b.
+ * @param a    The first operand. It must be a small integer.
+ * @param b    The second operand. It must be a small integer.
+ * @param c    The return parameter.
+ * @param sub  True if the operation is subtraction, false otherwise.
+ */
+static void
+bc_num_smallAddSub(const BcNum* a, const BcNum* b, BcNum* c, bool sub)
+{
+	BcBigDig x = BC_NUM_SMALL_VAL(a), y = BC_NUM_SMALL_VAL(b);
+	bool aneg = BC_NUM_NEG(a), bneg = (BC_NUM_NEG(b) != 0) != sub;
+
+	// Both are less than BC_BASE_POW, so none of this can overflow.
+	if (aneg == bneg) bc_num_setSmall(c, x + y, aneg);
+	else if (x >= y) bc_num_setSmall(c, x - y, aneg);
+	else bc_num_setSmall(c, y - x, bneg);
+}
+
+/**
+ * Adds @a b to @a c, or subtracts it, in place. The result is the same as the
+ * one that bc_num_add() or bc_num_sub() would give, but it is written into the
+ * limbs of @a c, which are only reallocated if there are too few of them. This
+ * means that this can only fail to allocate.
+ * @param c    The number to add to and the return parameter.
+ * @param b    The number to add or subtract. It must not be @a c.
+ * @param sub  True if @a b should be subtracted, false otherwise.
+ */
+static void
+bc_num_accum(BcNum* restrict c, const BcNum* restrict b, bool sub)
+{
+	size_t i, crdx, brdx, diff, cint, bint, len;
+	bool b_neg, do_sub, do_rev_sub = false, carry = false, c_neg;
+
+	assert(BC_NUM_RDX_VALID(c));
+	assert(BC_NUM_RDX_VALID(b));
+
+	if (BC_NUM_SMALL(c) && BC_NUM_SMALL(b))
+	{
+		bc_num_smallAddSub(c, b, c, sub);
+		return;
+	}
+
+	// These are the same special cases as in bc_num_as().
+	if (BC_NUM_ZERO(b)) return;
+
+	b_neg = (BC_NUM_NEG(b) != sub);
+
+	if (BC_NUM_ZERO(c))
+	{
+		bc_num_copy(c, b);
+		c->rdx = BC_NUM_NEG_VAL(c, b_neg);
+		return;
+	}
+
+	do_sub = (BC_NUM_NEG(c) != b_neg);
+
+	crdx = BC_NUM_RDX_VAL(c);
+	brdx = BC_NUM_RDX_VAL(b);
+	cint = c->len - crdx;
+	bint = bc_num_int(b);
+
+	// Addition can create an extra limb. This is the only allocation, and it
+	// happens before c is touched, so c is unchanged if it fails.
+	len = bc_vm_growSize(BC_MAX(crdx, brdx) + BC_MAX(cint, bint), !do_sub);
+
+	bc_num_expand(c, len);
+
+	// If b has more limbs after the radix, c needs them too, like
+	// bc_num_extend() would give it.
+	if (brdx > crdx)
+	{
+		diff = brdx - crdx;
+
+		// NOLINTNEXTLINE
+		memmove(c->num + diff, c->num, BC_NUM_SIZE(c->len));
+		// NOLINTNEXTLINE
+		memset(c->num, 0, BC_NUM_SIZE(diff));
+
+		c->len += diff;
+		crdx = brdx;
+	}
+
+	// NOLINTNEXTLINE
+	memset(c->num + c->len, 0, BC_NUM_SIZE(len - c->len));
+
+	// This is where the limbs of b line up with the limbs of c.
+	diff = crdx - brdx;
+
+	if (do_sub)
+	{
+		// Check whether b has to be subtracted from c or c from b.
+		if (cint != bint) do_rev_sub = (cint < bint);
+		else
+		{
+			do_rev_sub = (bc_num_compare(c->num + diff, b->num, b->len) < 0);
+		}
+
+		if (do_rev_sub)
+		{
+			for (i = 0; i < len; ++i)
+			{
+				size_t j = i - diff;
+				BcDig d = (i >= diff && j < b->len) ? b->num[j] : 0;
+
+				c->num[i] = bc_num_subDigits(d, c->num[i], &carry);
+			}
+
+			assert(carry == false);
+		}
+		else bc_num_subArrays(c->num + diff, b->num, b->len);
+	}
+	else bc_num_addArrays(c->num + diff, b->num, b->len);
+
+	// The result has the same sign as c, unless it was a reverse subtraction.
+	c_neg = do_rev_sub ? b_neg : BC_NUM_NEG(c);
+	BC_NUM_RDX_SET_NEG(c, crdx, c_neg);
+	c->len = len;
+	c->scale = BC_MAX(c->scale, b->scale);
+
+	bc_num_clean(c);
+}
+
 /**
  * Tests a number string for validity. This function has a history; I originally
  * wrote it because I did not trust my parser. Over time, however, I came to
@@ -3422,16 +3908,13 @@ bc_num_init(BcNum* restrict n, size_t req)
 	assert(n != NULL);
 
 	// BC_NUM_DEF_SIZE is set to be about the smallest allocation size that
-	// malloc() returns in practice, so just use it.
-	req = req >= BC_NUM_DEF_SIZE ? req : BC_NUM_DEF_SIZE;
+	// malloc() returns in practice, so it is the smallest capacity. Rounding
+	// up to a size class lets the limb array be reused.
+	req = bc_vm_tempCap(req);
 
 	// If we can't use a temp, allocate.
-	if (req != BC_NUM_DEF_SIZE) num = bc_vm_malloc(BC_NUM_SIZE(req));
-	else
-	{
-		num = bc_vm_getTemp() == NULL ? bc_vm_malloc(BC_NUM_SIZE(req)) :
-		                                bc_vm_takeTemp();
-	}
+	num = bc_vm_takeTemp(req);
+	if (num == NULL) num = bc_vm_malloc(BC_NUM_SIZE(req));
 
 	bc_num_setup(n, num, req);
 }
@@ -3452,8 +3935,7 @@ bc_num_free(void* num)
 
 	assert(n != NULL);
 
-	if (n->cap == BC_NUM_DEF_SIZE) bc_vm_addTemp(n->num);
-	else free(n->num);
+	bc_vm_addTemp(n->num, n->cap);
 }
 
 void
@@ -3697,6 +4179,424 @@ bc_num_bigdig2num(BcNum* restrict n, BcBigDig val)
 	n->len = i;
 }
 
+#if BC_ENABLE_LIBRARY
+
+#if BC_BASE_DIGS != BCL_LIMB_DIGS
+
+/**
+ * Returns the decimal digit at position @a pos in @a a, where position 0 is the
+ * least significant digit of the first limb.
+ * @param a    The limbs.
+ * @param pos  The position of the digit.
+ * @return     The digit.
+ */
+static inline BcBigDig
+bc_num_digit(const BcDig* a, size_t pos)
+{
+	BcBigDig dig = (BcBigDig) a[pos / BC_BASE_DIGS];
+	return (dig / bc_num_pow10[pos % BC_BASE_DIGS]) % BC_BASE;
+}
+
+/**
+ * Regroups the decimal digits in @a a into BclLimb's. This is only used when
+ * the limbs of a BcNum do not have BCL_LIMB_DIGS digits.
+ * @param a     The limbs of the number.
+ * @param alen  The number of limbs in @a a.
+ * @param b     The BclLimb's to fill.
+ * @param blen  The number of limbs in @a b.
+ * @param frac  True if the limbs are a fractional part, which means that they
+ *              are aligned at the most significant end, false if they are an
+ *              integer part, which means they are aligned at the least
+ *              significant end.
+ */
+static void
+bc_num_regroupTo(const BcDig* a, size_t alen, BclLimb* b, size_t blen,
+                 bool frac)
+{
+	size_t i, adigs = alen * BC_BASE_DIGS, bdigs = blen * BCL_LIMB_DIGS;
+	BclLimb pow = 1;
+
+	for (i = 0; i < bdigs; ++i, pow *= BC_BASE)
+	{
+		BcBigDig dig;
+
+		if (!(i % BCL_LIMB_DIGS))
+		{
+			b[i / BCL_LIMB_DIGS] = 0;
+			pow = 1;
+		}
+
+		if (frac)
+		{
+			dig = i + adigs >= bdigs ? bc_num_digit(a, i + adigs - bdigs) : 0;
+		}
+		else dig = i < adigs ? bc_num_digit(a, i) : 0;
+
+		b[i / BCL_LIMB_DIGS] += (BclLimb) dig * pow;
+	}
+}
+
+/**
+ * Regroups the decimal digits in @a b into the limbs of a BcNum. This is the
+ * inverse of bc_num_regroupTo().
+ * @param a     The limbs of the number to fill.
+ * @param alen  The number of limbs in @a a.
+ * @param b     The BclLimb's.
+ * @param blen  The number of limbs in @a b.
+ * @param frac  True if the limbs are a fractional part, false otherwise.
+ */
+static void
+bc_num_regroupFrom(BcDig* a, size_t alen, const BclLimb* b, size_t blen,
+                   bool frac)
+{
+	size_t i, adigs = alen * BC_BASE_DIGS, bdigs = blen * BCL_LIMB_DIGS;
+
+	// NOLINTNEXTLINE
+	memset(a, 0, BC_NUM_SIZE(alen));
+
+	for (i = 0; i < adigs; ++i)
+	{
+		size_t j, pos;
+		BclLimb dig;
+
+		if (frac)
+		{
+			if (i + bdigs < adigs) continue;
+			pos = i + bdigs - adigs;
+		}
+		else if (i < bdigs) pos = i;
+		else break;
+
+		dig = b[pos / BCL_LIMB_DIGS];
+
+		for (j = pos % BCL_LIMB_DIGS; j; --j)
+		{
+			dig /= BC_BASE;
+		}
+
+		a[i / BC_BASE_DIGS] += (BcDig) ((dig % BC_BASE) *
+		                                bc_num_pow10[i % BC_BASE_DIGS]);
+	}
+}
+
+#endif // BC_BASE_DIGS != BCL_LIMB_DIGS
+
+void
+bc_num_limbsLen(const BcNum* restrict n, size_t* ilen, size_t* flen)
+{
+	size_t digs = bc_num_intDigits(n);
+
+	*ilen = (digs + BCL_LIMB_DIGS - 1) / BCL_LIMB_DIGS;
+	*flen = (n->scale + BCL_LIMB_DIGS - 1) / BCL_LIMB_DIGS;
+}
+
+void
+bc_num_toLimbs(const BcNum* restrict n, BclLimb* ipart, BclLimb* fpart)
+{
+	size_t i, ilen, flen, rdx = BC_NUM_RDX_VAL(n);
+
+	bc_num_limbsLen(n, &ilen, &flen);
+
+#if BC_BASE_DIGS == BCL_LIMB_DIGS
+
+	// This is the fast path, where the limbs are the same, so only the
+	// alignment of the fractional part has to be taken care of.
+	for (i = 0; i < ilen; ++i)
+	{
+		ipart[i] = (BclLimb) n->num[rdx + i];
+	}
+
+	for (i = 0; i < flen; ++i)
+	{
+		fpart[flen - 1 - i] = i < rdx ? (BclLimb) n->num[rdx - 1 - i] : 0;
+	}
+
+#else // BC_BASE_DIGS == BCL_LIMB_DIGS
+
+	bc_num_regroupTo(n->num + rdx, bc_num_int(n), ipart, ilen, false);
+	bc_num_regroupTo(n->num, rdx, fpart, flen, true);
+
+	// Make sure the compiler does not complain about an unused variable.
+	BC_UNUSED(i);
+
+#endif // BC_BASE_DIGS == BCL_LIMB_DIGS
+}
+
+void
+bc_num_fromLimbs(BcNum* restrict n, const BclLimb* ipart, size_t ilen,
+                 const BclLimb* fpart, size_t scale, bool neg)
+{
+	size_t i, rdx, flen = (scale + BCL_LIMB_DIGS - 1) / BCL_LIMB_DIGS;
+	size_t len;
+
+	assert(n != NULL);
+
+	for (i = 0; i < ilen; ++i)
+	{
+		if (BC_ERR(ipart[i] >= BCL_LIMB_POW)) bc_err(BC_ERR_MATH_OVERFLOW);
+	}
+
+	for (i = 0; i < flen; ++i)
+	{
+		if (BC_ERR(fpart[i] >= BCL_LIMB_POW)) bc_err(BC_ERR_MATH_OVERFLOW);
+	}
+
+	rdx = BC_NUM_RDX(scale);
+	len = rdx + BC_NUM_RDX(ilen * BCL_LIMB_DIGS);
+
+	bc_num_zero(n);
+	bc_num_expand(n, len);
+
+#if BC_BASE_DIGS == BCL_LIMB_DIGS
+
+	assert(rdx == flen);
+
+	for (i = 0; i < flen; ++i)
+	{
+		n->num[i] = (BcDig) fpart[i];
+	}
+
+	for (i = 0; i < ilen; ++i)
+	{
+		n->num[rdx + i] = (BcDig) ipart[i];
+	}
+
+#else // BC_BASE_DIGS == BCL_LIMB_DIGS
+
+	bc_num_regroupFrom(n->num, rdx, fpart, flen, true);
+	bc_num_regroupFrom(n->num + rdx, len - rdx, ipart, ilen, false);
+
+#endif // BC_BASE_DIGS == BCL_LIMB_DIGS
+
+	// Truncate the digits past the scale.
+	if (rdx) n->num[0] -= n->num[0] % (BcDig) bc_num_leastSigPow(scale);
+
+	n->len = len;
+	n->scale = scale;
+	BC_NUM_RDX_SET_NEG(n, rdx, 0);
+
+	bc_num_clean(n);
+
+	if (BC_NUM_NONZERO(n)) n->rdx = BC_NUM_NEG_VAL(n, neg);
+}
+
+/**
+ * Divides the integer in @a a by 2^(8 * BC_NUM_BYTES_CHUNK) until it is zero
+ * and pushes the remainders onto @a v as little-endian bytes. This destroys
+ * the contents of @a a.
+ * @param a    The limbs of the integer. The most significant must be nonzero.
+ * @param len  The number of limbs in @a a.
+ * @param v    The vector of bytes to push onto.
+ */
+static void
+bc_num_toBytesHelper(BcDig* a, size_t len, BcVec* restrict v)
+{
+	size_t i;
+
+	while (len)
+	{
+		BcBigDig rem = 0;
+
+		// Divide by the chunk, starting from the most significant limb.
+		for (i = len - 1; i < len; --i)
+		{
+			BcBigDig cur = rem * BC_BASE_POW + (BcBigDig) a[i];
+
+			a[i] = (BcDig) (cur >> (8 * BC_NUM_BYTES_CHUNK));
+			rem = cur & ((((BcBigDig) 1) << (8 * BC_NUM_BYTES_CHUNK)) - 1);
+		}
+
+		while (len && !a[len - 1])
+		{
+			len -= 1;
+		}
+
+		for (i = 0; i < BC_NUM_BYTES_CHUNK; ++i, rem >>= 8)
+		{
+			bc_vec_pushByte(v, (uchar) (rem & UCHAR_MAX));
+		}
+	}
+
+	// Remove the zero bytes at the most significant end.
+	while (v->len && !((uchar*) v->v)[v->len - 1])
+	{
+		bc_vec_pop(v);
+	}
+}
+
+void
+bc_num_toBytes(const BcNum* restrict n, bool frac, BcVec* restrict v)
+{
+	BcNum temp;
+	size_t len, rdx = BC_NUM_RDX_VAL(n);
+	const BcDig* ptr;
+	BcVm* vm = bcl_getspecific();
+
+	assert(n != NULL && v != NULL && v->size == sizeof(uchar));
+
+	if (frac)
+	{
+		ptr = n->num;
+		len = rdx;
+	}
+	else
+	{
+		ptr = n->num + rdx;
+		len = bc_num_int(n);
+	}
+
+	if (BC_NUM_ZERO(n) || !len) return;
+
+	BC_SIG_LOCK;
+
+	bc_num_init(&temp, len);
+
+	BC_SETJMP_LOCKED(vm, err);
+
+	BC_SIG_UNLOCK;
+
+	// NOLINTNEXTLINE
+	memcpy(temp.num, ptr, BC_NUM_SIZE(len));
+	temp.len = len;
+
+	// The fractional part is stored as the fraction times a power of the base,
+	// so if the scale does not fill the last limb, get rid of the extra zeroes.
+	if (frac && n->scale % BC_BASE_DIGS)
+	{
+		BcBigDig rem = 0, pow;
+		size_t i;
+
+		pow = (BcBigDig) bc_num_leastSigPow(n->scale);
+
+		for (i = len - 1; i < len; --i)
+		{
+			BcBigDig cur = rem * BC_BASE_POW + (BcBigDig) temp.num[i];
+
+			temp.num[i] = (BcDig) (cur / pow);
+			rem = cur % pow;
+		}
+
+		assert(!rem);
+	}
+
+	bc_num_clean(&temp);
+
+	bc_num_toBytesHelper(temp.num, temp.len, v);
+
+err:
+	BC_SIG_MAYLOCK;
+	bc_num_free(&temp);
+	BC_LONGJMP_CONT(vm);
+}
+
+/**
+ * Multiplies the bytes of an unsigned binary integer into the limbs of @a n
+ * starting at @a start. The limbs from @a start to the length of @a n must
+ * be the integer to multiply into; usually, that is no limbs, which means zero.
+ * @param n          The number to multiply into.
+ * @param start      The first limb of the integer.
+ * @param b          The bytes.
+ * @param len        The number of bytes.
+ * @param bigEndian  True if the bytes are big-endian, false otherwise.
+ */
+static void
+bc_num_fromBytesHelper(BcNum* restrict n, size_t start, const uchar* b,
+                       size_t len, bool bigEndian)
+{
+	size_t i, j, k, chunk;
+
+	// The first chunk is the odd one out so that the rest are full.
+	chunk = len % BC_NUM_BYTES_CHUNK;
+	if (!chunk) chunk = BC_NUM_BYTES_CHUNK;
+
+	for (k = 0; k < len; chunk = BC_NUM_BYTES_CHUNK)
+	{
+		BcBigDig carry = 0;
+
+		// Get the chunk, starting from the most significant byte.
+		for (j = 0; j < chunk; ++j, ++k)
+		{
+			carry = (carry << 8) | b[bigEndian ? k : len - 1 - k];
+		}
+
+		for (i = start; i < n->len; ++i)
+		{
+			BcBigDig cur = (((BcBigDig) n->num[i]) << (8 * chunk)) + carry;
+
+			n->num[i] = (BcDig) (cur % BC_BASE_POW);
+			carry = cur / BC_BASE_POW;
+		}
+
+		for (; carry; carry /= BC_BASE_POW)
+		{
+			bc_num_expand(n, n->len + 1);
+			n->num[n->len] = (BcDig) (carry % BC_BASE_POW);
+			n->len += 1;
+		}
+	}
+}
+
+void
+bc_num_fromBytes(BcNum* restrict n, const uchar* ipart, size_t ilen,
+                 const uchar* fpart, size_t flen, size_t scale, bool neg,
+                 bool bigEndian)
+{
+	size_t i, rdx = BC_NUM_RDX(scale);
+
+	assert(n != NULL);
+
+	bc_num_zero(n);
+
+	// The fractional part goes first because it is in the least significant
+	// limbs.
+	bc_num_fromBytesHelper(n, 0, fpart, flen, bigEndian);
+
+	// The fractional part is the fraction times 10^scale, but the limbs need it
+	// to be times a power of the base, so multiply the difference in.
+	if (BC_NUM_NONZERO(n) && scale % BC_BASE_DIGS)
+	{
+		BcBigDig carry = 0, pow;
+
+		pow = (BcBigDig) bc_num_leastSigPow(scale);
+
+		for (i = 0; i < n->len; ++i)
+		{
+			BcBigDig cur = ((BcBigDig) n->num[i]) * pow + carry;
+
+			n->num[i] = (BcDig) (cur % BC_BASE_POW);
+			carry = cur / BC_BASE_POW;
+		}
+
+		if (carry)
+		{
+			bc_num_expand(n, n->len + 1);
+			n->num[n->len] = (BcDig) carry;
+			n->len += 1;
+		}
+	}
+
+	// If the fractional part does not fit, it was not less than 10^scale.
+	if (BC_ERR(n->len > rdx)) bc_err(BC_ERR_MATH_OVERFLOW);
+
+	bc_num_expand(n, rdx);
+
+	// NOLINTNEXTLINE
+	memset(n->num + n->len, 0, BC_NUM_SIZE(rdx - n->len));
+
+	n->len = rdx;
+
+	bc_num_fromBytesHelper(n, rdx, ipart, ilen, bigEndian);
+
+	n->scale = scale;
+	BC_NUM_RDX_SET_NEG(n, rdx, 0);
+
+	bc_num_clean(n);
+
+	if (BC_NUM_NONZERO(n)) n->rdx = BC_NUM_NEG_VAL(n, neg);
+}
+
+#endif // BC_ENABLE_LIBRARY
+
 #if BC_ENABLE_EXTRA_MATH
 
 void
@@ -4053,6 +4953,13 @@ bc_num_add(BcNum* a, BcNum* b, BcNum* c, size_t scale)
 {
 	assert(BC_NUM_RDX_VALID(a));
 	assert(BC_NUM_RDX_VALID(b));
+
+	if (BC_NUM_SMALL(a) && BC_NUM_SMALL(b))
+	{
+		bc_num_smallAddSub(a, b, c, false);
+		return;
+	}
+
 	bc_num_binary(a, b, c, false, bc_num_as, bc_num_addReq(a, b, scale));
 }
 
@@ -4061,6 +4968,13 @@ bc_num_sub(BcNum* a, BcNum* b, BcNum* c, size_t scale)
 {
 	assert(BC_NUM_RDX_VALID(a));
 	assert(BC_NUM_RDX_VALID(b));
+
+	if (BC_NUM_SMALL(a) && BC_NUM_SMALL(b))
+	{
+		bc_num_smallAddSub(a, b, c, true);
+		return;
+	}
+
 	bc_num_binary(a, b, c, true, bc_num_as, bc_num_addReq(a, b, scale));
 }
 
@@ -4069,6 +4983,15 @@ bc_num_mul(BcNum* a, BcNum* b, BcNum* c, size_t scale)
 {
 	assert(BC_NUM_RDX_VALID(a));
 	assert(BC_NUM_RDX_VALID(b));
+
+	// The product of two small integers always fits in a BcBigDig.
+	if (BC_NUM_SMALL(a) && BC_NUM_SMALL(b))
+	{
+		bc_num_setSmall(c, BC_NUM_SMALL_VAL(a) * BC_NUM_SMALL_VAL(b),
+		                BC_NUM_NEG(a) != BC_NUM_NEG(b));
+		return;
+	}
+
 	bc_num_binary(a, b, c, scale, bc_num_m, bc_num_mulReq(a, b, scale));
 }
 
@@ -4077,6 +5000,15 @@ bc_num_div(BcNum* a, BcNum* b, BcNum* c, size_t scale)
 {
 	assert(BC_NUM_RDX_VALID(a));
 	assert(BC_NUM_RDX_VALID(b));
+
+	// Division by zero is left to bc_num_d() to report.
+	if (!scale && BC_NUM_SMALL(a) && BC_NUM_SMALL(b) && BC_NUM_NONZERO(b))
+	{
+		BcBigDig val = BC_NUM_SMALL_VAL(a) / BC_NUM_SMALL_VAL(b);
+		bc_num_setSmall(c, val, val && BC_NUM_NEG(a) != BC_NUM_NEG(b));
+		return;
+	}
+
 	bc_num_binary(a, b, c, scale, bc_num_d, bc_num_divReq(a, b, scale));
 }
 
@@ -4085,6 +5017,15 @@ bc_num_mod(BcNum* a, BcNum* b, BcNum* c, size_t scale)
 {
 	assert(BC_NUM_RDX_VALID(a));
 	assert(BC_NUM_RDX_VALID(b));
+
+	// The remainder takes the sign of the dividend, like bc_num_rem().
+	if (!scale && BC_NUM_SMALL(a) && BC_NUM_SMALL(b) && BC_NUM_NONZERO(b))
+	{
+		BcBigDig val = BC_NUM_SMALL_VAL(a) % BC_NUM_SMALL_VAL(b);
+		bc_num_setSmall(c, val, val && BC_NUM_NEG(a));
+		return;
+	}
+
 	bc_num_binary(a, b, c, scale, bc_num_rem, bc_num_divReq(a, b, scale));
 }
 
@@ -4356,22 +5297,245 @@ err:
 	}
 }
 
-void
-bc_num_modexp(BcNum* a, BcNum* b, BcNum* c, BcNum* restrict d)
+/**
+ * Adds the product of @a a and @a b to @a c, or subtracts it, in place. The
+ * product is made in a temporary, and then it is accumulated into the limbs of
+ * @a c with signals locked, so @a c is not changed if the multiplication fails
+ * or is interrupted.
+ * @param a      The first factor.
+ * @param b      The second factor.
+ * @param c      The number to accumulate into and the return parameter.
+ * @param scale  The current scale.
+ * @param sub    True if the product should be subtracted, false otherwise.
+ */
+static void
+bc_num_mulAccum(BcNum* a, BcNum* b, BcNum* c, size_t scale, bool sub)
 {
-	BcNum base, exp, two, temp, atemp, btemp, ctemp;
-	BcDig two_digs[2];
+	BcNum temp;
+	BcDig digs[BC_NUM_DEF_SIZE];
 #if BC_ENABLE_LIBRARY
 	BcVm* vm = bcl_getspecific();
 #endif // BC_ENABLE_LIBRARY
 
-	assert(a != NULL && b != NULL && c != NULL && d != NULL);
-	assert(a != d && b != d && c != d);
+	assert(BC_NUM_RDX_VALID(a));
+	assert(BC_NUM_RDX_VALID(b));
 
-	if (BC_ERR(BC_NUM_ZERO(c))) bc_err(BC_ERR_MATH_DIVIDE_BY_ZERO);
-	if (BC_ERR(BC_NUM_NEG(b))) bc_err(BC_ERR_MATH_NEGATIVE);
+	// The product of two small integers fits in two limbs, so it does not need
+	// an allocation. The buffer is still BC_NUM_DEF_SIZE limbs because that is
+	// the least that bc_num_expand() will accept without reallocating.
+	if (BC_NUM_SMALL(a) && BC_NUM_SMALL(b))
+	{
+		bc_num_setup(&temp, digs, sizeof(digs) / sizeof(BcDig));
+		bc_num_setSmall(&temp, BC_NUM_SMALL_VAL(a) * BC_NUM_SMALL_VAL(b),
+		                BC_NUM_NEG(a) != BC_NUM_NEG(b));
 
-#if BC_DEBUG || BC_GCC
+		BC_SIG_LOCK;
+		bc_num_accum(c, &temp, sub);
+		BC_SIG_UNLOCK;
+
+		return;
+	}
+
+	BC_SIG_LOCK;
+
+	bc_num_init(&temp, bc_num_mulReq(a, b, scale));
+
+	BC_SETJMP_LOCKED(vm, err);
+
+	BC_SIG_UNLOCK;
+
+	bc_num_mul(a, b, &temp, scale);
+
+	// The limbs of c are changed in place, so a signal must not interrupt that.
+	BC_SIG_LOCK;
+
+	bc_num_accum(c, &temp, sub);
+
+err:
+	BC_SIG_MAYLOCK;
+	bc_num_free(&temp);
+	BC_LONGJMP_CONT(vm);
+}
+
+void
+bc_num_addmul(BcNum* a, BcNum* b, BcNum* c, size_t scale)
+{
+	bc_num_mulAccum(a, b, c, scale, false);
+}
+
+void
+bc_num_submul(BcNum* a, BcNum* b, BcNum* c, size_t scale)
+{
+	bc_num_mulAccum(a, b, c, scale, true);
+}
+
+void
+bc_num_fma(BcNum* a, BcNum* b, BcNum* c, BcNum* d, size_t scale)
+{
+	assert(BC_NUM_RDX_VALID(c));
+
+	if (c == d)
+	{
+		bc_num_addmul(a, b, d, scale);
+		return;
+	}
+
+	// The product goes straight into d, and c is added to it in place.
+	bc_num_mul(a, b, d, scale);
+	bc_num_accum(d, c, false);
+}
+
+/**
+ * Divides a non-negative integer in place by a small divisor and returns the
+ * remainder. This is like bc_num_divArray(), but it does not need a second
+ * number, which makes it cheap enough to peel bits off of exponents. The
+ * divisor must be small enough that the remainder times BC_BASE_POW fits in a
+ * BcBigDig.
+ * @param n  The number to divide. It must be a non-negative integer.
+ * @param b  The divisor.
+ * @return   The remainder.
+ */
+static BcBigDig
+bc_num_divSmall(BcNum* restrict n, BcBigDig b)
+{
+	size_t i;
+	BcBigDig carry = 0;
+
+	assert(!BC_NUM_RDX_VAL(n) && !BC_NUM_NEG(n));
+	assert(b != 0 && b <= BC_NUM_EXP_CHUNK);
+
+	for (i = n->len - 1; i < n->len; --i)
+	{
+		BcBigDig in = ((BcBigDig) n->num[i]) + carry * BC_BASE_POW;
+		n->num[i] = (BcDig) (in / b);
+		carry = in % b;
+	}
+
+	bc_num_clean(n);
+
+	return carry;
+}
+
+/**
+ * Returns the remainder of the magnitude of an integer divided by a small
+ * divisor without changing the integer. This is what trial division uses.
+ * @param n  The integer.
+ * @param b  The divisor. The same limits as in bc_num_divSmall() apply.
+ * @return   The remainder.
+ */
+static BcBigDig
+bc_num_modSmall(const BcNum* restrict n, BcBigDig b)
+{
+	size_t i;
+	BcBigDig carry = 0;
+
+	assert(!BC_NUM_RDX_VAL(n));
+	assert(b != 0 && b <= BC_NUM_EXP_CHUNK);
+
+	for (i = n->len - 1; i < n->len; --i)
+	{
+		carry = (((BcBigDig) n->num[i]) + carry * BC_BASE_POW) % b;
+	}
+
+	return carry;
+}
+
+/**
+ * Adds a small value to a non-negative integer in place. This is for stepping
+ * through prime candidates without going through bc_num_binary() every time.
+ * @param n  The integer to add to.
+ * @param v  The value to add. It must be less than BC_BASE_POW.
+ */
+static void
+bc_num_addSmall(BcNum* restrict n, BcBigDig v)
+{
+	size_t i;
+
+	assert(!BC_NUM_RDX_VAL(n) && !BC_NUM_NEG(n));
+	assert(v < BC_BASE_POW);
+
+	for (i = 0; v && i < n->len; ++i)
+	{
+		BcBigDig in = ((BcBigDig) n->num[i]) + v;
+		n->num[i] = (BcDig) (in % BC_BASE_POW);
+		v = in / BC_BASE_POW;
+	}
+
+	// If there is still a carry, the number needs another limb.
+	if (v)
+	{
+		bc_num_expand(n, bc_vm_growSize(n->len, 1));
+		n->num[n->len] = (BcDig) v;
+		n->len += 1;
+	}
+}
+
+/**
+ * The engine behind modular exponentiation. It calculates @a b to the power of
+ * @a e modulo @a m. Instead of dividing the exponent by two for every bit,
+ * which costs a full division per bit, this peels BC_NUM_EXP_BITS bits at a
+ * time off of the exponent with one cheap pass over its limbs and then walks
+ * those bits with shifts.
+ * @param b     The base. It must be reduced modulo @a m already, and it is
+ *              destroyed.
+ * @param e     The exponent. It must be a non-negative integer, and it is
+ *              destroyed.
+ * @param m     The modulus. It must be a non-zero integer.
+ * @param d     The return parameter.
+ * @param temp  A scratch number for products.
+ */
+static void
+bc_num_modexpCore(BcNum* restrict b, BcNum* restrict e, BcNum* m,
+                  BcNum* restrict d, BcNum* restrict temp)
+{
+	bc_num_one(d);
+
+	while (BC_NUM_NONZERO(e))
+	{
+		size_t i;
+		BcBigDig bits = bc_num_divSmall(e, BC_NUM_EXP_CHUNK);
+
+		for (i = 0; i < BC_NUM_EXP_BITS; ++i)
+		{
+			if (bits & 1)
+			{
+				assert(BC_NUM_RDX_VALID(d));
+				assert(BC_NUM_RDX_VALID(b));
+
+				bc_num_mul(d, b, temp, 0);
+
+				// We already checked for 0.
+				bc_num_rem(temp, m, d, 0);
+			}
+
+			bits >>= 1;
+
+			// Squaring the base after the last bit would be wasted work.
+			if (!bits && BC_NUM_ZERO(e)) break;
+
+			bc_num_mul(b, b, temp, 0);
+
+			// We already checked for 0.
+			bc_num_rem(temp, m, b, 0);
+		}
+	}
+}
+
+void
+bc_num_modexp(BcNum* a, BcNum* b, BcNum* c, BcNum* restrict d)
+{
+	BcNum base, exp, temp, atemp, btemp, ctemp;
+#if BC_ENABLE_LIBRARY
+	BcVm* vm = bcl_getspecific();
+#endif // BC_ENABLE_LIBRARY
+
+	assert(a != NULL && b != NULL && c != NULL && d != NULL);
+	assert(a != d && b != d && c != d);
+
+	if (BC_ERR(BC_NUM_ZERO(c))) bc_err(BC_ERR_MATH_DIVIDE_BY_ZERO);
+	if (BC_ERR(BC_NUM_NEG(b))) bc_err(BC_ERR_MATH_NEGATIVE);
+
+#if BC_DEBUG || BC_GCC
 	// This is entirely for quieting a useless scan-build error.
 	btemp.len = 0;
 	ctemp.len = 0;
@@ -4389,56 +5553,855 @@ bc_num_modexp(BcNum* a, BcNum* b, BcNum* c, BcNum* restrict d)
 	BC_SIG_LOCK;
 
 	bc_num_init(&base, ctemp.len);
-	bc_num_setup(&two, two_digs, sizeof(two_digs) / sizeof(BcDig));
-	bc_num_init(&temp, btemp.len + 1);
+	bc_num_init(&temp, bc_vm_growSize(ctemp.len, ctemp.len));
 	bc_num_createCopy(&exp, &btemp);
 
 	BC_SETJMP_LOCKED(vm, err);
 
 	BC_SIG_UNLOCK;
 
-	bc_num_one(&two);
-	two.num[0] = 2;
-	bc_num_one(d);
-
 	// We already checked for 0.
 	bc_num_rem(&atemp, &ctemp, &base, 0);
 
-	// If you know the algorithm I used, the memory-efficient method, then this
-	// loop should be self-explanatory because it is the calculation loop.
-	while (BC_NUM_NONZERO(&exp))
+	bc_num_modexpCore(&base, &exp, &ctemp, d, &temp);
+
+err:
+	BC_SIG_MAYLOCK;
+	bc_num_free(&exp);
+	bc_num_free(&temp);
+	bc_num_free(&base);
+	BC_LONGJMP_CONT(vm);
+	assert(!BC_NUM_NEG(d) || d->len);
+	assert(BC_NUM_RDX_VALID(d));
+	assert(!d->len || d->num[d->len - 1] || BC_NUM_RDX_VAL(d) == d->len);
+}
+
+/**
+ * Reduces @a a modulo @a n into the range [0, n). This is needed because the
+ * result of bc's modulus takes the sign of the dividend.
+ * @param a  The number to reduce. It must not be the same as @a c.
+ * @param n  The modulus. It must be positive.
+ * @param c  The return parameter.
+ */
+static void
+bc_num_modNorm(BcNum* a, BcNum* n, BcNum* restrict c)
+{
+	assert(a != c);
+
+	bc_num_rem(a, n, c, 0);
+
+	if (BC_NUM_NEG(c)) bc_num_add(c, n, c, 0);
+}
+
+/**
+ * Halves @a a modulo the odd number @a n. @a a must be in the range [0, n).
+ * @param a  The number to halve.
+ * @param n  The odd modulus.
+ */
+static void
+bc_num_halfMod(BcNum* a, BcNum* n)
+{
+	BcBigDig rem;
+
+	// If it is odd, adding the odd modulus makes it even without changing the
+	// residue.
+	if (BC_NUM_NONZERO(a) && (a->num[0] & 1)) bc_num_add(a, n, a, 0);
+
+	rem = bc_num_divSmall(a, 2);
+
+	assert(!rem);
+
+	// Quiet a warning in release builds.
+	BC_UNUSED(rem);
+}
+
+/**
+ * Runs one round of the Miller-Rabin test, which is a strong probable prime
+ * test, on @a n with base @a a.
+ * @param n     The odd number to test. It must be greater than @a a.
+ * @param nm1   @a n minus 1.
+ * @param q     The odd part of @a nm1.
+ * @param s     The number of times that 2 divides @a nm1.
+ * @param a     The base.
+ * @param x     A scratch number for the base.
+ * @param e     A scratch number for the exponent.
+ * @param y     A scratch number for the power.
+ * @param temp  A scratch number for products.
+ * @return      True if @a n is a strong probable prime to base @a a, false
+ *              if @a n is definitely composite.
+ */
+static bool
+bc_num_sprp(BcNum* n, BcNum* nm1, const BcNum* q, size_t s, BcBigDig a,
+            BcNum* restrict x, BcNum* restrict e, BcNum* restrict y,
+            BcNum* restrict temp)
+{
+	size_t i;
+
+	bc_num_bigdig2num(x, a);
+	bc_num_copy(e, q);
+
+	bc_num_modexpCore(x, e, n, y, temp);
+
+	if (BC_NUM_ONE(y) || !bc_num_cmp(y, nm1)) return true;
+
+	for (i = 1; i < s; ++i)
 	{
-		// Num two cannot be 0, so no errors.
-		bc_num_divmod(&exp, &two, &exp, &temp, 0);
+		bc_num_mul(y, y, temp, 0);
+		bc_num_rem(temp, n, y, 0);
+
+		if (!bc_num_cmp(y, nm1)) return true;
+		if (BC_NUM_ONE(y)) return false;
+	}
 
-		if (BC_NUM_ONE(&temp) && !BC_NUM_NEG_NP(temp))
+	return false;
+}
+
+/**
+ * Calculates the Jacobi symbol (D/n) for a small odd D and a large odd @a n.
+ * @param n    The odd number on the bottom.
+ * @param d    The magnitude of D, which must be odd.
+ * @param neg  True if D is negative.
+ * @return     The Jacobi symbol, which is -1, 0, or 1.
+ */
+static int
+bc_num_jacobi(const BcNum* restrict n, BcBigDig d, bool neg)
+{
+	BcBigDig a, b, t, n4 = bc_num_modSmall(n, 4);
+	int j = 1;
+
+	assert(d & 1);
+
+	// (-1/n) is -1 when n is 3 mod 4.
+	if (neg && n4 == 3) j = -j;
+
+	// Quadratic reciprocity turns (d/n) into (n/d), which is small.
+	if ((d & 3) == 3 && n4 == 3) j = -j;
+
+	a = bc_num_modSmall(n, d);
+	b = d;
+
+	while (a)
+	{
+		while (!(a & 1))
 		{
-			assert(BC_NUM_RDX_VALID(d));
-			assert(BC_NUM_RDX_VALID_NP(base));
+			a >>= 1;
+			t = b & 7;
+			if (t == 3 || t == 5) j = -j;
+		}
 
-			bc_num_mul(d, &base, &temp, 0);
+		t = a;
+		a = b;
+		b = t;
 
-			// We already checked for 0.
-			bc_num_rem(&temp, &ctemp, d, 0);
+		if ((a & 3) == 3 && (b & 3) == 3) j = -j;
+
+		a %= b;
+	}
+
+	return b == 1 ? j : 0;
+}
+
+/**
+ * Returns true if @a n is a perfect square.
+ * @param n  The integer to check. It must be positive.
+ * @return   True if @a n is a perfect square, false otherwise.
+ */
+static bool
+bc_num_isSquare(BcNum* n)
+{
+	BcNum r, t;
+	// This is volatile to quiet a warning on GCC about clobbering with
+	// longjmp().
+	volatile bool square = false;
+#if BC_ENABLE_LIBRARY
+	BcVm* vm = bcl_getspecific();
+#endif // BC_ENABLE_LIBRARY
+
+	// bc_num_sqrt() initializes r itself, so this is how to tell if it needs
+	// to be freed.
+	bc_num_clear(&r);
+
+	BC_SIG_LOCK;
+
+	bc_num_init(&t, bc_vm_growSize(n->len, n->len));
+
+	BC_SETJMP_LOCKED(vm, err);
+
+	BC_SIG_UNLOCK;
+
+	bc_num_sqrt(n, &r, 0);
+	bc_num_mul(&r, &r, &t, 0);
+
+	square = !bc_num_cmp(&t, n);
+
+err:
+	BC_SIG_MAYLOCK;
+	if (r.num != NULL) bc_num_free(&r);
+	bc_num_free(&t);
+	BC_LONGJMP_CONT(vm);
+
+	return square;
+}
+
+/**
+ * Runs the strong Lucas probable prime test on @a n with the parameters
+ * selected by Selfridge's method A. Together with a Miller-Rabin round with
+ * base 2, this makes up the Baillie-PSW test.
+ * @param n  The odd number to test. It must be larger than the largest prime
+ *           in bc_num_primes, and it must have no factors in that table.
+ * @return   True if @a n is a strong Lucas probable prime, false if it is
+ *           definitely composite.
+ */
+static bool
+bc_num_slprp(BcNum* n)
+{
+	BcNum u, v, qk, qn, dn, k, t1, t2, t3;
+	BcDig qn_digs[BC_NUM_BIGDIG_LOG10], dn_digs[BC_NUM_BIGDIG_LOG10];
+	BcVec bits;
+	BcBigDig d = 5;
+	size_t i, s, len;
+	bool neg = false;
+	int j;
+	// This is volatile to quiet a warning on GCC about clobbering with
+	// longjmp().
+	volatile bool prime = false;
+#if BC_ENABLE_LIBRARY
+	BcVm* vm = bcl_getspecific();
+#endif // BC_ENABLE_LIBRARY
+
+	// Find the first D in 5, -7, 9, -11, ... with (D/n) = -1. If n is a
+	// perfect square, no such D exists, so that has to be checked before the
+	// search gets too long.
+	while ((j = bc_num_jacobi(n, d, neg)) != -1)
+	{
+		// A zero means that n shares a factor with D, which is smaller.
+		if (!j) return false;
+
+		d += 2;
+		neg = !neg;
+
+		if (d == BC_NUM_LUCAS_SQR_CHECK && bc_num_isSquare(n)) return false;
+	}
+
+	bc_num_setup(&dn, dn_digs, sizeof(dn_digs) / sizeof(BcDig));
+	bc_num_setup(&qn, qn_digs, sizeof(qn_digs) / sizeof(BcDig));
+
+	// D, and Q = (1 - D) / 4. With P = 1, Q is all that is left.
+	bc_num_bigdig2num(&dn, d);
+	if (neg) BC_NUM_NEG_TGL_NP(dn);
+	bc_num_bigdig2num(&qn, neg ? (d + 1) / 4 : (d - 1) / 4);
+	if (!neg) BC_NUM_NEG_TGL_NP(qn);
+
+	len = bc_vm_growSize(n->len, n->len);
+
+	BC_SIG_LOCK;
+
+	bc_vec_init(&bits, sizeof(BcBigDig), BC_DTOR_NONE);
+	bc_num_init(&u, n->len);
+	bc_num_init(&v, n->len);
+	bc_num_init(&qk, n->len);
+	bc_num_init(&t1, len);
+	bc_num_init(&t2, len);
+	bc_num_init(&t3, len);
+	bc_num_createCopy(&k, n);
+
+	BC_SETJMP_LOCKED(vm, err);
+
+	BC_SIG_UNLOCK;
+
+	// k = n + 1 = q * 2^s, where q is odd.
+	bc_num_addSmall(&k, 1);
+	for (s = 0; !(k.num[0] & 1); ++s)
+	{
+		bc_num_divSmall(&k, 2);
+	}
+
+	// Split k into chunks of bits so it can be walked from the top.
+	while (BC_NUM_NONZERO(&k))
+	{
+		BcBigDig chunk = bc_num_divSmall(&k, BC_NUM_EXP_CHUNK);
+		bc_vec_push(&bits, &chunk);
+	}
+
+	// U_1 = 1, V_1 = P = 1, and Q^1.
+	bc_num_one(&u);
+	bc_num_one(&v);
+	bc_num_modNorm(&qn, n, &qk);
+
+	for (i = bits.len - 1; i < bits.len; --i)
+	{
+		BcBigDig chunk = *((BcBigDig*) bc_vec_item(&bits, i));
+		size_t bit = BC_NUM_EXP_BITS;
+
+		// Skip the leading one because it is where U_1 and V_1 came from.
+		if (i == bits.len - 1)
+		{
+			while (!((chunk >> (bit - 1)) & 1))
+			{
+				bit -= 1;
+			}
+
+			bit -= 1;
+		}
+
+		while (bit--)
+		{
+			// U_2k = U_k * V_k
+			bc_num_mul(&u, &v, &t1, 0);
+			bc_num_rem(&t1, n, &u, 0);
+
+			// V_2k = V_k^2 - 2 * Q^k
+			bc_num_mul(&v, &v, &t1, 0);
+			bc_num_add(&qk, &qk, &t2, 0);
+			bc_num_sub(&t1, &t2, &t3, 0);
+			bc_num_modNorm(&t3, n, &v);
+
+			// Q^2k
+			bc_num_mul(&qk, &qk, &t1, 0);
+			bc_num_rem(&t1, n, &qk, 0);
+
+			if ((chunk >> bit) & 1)
+			{
+				// U_2k+1 = (P * U_2k + V_2k) / 2
+				// V_2k+1 = (D * U_2k + P * V_2k) / 2
+				bc_num_mul(&dn, &u, &t1, 0);
+				bc_num_add(&t1, &v, &t2, 0);
+				bc_num_add(&u, &v, &t1, 0);
+				bc_num_modNorm(&t1, n, &u);
+				bc_num_modNorm(&t2, n, &v);
+				bc_num_halfMod(&u, n);
+				bc_num_halfMod(&v, n);
+
+				// Q^2k+1
+				bc_num_mul(&qk, &qn, &t1, 0);
+				bc_num_modNorm(&t1, n, &qk);
+			}
 		}
+	}
 
-		assert(BC_NUM_RDX_VALID_NP(base));
+	// n is a strong Lucas probable prime if U_q is 0 or if V_(q * 2^r) is 0
+	// for some r less than s.
+	prime = (BC_NUM_ZERO(&u) || BC_NUM_ZERO(&v));
+
+	for (i = 1; !prime && i < s; ++i)
+	{
+		bc_num_mul(&v, &v, &t1, 0);
+		bc_num_add(&qk, &qk, &t2, 0);
+		bc_num_sub(&t1, &t2, &t3, 0);
+		bc_num_modNorm(&t3, n, &v);
 
-		bc_num_mul(&base, &base, &temp, 0);
+		prime = BC_NUM_ZERO(&v);
 
-		// We already checked for 0.
-		bc_num_rem(&temp, &ctemp, &base, 0);
+		bc_num_mul(&qk, &qk, &t1, 0);
+		bc_num_rem(&t1, n, &qk, 0);
+	}
+
+err:
+	BC_SIG_MAYLOCK;
+	bc_num_free(&k);
+	bc_num_free(&t3);
+	bc_num_free(&t2);
+	bc_num_free(&t1);
+	bc_num_free(&qk);
+	bc_num_free(&v);
+	bc_num_free(&u);
+	bc_vec_free(&bits);
+	BC_LONGJMP_CONT(vm);
+
+	return prime;
+}
+
+/**
+ * Tests a number for primality after trial division has failed to decide. If
+ * @a bpsw is false and @a n is below the bound where the first 13 primes are
+ * known to be a complete set of Miller-Rabin witnesses, the test is
+ * deterministic. Otherwise, the Baillie-PSW test is used, which has no known
+ * counterexamples.
+ * @param n     The odd number to test. It must be larger than the square of
+ *              the largest prime in bc_num_primes, and it must have no
+ *              factors in that table.
+ * @param bpsw  True if the Baillie-PSW test should be used no matter what.
+ * @return      True if @a n is prime, false otherwise.
+ */
+static bool
+bc_num_primeTest(BcNum* n, bool bpsw)
+{
+	BcNum nm1, q, x, e, y, temp, bound;
+	BcDig bound_digs[BC_NUM_BIGDIG_LOG10];
+	size_t i, s, len;
+	bool det;
+	// This is volatile to quiet a warning on GCC about clobbering with
+	// longjmp().
+	volatile bool prime = false;
+#if BC_ENABLE_LIBRARY
+	BcVm* vm = bcl_getspecific();
+#endif // BC_ENABLE_LIBRARY
+
+	assert(n->num[0] & 1);
+
+	bc_num_setup(&bound, bound_digs, sizeof(bound_digs) / sizeof(BcDig));
+
+	// NOLINTNEXTLINE
+	memcpy(bound.num, bc_num_mrBound, BC_NUM_SIZE(bc_num_mrBound_size));
+	bound.len = bc_num_mrBound_size;
+
+	det = (!bpsw && bc_num_cmp(n, &bound) < 0);
+
+	len = bc_vm_growSize(n->len, n->len);
+
+	BC_SIG_LOCK;
+
+	bc_num_init(&nm1, n->len);
+	bc_num_init(&q, n->len);
+	bc_num_init(&x, n->len);
+	bc_num_init(&e, n->len);
+	bc_num_init(&y, n->len);
+	bc_num_init(&temp, len);
+
+	BC_SETJMP_LOCKED(vm, err);
+
+	BC_SIG_UNLOCK;
+
+	// n - 1 = q * 2^s, where q is odd.
+	bc_num_copy(&nm1, n);
+	nm1.num[0] -= 1;
+	bc_num_copy(&q, &nm1);
+
+	for (s = 0; !(q.num[0] & 1); ++s)
+	{
+		bc_num_divSmall(&q, 2);
+	}
+
+	if (det)
+	{
+		prime = true;
+
+		for (i = 0; prime && i < BC_NUM_MR_BASES; ++i)
+		{
+			prime = bc_num_sprp(n, &nm1, &q, s, bc_num_primes[i], &x, &e, &y,
+			                    &temp);
+		}
+	}
+	else
+	{
+		prime = bc_num_sprp(n, &nm1, &q, s, 2, &x, &e, &y, &temp) &&
+		        bc_num_slprp(n);
 	}
 
 err:
 	BC_SIG_MAYLOCK;
-	bc_num_free(&exp);
 	bc_num_free(&temp);
-	bc_num_free(&base);
+	bc_num_free(&y);
+	bc_num_free(&e);
+	bc_num_free(&x);
+	bc_num_free(&q);
+	bc_num_free(&nm1);
+	BC_LONGJMP_CONT(vm);
+
+	return prime;
+}
+
+/**
+ * Returns true if @a n is less than the square of the first prime after the
+ * ones in bc_num_primes. If @a n has no factors in that table, and this
+ * returns true, then @a n is prime.
+ * @param n  The number to check.
+ * @return   True if @a n is small enough that trial division is conclusive.
+ */
+static bool
+bc_num_trialConclusive(const BcNum* n)
+{
+	BcNum lim;
+	BcDig lim_digs[BC_NUM_BIGDIG_LOG10];
+
+	bc_num_setup(&lim, lim_digs, sizeof(lim_digs) / sizeof(BcDig));
+	bc_num_bigdig2num(&lim, BC_NUM_PRIMES_LIMIT);
+
+	return bc_num_cmp(n, &lim) < 0;
+}
+
+bool
+bc_num_isPrime(BcNum* a, bool bpsw)
+{
+	BcNum n;
+	size_t i;
+
+	assert(a != NULL);
+
+	if (BC_ERR(bc_num_nonInt(a, &n))) bc_err(BC_ERR_MATH_NON_INTEGER);
+
+	// Nothing less than 2 is prime.
+	if (BC_NUM_NEG_NP(n) || BC_NUM_ZERO(&n) || BC_NUM_ONE(&n)) return false;
+
+	// Trial division first. It decides most numbers.
+	for (i = 0; i < BC_NUM_NPRIMES; ++i)
+	{
+		if (!bc_num_modSmall(&n, bc_num_primes[i]))
+		{
+			return n.len == 1 && (BcBigDig) n.num[0] == bc_num_primes[i];
+		}
+	}
+
+	if (bc_num_trialConclusive(&n)) return true;
+
+	return bc_num_primeTest(&n, bpsw);
+}
+
+void
+bc_num_nextPrime(BcNum* a, BcNum* restrict b)
+{
+	BcNum n;
+	BcBigDig rems[BC_NUM_NPRIMES];
+	size_t i;
+	bool found = false;
+
+	assert(a != NULL && b != NULL && a != b);
+
+	if (BC_ERR(bc_num_nonInt(a, &n))) bc_err(BC_ERR_MATH_NON_INTEGER);
+
+	// The first prime is the answer for anything less than 2.
+	if (BC_NUM_NEG_NP(n) || BC_NUM_ZERO(&n) || BC_NUM_ONE(&n))
+	{
+		bc_num_bigdig2num(b, 2);
+		return;
+	}
+
+	// Start at the first odd number after n.
+	bc_num_copy(b, &n);
+	bc_num_addSmall(b, (b->num[0] & 1) ? 2 : 1);
+
+	// Instead of doing trial division on every candidate, keep the remainders
+	// of the candidate by the small primes and update them as it steps. Only
+	// candidates that survive the sieve get the expensive test. Skipping 2 is
+	// fine because all candidates are odd.
+	for (i = 1; i < BC_NUM_NPRIMES; ++i)
+	{
+		rems[i] = bc_num_modSmall(b, bc_num_primes[i]);
+	}
+
+	while (!found)
+	{
+		found = true;
+
+		for (i = 1; found && i < BC_NUM_NPRIMES; ++i)
+		{
+			// The candidate can only be one of the small primes if it is that
+			// prime.
+			found = (rems[i] != 0 ||
+			         (b->len == 1 && (BcBigDig) b->num[0] == bc_num_primes[i]));
+		}
+
+		if (found && !bc_num_trialConclusive(b))
+		{
+			found = bc_num_primeTest(b, false);
+		}
+
+		if (!found)
+		{
+			bc_num_addSmall(b, 2);
+
+			for (i = 1; i < BC_NUM_NPRIMES; ++i)
+			{
+				rems[i] = (rems[i] + 2) % bc_num_primes[i];
+			}
+		}
+	}
+
+	assert(BC_NUM_RDX_VALID(b));
+}
+
+/**
+ * Sets @a c to s * a + t * b, where s and t are single-limb multipliers. This
+ * is the step of Lehmer's algorithm that applies the cofactors collected from
+ * the leading digits to the full numbers.
+ * @param a   The first number.
+ * @param s   The multiplier for @a a. Its magnitude must be at most
+ *            BC_BASE_POW.
+ * @param b   The second number.
+ * @param t   The multiplier for @a b. Its magnitude must be at most
+ *            BC_BASE_POW.
+ * @param c   The return parameter.
+ * @param t1  A scratch number.
+ * @param t2  A scratch number.
+ */
+static void
+bc_num_lehmerCombine(const BcNum* a, long s, const BcNum* b, long t,
+                     BcNum* restrict c, BcNum* restrict t1,
+                     BcNum* restrict t2)
+{
+	bc_num_zero(t1);
+	bc_num_mulArray(a, (BcBigDig) (s < 0 ? -s : s), t1);
+	if (BC_NUM_NONZERO(t1) && (BC_NUM_NEG(a) != 0) != (s < 0))
+	{
+		BC_NUM_NEG_TGL(t1);
+	}
+
+	bc_num_zero(t2);
+	bc_num_mulArray(b, (BcBigDig) (t < 0 ? -t : t), t2);
+	if (BC_NUM_NONZERO(t2) && (BC_NUM_NEG(b) != 0) != (t < 0))
+	{
+		BC_NUM_NEG_TGL(t2);
+	}
+
+	bc_num_add(t1, t2, c, 0);
+}
+
+/**
+ * Runs Lehmer's version of the extended Euclidean algorithm. Instead of doing a
+ * full division for every step, it runs the steps on the leading digits of the
+ * numbers in machine words for as long as they are guaranteed to give the same
+ * quotients as the full numbers would (Collins' condition). Then it applies all
+ * of those steps at once with single-limb multiplications. It only falls back
+ * to a full division when the leading digits cannot decide a step.
+ *
+ * The numbers are passed in as an array of BC_NUM_LEHMER_NUMS initialized
+ * numbers. The first two must be the non-negative integers to find the GCD of,
+ * and the next two must be their cofactors with respect to whatever number the
+ * caller wants a cofactor for. The rest are scratch.
+ * @param n  The array of numbers.
+ * @param g  The return parameter for the GCD.
+ * @param x  The return parameter for the cofactor of the GCD.
+ */
+static void
+bc_num_lehmer(BcNum* n, BcNum* restrict g, BcNum* x)
+{
+	BcNum* u = &n[0];
+	BcNum* v = &n[1];
+	BcNum* xu = &n[2];
+	BcNum* xv = &n[3];
+	BcNum* nu = &n[4];
+	BcNum* nv = &n[5];
+	BcNum* t1 = &n[6];
+	BcNum* t2 = &n[7];
+	BcNum* temp;
+
+	assert(!BC_NUM_NEG(u) && !BC_NUM_NEG(v));
+	assert(!BC_NUM_RDX_VAL(u) && !BC_NUM_RDX_VAL(v));
+
+	// The algorithm needs u >= v.
+	if (bc_num_cmp(u, v) < 0)
+	{
+		temp = u;
+		u = v;
+		v = temp;
+		temp = xu;
+		xu = xv;
+		xv = temp;
+	}
+
+	while (BC_NUM_NONZERO(v))
+	{
+		long A = 1, B = 0, C = 0, D = 1, q, T, uh, vh;
+		size_t len = u->len;
+
+		// Get the leading digits of both numbers with the same shift. They are
+		// limited to one limb so that the cofactors are too.
+		if (len == 1)
+		{
+			uh = (long) u->num[0];
+			vh = (long) v->num[0];
+		}
+		else
+		{
+			BcBigDig pow = bc_num_pow10[bc_num_log10((size_t) u->num[len - 1])];
+			BcBigDig top;
+
+			top = ((BcBigDig) u->num[len - 1]) * BC_BASE_POW +
+			      (BcBigDig) u->num[len - 2];
+			uh = (long) (top / pow);
+
+			top = v->len == len ? ((BcBigDig) v->num[len - 1]) * BC_BASE_POW :
+			                      0;
+			top += v->len >= len - 1 ? (BcBigDig) v->num[len - 2] : 0;
+			vh = (long) (top / pow);
+		}
+
+		// Run Euclid on the leading digits while the quotient is certain.
+		while (vh + C != 0 && vh + D != 0)
+		{
+			q = (uh + A) / (vh + C);
+
+			if (q != (uh + B) / (vh + D)) break;
+
+			T = A - q * C;
+			A = C;
+			C = T;
+			T = B - q * D;
+			B = D;
+			D = T;
+			T = uh - q * vh;
+			uh = vh;
+			vh = T;
+		}
+
+		if (!B)
+		{
+			// The leading digits could not decide a single step, so do one
+			// with a full division. Both outputs need to be zeroed because
+			// the quick path of bc_num_divmod() only sets the limbs.
+			bc_num_zero(t1);
+			bc_num_zero(nv);
+			bc_num_divmod(u, v, t1, nv, 0);
+			bc_num_mul(t1, xv, t2, 0);
+			bc_num_sub(xu, t2, nu, 0);
+
+			temp = u;
+			u = v;
+			v = nv;
+			nv = temp;
+			temp = xu;
+			xu = xv;
+			xv = nu;
+			nu = temp;
+		}
+		else
+		{
+			bc_num_lehmerCombine(u, A, v, B, nu, t1, t2);
+			bc_num_lehmerCombine(u, C, v, D, nv, t1, t2);
+
+			temp = u;
+			u = nu;
+			nu = temp;
+			temp = v;
+			v = nv;
+			nv = temp;
+
+			bc_num_lehmerCombine(xu, A, xv, B, nu, t1, t2);
+			bc_num_lehmerCombine(xu, C, xv, D, nv, t1, t2);
+
+			temp = xu;
+			xu = nu;
+			nu = temp;
+			temp = xv;
+			xv = nv;
+			nv = temp;
+		}
+	}
+
+	bc_num_copy(g, u);
+	bc_num_copy(x, xu);
+}
+
+void
+bc_num_egcd(BcNum* a, BcNum* b, BcNum* restrict g, BcNum* restrict x,
+            BcNum* restrict y)
+{
+	BcNum n[BC_NUM_LEHMER_NUMS];
+	BcNum atemp, btemp;
+	size_t i, len;
+#if BC_ENABLE_LIBRARY
+	BcVm* vm = bcl_getspecific();
+#endif // BC_ENABLE_LIBRARY
+
+	assert(a != NULL && b != NULL && g != NULL && x != NULL && y != NULL);
+	assert(a != g && a != x && a != y && b != g && b != x && b != y);
+
+	// Eliminate fractional parts that are zero or error if they are not zero.
+	if (BC_ERR(bc_num_nonInt(a, &atemp) || bc_num_nonInt(b, &btemp)))
+	{
+		bc_err(BC_ERR_MATH_NON_INTEGER);
+	}
+
+	len = BC_MAX(atemp.len, btemp.len) + 1;
+
+	BC_SIG_LOCK;
+
+	for (i = 0; i < BC_NUM_LEHMER_NUMS; ++i)
+	{
+		bc_num_init(&n[i], len);
+	}
+
+	BC_SETJMP_LOCKED(vm, err);
+
+	BC_SIG_UNLOCK;
+
+	// Find the GCD of the magnitudes, keeping the cofactor of a.
+	bc_num_copy(&n[0], &atemp);
+	BC_NUM_NEG_CLR_NP(n[0]);
+	bc_num_copy(&n[1], &btemp);
+	BC_NUM_NEG_CLR_NP(n[1]);
+	if (BC_NUM_NONZERO(&atemp)) bc_num_one(&n[2]);
+
+	bc_num_lehmer(n, g, x);
+
+	if (BC_NUM_NEG_NP(atemp) && BC_NUM_NONZERO(x)) BC_NUM_NEG_TGL(x);
+
+	// The other cofactor can be calculated from the first with one division,
+	// which is cheaper than carrying it through the whole algorithm.
+	if (BC_NUM_ZERO(&btemp)) bc_num_zero(y);
+	else
+	{
+		bc_num_mul(&atemp, x, &n[0], 0);
+		bc_num_sub(g, &n[0], &n[1], 0);
+		bc_num_div(&n[1], &btemp, y, 0);
+	}
+
+err:
+	BC_SIG_MAYLOCK;
+	for (i = 0; i < BC_NUM_LEHMER_NUMS; ++i)
+	{
+		bc_num_free(&n[i]);
+	}
+	BC_LONGJMP_CONT(vm);
+}
+
+void
+bc_num_modinv(BcNum* a, BcNum* b, BcNum* restrict c)
+{
+	BcNum n[BC_NUM_LEHMER_NUMS];
+	BcNum atemp, btemp, g;
+	size_t i, len;
+#if BC_ENABLE_LIBRARY
+	BcVm* vm = bcl_getspecific();
+#endif // BC_ENABLE_LIBRARY
+
+	assert(a != NULL && b != NULL && c != NULL);
+	assert(a != c && b != c);
+
+	if (BC_ERR(BC_NUM_ZERO(b))) bc_err(BC_ERR_MATH_DIVIDE_BY_ZERO);
+
+	// Eliminate fractional parts that are zero or error if they are not zero.
+	if (BC_ERR(bc_num_nonInt(a, &atemp) || bc_num_nonInt(b, &btemp)))
+	{
+		bc_err(BC_ERR_MATH_NON_INTEGER);
+	}
+
+	BC_NUM_NEG_CLR_NP(btemp);
+
+	len = BC_MAX(atemp.len, btemp.len) + 1;
+
+	BC_SIG_LOCK;
+
+	bc_num_init(&g, btemp.len);
+
+	for (i = 0; i < BC_NUM_LEHMER_NUMS; ++i)
+	{
+		bc_num_init(&n[i], len);
+	}
+
+	BC_SETJMP_LOCKED(vm, err);
+
+	BC_SIG_UNLOCK;
+
+	// Only the cofactor of a matters, so start with a reduced into [0, b).
+	bc_num_copy(&n[0], &btemp);
+	bc_num_modNorm(&atemp, &btemp, &n[1]);
+	bc_num_one(&n[3]);
+
+	bc_num_lehmer(n, &g, &n[2]);
+
+	// If the GCD is not 1, there is no inverse, and the answer is 0.
+	if (BC_NUM_ONE(&g)) bc_num_modNorm(&n[2], &btemp, c);
+	else bc_num_zero(c);
+
+err:
+	BC_SIG_MAYLOCK;
+	for (i = 0; i < BC_NUM_LEHMER_NUMS; ++i)
+	{
+		bc_num_free(&n[i]);
+	}
+	bc_num_free(&g);
 	BC_LONGJMP_CONT(vm);
-	assert(!BC_NUM_NEG(d) || d->len);
-	assert(BC_NUM_RDX_VALID(d));
-	assert(!d->len || d->num[d->len - 1] || BC_NUM_RDX_VAL(d) == d->len);
 }
 
 #if BC_DEBUG_CODE
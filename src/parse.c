@@ -82,41 +82,18 @@ bc_parse_addString(BcParse* p)
 	bc_parse_pushInstIdx(p, BC_INST_STR, idx);
 }
 
-static void
-bc_parse_addNum(BcParse* p, const char* string)
+size_t
+bc_parse_addConst(BcParse* p, const char* string)
 {
 	BcProgram* prog = p->prog;
 	size_t idx;
 
-	// XXX: This function has an implicit assumption: that string is a valid C
-	// string with a nul terminator. This is because of the unchecked array
-	// accesses below. I can't check this with an assert() because that could
-	// lead to out-of-bounds access.
-	//
-	// XXX: In fact, just for safety's sake, assume that this function needs a
-	// non-empty string with a nul terminator, just in case bc_parse_zero or
-	// bc_parse_one change in the future, which I doubt.
-
 	BC_SIG_ASSERT_LOCKED;
 
-	// Special case 0.
-	if (bc_parse_zero[0] == string[0] && bc_parse_zero[1] == string[1])
-	{
-		bc_parse_push(p, BC_INST_ZERO);
-		return;
-	}
-
-	// Special case 1.
-	if (bc_parse_one[0] == string[0] && bc_parse_one[1] == string[1])
-	{
-		bc_parse_push(p, BC_INST_ONE);
-		return;
-	}
-
 	if (bc_map_insert(&prog->const_map, string, prog->consts.len, &idx))
 	{
 		BcConst* c;
-		BcId* id = bc_vec_item(&prog->const_map, idx);
+		BcId* id = bc_vec_item(&prog->const_map.ids, idx);
 
 		// Get the index.
 		idx = id->idx;
@@ -129,17 +106,58 @@ bc_parse_addNum(BcParse* p, const char* string)
 		c->val = id->name;
 		c->base = BC_NUM_BIGDIG_MAX;
 
+#if BC_ENABLED
+		// This is not a folded constant.
+		c->op = BC_INST_INVALID;
+#endif // BC_ENABLED
+
 		// We need this to be able to tell that the number has not been
 		// allocated.
 		bc_num_clear(&c->num);
 	}
 	else
 	{
-		BcId* id = bc_vec_item(&prog->const_map, idx);
+		BcId* id = bc_vec_item(&prog->const_map.ids, idx);
 		idx = id->idx;
 	}
 
-	bc_parse_pushInstIdx(p, BC_INST_NUM, idx);
+	return idx;
+}
+
+/**
+ * Pushes a number, as a constant if it is not 0 or 1.
+ * @param p       The parser.
+ * @param string  The string of the number.
+ */
+static void
+bc_parse_addNum(BcParse* p, const char* string)
+{
+	// XXX: This function has an implicit assumption: that string is a valid C
+	// string with a nul terminator. This is because of the unchecked array
+	// accesses below. I can't check this with an assert() because that could
+	// lead to out-of-bounds access.
+	//
+	// XXX: In fact, just for safety's sake, assume that this function needs a
+	// non-empty string with a nul terminator, just in case bc_parse_zero or
+	// bc_parse_one change in the future, which I doubt.
+
+	BC_SIG_ASSERT_LOCKED;
+
+	// Special case 0.
+	if (bc_parse_zero[0] == string[0] && bc_parse_zero[1] == string[1])
+	{
+		bc_parse_push(p, BC_INST_ZERO);
+		return;
+	}
+
+	// Special case 1.
+	if (bc_parse_one[0] == string[0] && bc_parse_one[1] == string[1])
+	{
+		bc_parse_push(p, BC_INST_ONE);
+		return;
+	}
+
+	bc_parse_pushInstIdx(p, BC_INST_NUM, bc_parse_addConst(p, string));
 }
 
 void
@@ -213,6 +231,7 @@ bc_parse_reset(BcParse* p)
 		bc_vec_popAll(&p->exits);
 		bc_vec_popAll(&p->conds);
 		bc_vec_popAll(&p->ops);
+		bc_vec_popAll(&p->folds);
 	}
 #endif // BC_ENABLED
 
@@ -240,6 +259,7 @@ bc_parse_free(BcParse* p)
 		bc_vec_free(&p->conds);
 		bc_vec_free(&p->ops);
 		bc_vec_free(&p->buf);
+		bc_vec_free(&p->folds);
 	}
 #endif // BC_ENABLED
 
@@ -270,6 +290,7 @@ bc_parse_init(BcParse* p, BcProgram* prog, size_t func)
 		bc_vec_init(&p->conds, sizeof(size_t), BC_DTOR_NONE);
 		bc_vec_init(&p->ops, sizeof(BcLexType), BC_DTOR_NONE);
 		bc_vec_init(&p->buf, sizeof(char), BC_DTOR_NONE);
+		bc_vec_init(&p->folds, sizeof(size_t), BC_DTOR_NONE);
 
 		p->auto_part = false;
 	}
@@ -227,7 +227,7 @@ bc_program_addString(BcProgram* p, const char* str)
 	if (bc_map_insert(&p->str_map, str, p->strs.len, &idx))
 	{
 		char** str_ptr;
-		BcId* id = bc_vec_item(&p->str_map, idx);
+		BcId* id = bc_vec_item(&p->str_map.ids, idx);
 
 		// Get the index.
 		idx = id->idx;
@@ -241,7 +241,7 @@ bc_program_addString(BcProgram* p, const char* str)
 	}
 	else
 	{
-		BcId* id = bc_vec_item(&p->str_map, idx);
+		BcId* id = bc_vec_item(&p->str_map.ids, idx);
 		idx = id->idx;
 	}
 
@@ -252,7 +252,7 @@ size_t
 bc_program_search(BcProgram* p, const char* name, bool var)
 {
 	BcVec* v;
-	BcVec* map;
+	BcMap* map;
 	size_t i;
 
 	BC_SIG_ASSERT_LOCKED;
@@ -271,9 +271,34 @@ bc_program_search(BcProgram* p, const char* name, bool var)
 		bc_array_init(temp, var, var);
 	}
 
-	return ((BcId*) bc_vec_item(map, i))->idx;
+	return ((BcId*) bc_vec_item(&map->ids, i))->idx;
 }
 
+#if BC_ENABLED
+size_t
+bc_program_inlineVar(BcProgram* p, size_t i)
+{
+	// Enough for the paren, the digits of any size_t, and the nul byte.
+	char name[sizeof(size_t) * CHAR_BIT / 3 + 3];
+	size_t len = 0;
+
+	// The paren makes sure that no real variable has the name. The digits are
+	// in reverse order, but the name only needs to be unique.
+	name[len++] = '(';
+
+	do
+	{
+		name[len++] = (char) ('0' + i % 10);
+		i /= 10;
+	}
+	while (i);
+
+	name[len] = '\0';
+
+	return bc_program_search(p, name, true);
+}
+#endif // BC_ENABLED
+
 /**
  * Returns the correct variable or array stack for the type.
  * @param p     The program.
@@ -395,6 +420,17 @@ bc_program_num(BcProgram* p, BcResult* r)
 			break;
 		}
 
+		case BC_RESULT_CONST:
+		{
+			// This does not call bc_program_constNum() because the constant
+			// must keep the value it had when it was pushed. If it were going
+			// to change, bc_program_constDetach() would have already turned
+			// this result into a copy.
+			BcConst* c = bc_vec_item(&p->consts, r->d.loc.loc);
+			n = &c->num;
+			break;
+		}
+
 		case BC_RESULT_ZERO:
 		{
 			n = &vm->zero;
@@ -631,29 +667,119 @@ bc_program_prepResult(BcProgram* p)
 	return res;
 }
 
+static BcNum*
+bc_program_constNum(BcProgram* p, size_t idx);
+
 /**
- * Prepares a constant for use. This parses the constant into a number and then
- * pushes that number onto the results stack.
- * @param p     The program.
- * @param code  The bytecode vector that we will pull the index of the constant
- *              from.
- * @param bgn   An in/out parameter; marks the start of the index in the
- *              bytecode vector and will be updated to point to after the index.
+ * Turns every result that refers to a constant into a copy of it. This must be
+ * called before the number of the constant is changed. It is only called when
+ * ibase or scale has changed, so searching the results stack is cheap enough.
+ * @param p    The program.
+ * @param idx  The index of the constant.
  */
 static void
-bc_program_const(BcProgram* p, const char* code, size_t* bgn)
+bc_program_constDetach(BcProgram* p, size_t idx)
+{
+	BcConst* c = bc_vec_item(&p->consts, idx);
+	size_t i;
+
+	// Nothing could refer to a constant that has not been parsed.
+	if (c->num.num == NULL) return;
+
+	for (i = 0; i < p->results.len; ++i)
+	{
+		BcResult* r = bc_vec_item(&p->results, i);
+
+		if (r->t == BC_RESULT_CONST && r->d.loc.loc == idx)
+		{
+			BC_SIG_LOCK;
+
+			bc_num_createCopy(&r->d.n, &c->num);
+			r->t = BC_RESULT_TEMP;
+
+			BC_SIG_UNLOCK;
+		}
+	}
+}
+
+#if BC_ENABLED
+
+/**
+ * Returns the number for a constant that was folded by bc_parse_optimize(),
+ * computing it from its operands first if ibase or scale has changed since it
+ * was last computed. Because the operands are computed with the same ibase and
+ * scale, the result is the same as if the operator had been executed.
+ * @param p    The program.
+ * @param c    The folded constant.
+ * @param idx  The index of the folded constant.
+ * @return     The number for the folded constant.
+ */
+static BcNum*
+bc_program_constFold(BcProgram* p, BcConst* c, size_t idx)
 {
-	// I lied. I actually push the result first. I can do this because the
-	// result will be popped on error. I also get the constant itself.
-	BcResult* r = bc_program_prepResult(p);
-	BcConst* c = bc_vec_item(&p->consts, bc_program_index(code, bgn));
 	BcBigDig base = BC_PROG_IBASE(p);
+	size_t scale = BC_PROG_SCALE(p);
+	BcNum* l;
 
-	assert(p->nresults == 1);
+	if (c->base == base && c->scale == scale) return &c->num;
+
+	bc_program_constDetach(p, idx);
+
+	l = bc_program_constNum(p, c->lhs);
+
+	// Allocate if we haven't yet.
+	if (c->num.num == NULL)
+	{
+		BC_SIG_LOCK;
+		bc_num_init(&c->num, BC_NUM_DEF_SIZE);
+		BC_SIG_UNLOCK;
+	}
+
+	if (c->op == BC_INST_NEG)
+	{
+		bc_num_copy(&c->num, l);
+		if (BC_NUM_NONZERO(&c->num)) BC_NUM_NEG_TGL_NP(c->num);
+	}
+	else
+	{
+		BcNum* r = bc_program_constNum(p, c->rhs);
+
+		// The operators expect a clean result, just like in bc_program_op().
+		bc_num_zero(&c->num);
+
+		bc_program_ops[c->op - BC_INST_POWER](l, r, &c->num, scale);
+	}
+
+	c->base = base;
+	c->scale = scale;
+
+	return &c->num;
+}
+
+#endif // BC_ENABLED
+
+/**
+ * Returns the number for a constant, parsing it first if it has never been
+ * parsed or if ibase has changed since it was.
+ * @param p    The program.
+ * @param idx  The index of the constant.
+ * @return     The parsed number for the constant.
+ */
+static BcNum*
+bc_program_constNum(BcProgram* p, size_t idx)
+{
+	BcConst* c = bc_vec_item(&p->consts, idx);
+	BcBigDig base = BC_PROG_IBASE(p);
+
+#if BC_ENABLED
+	if (c->op != BC_INST_INVALID) return bc_program_constFold(p, c, idx);
+#endif // BC_ENABLED
 
 	// Only reparse if the base changed.
 	if (c->base != base)
 	{
+		bc_program_constDetach(p, idx);
+
 		// Allocate if we haven't yet.
 		if (c->num.num == NULL)
 		{
@@ -673,14 +799,33 @@ bc_program_const(BcProgram* p, const char* code, size_t* bgn)
 		c->base = base;
 	}
 
-	BC_SIG_LOCK;
+	return &c->num;
+}
 
-	bc_num_createCopy(&r->d.n, &c->num);
+/**
+ * Prepares a constant for use. This parses the constant into a number and then
+ * pushes a result that refers to that number onto the results stack. The
+ * number is not copied; the constant and the result share it until the
+ * constant has to be reparsed, and then bc_program_constDetach() gives the
+ * result its own copy.
+ * @param p     The program.
+ * @param code  The bytecode vector that we will pull the index of the constant
+ *              from.
+ * @param bgn   An in/out parameter; marks the start of the index in the
+ *              bytecode vector and will be updated to point to after the index.
+ */
+static void
+bc_program_const(BcProgram* p, const char* code, size_t* bgn)
+{
+	BcResult r;
 
-	BC_SIG_UNLOCK;
+	r.t = BC_RESULT_CONST;
+	r.d.loc.loc = bc_program_index(code, bgn);
 
-	// XXX: Make sure to clear the number of results.
-	p->nresults -= 1;
+	// Parse the constant now so that it has the value for the current ibase.
+	bc_program_constNum(p, r.d.loc.loc);
+
+	bc_vec_push(&p->results, &r);
 }
 
 /**
@@ -786,6 +931,11 @@ bc_program_read(BcProgram* p)
 	bc_lex_file(&vm->read_prs.l, bc_program_stdin_name);
 	bc_vec_popAll(&f->code);
 
+#if BC_ENABLED
+	// An inlined body in the old code is gone with it.
+	if (p->inl.caller == BC_PROG_READ) p->inl.func = 0;
+#endif // BC_ENABLED
+
 	// Read a line.
 	if (!BC_R) s = bc_read_line(&vm->read_buf, "");
 	else s = bc_read_line(&vm->read_buf, BC_VM_READ_PROMPT);
@@ -1085,6 +1235,66 @@ bc_program_unary(BcProgram* p, uchar inst)
 	bc_program_retire(p, 1);
 }
 
+/**
+ * Returns whether a comparison result satisfies a relational operator.
+ * @param inst  The relational operator.
+ * @param cmp   The result of comparing the operands with bc_num_cmp().
+ * @return      True if the relation holds, false otherwise.
+ */
+static bool
+bc_program_rel(uchar inst, ssize_t cmp)
+{
+	bool cond = false;
+
+	switch (inst)
+	{
+		case BC_INST_REL_EQ:
+		{
+			cond = (cmp == 0);
+			break;
+		}
+
+		case BC_INST_REL_LE:
+		{
+			cond = (cmp <= 0);
+			break;
+		}
+
+		case BC_INST_REL_GE:
+		{
+			cond = (cmp >= 0);
+			break;
+		}
+
+		case BC_INST_REL_NE:
+		{
+			cond = (cmp != 0);
+			break;
+		}
+
+		case BC_INST_REL_LT:
+		{
+			cond = (cmp < 0);
+			break;
+		}
+
+		case BC_INST_REL_GT:
+		{
+			cond = (cmp > 0);
+			break;
+		}
+#if BC_DEBUG
+		default:
+		{
+			// There is a bug if we get here.
+			abort();
+		}
+#endif // BC_DEBUG
+	}
+
+	return cond;
+}
+
 /**
  * Executes a logical operator.
  * @param p     The program.
@@ -1099,7 +1309,6 @@ bc_program_logical(BcProgram* p, uchar inst)
 	BcNum* n1;
 	BcNum* n2;
 	bool cond = 0;
-	ssize_t cmp;
 
 	res = bc_program_prepResult(p);
 
@@ -1122,53 +1331,7 @@ bc_program_logical(BcProgram* p, uchar inst)
 	else
 	{
 		// We have a relational operator, so do a comparison.
-		cmp = bc_num_cmp(n1, n2);
-
-		switch (inst)
-		{
-			case BC_INST_REL_EQ:
-			{
-				cond = (cmp == 0);
-				break;
-			}
-
-			case BC_INST_REL_LE:
-			{
-				cond = (cmp <= 0);
-				break;
-			}
-
-			case BC_INST_REL_GE:
-			{
-				cond = (cmp >= 0);
-				break;
-			}
-
-			case BC_INST_REL_NE:
-			{
-				cond = (cmp != 0);
-				break;
-			}
-
-			case BC_INST_REL_LT:
-			{
-				cond = (cmp < 0);
-				break;
-			}
-
-			case BC_INST_REL_GT:
-			{
-				cond = (cmp > 0);
-				break;
-			}
-#if BC_DEBUG
-			default:
-			{
-				// There is a bug if we get here.
-				abort();
-			}
-#endif // BC_DEBUG
-		}
+		cond = bc_program_rel(inst, bc_num_cmp(n1, n2));
 	}
 
 	BC_SIG_LOCK;
@@ -1273,6 +1436,15 @@ bc_program_copyToVar(BcProgram* p, size_t idx, BcType t)
 			// NOLINTNEXTLINE
 			memcpy(&r.d.n, n, sizeof(BcNum));
 		}
+		// Temporaries are about to be popped, so their numbers can be moved
+		// instead, just like in bc_program_assign(). Setting the type to
+		// BC_RESULT_ZERO prevents the number from being freed.
+		else if (ptr->t == BC_RESULT_TEMP || ptr->t >= BC_RESULT_IBASE)
+		{
+			// NOLINTNEXTLINE
+			memcpy(&r.d.n, n, sizeof(BcNum));
+			ptr->t = BC_RESULT_ZERO;
+		}
 		else bc_num_createCopy(&r.d.n, n);
 	}
 	else
@@ -1775,88 +1947,983 @@ exit:
 }
 
 /**
- * Executes a function call for bc.
+ * Returns a register to put the result of an operator in, which is the one of
+ * the two registers for the result's depth that is not its left operand.
+ * @param p      The program.
+ * @param depth  The depth of the result.
+ * @param l      The left operand.
+ * @return       A clean register.
+ */
+static BcNum*
+bc_program_reg(BcProgram* p, size_t depth, const BcNum* l)
+{
+	BcNum* r = p->regs + depth * 2;
+
+	if (r == l) r += 1;
+
+	// Allocate if we haven't yet or if the register got a string from a
+	// variable.
+	if (r->num == NULL)
+	{
+		BC_SIG_LOCK;
+		bc_num_init(r, BC_NUM_DEF_SIZE);
+		BC_SIG_UNLOCK;
+	}
+	// The operators expect a clean result, just like in bc_program_op().
+	else bc_num_zero(r);
+
+	return r;
+}
+
+/**
+ * Trades the numbers of a variable and a register, so nothing is copied.
+ * @param x    The variable.
+ * @param res  The register.
+ */
+static void
+bc_program_regSwap(BcNum* x, BcNum* res)
+{
+	BcNum temp;
+
+	BC_SIG_LOCK;
+
+	// NOLINTNEXTLINE
+	memcpy(&temp, x, sizeof(BcNum));
+	// NOLINTNEXTLINE
+	memcpy(x, res, sizeof(BcNum));
+	// NOLINTNEXTLINE
+	memcpy(res, &temp, sizeof(BcNum));
+
+	// A string has no limbs, so make sure the register gets some.
+	if (BC_PROG_STR(res)) bc_num_clear(res);
+
+	BC_SIG_UNLOCK;
+}
+
+/**
+ * Executes BC_INST_VAR_OP_CONST or BC_INST_ARRAY_OP_CONST. These do the math
+ * of an assignment operator whose right operand is a constant directly on the
+ * variable or array element, without pushing anything onto the results stack.
+ * For the layout of the operands, see the development manual
+ * (manuals/development.md#superinstructions).
  * @param p     The program.
- * @param code  The bytecode vector to pull the number of arguments and the
- *              function index out of.
- * @param bgn   An in/out parameter; the start of the indices in the bytecode
- *              vector, and will be updated to point after the indices on
- *              return.
+ * @param code  The bytecode vector to pull the operands out of.
+ * @param bgn   An in/out parameter; the start of the operands, and will be
+ *              updated to point after the fused sequence on return.
+ * @param inst  The superinstruction being executed.
  */
 static void
-bc_program_call(BcProgram* p, const char* restrict code, size_t* restrict bgn)
+bc_program_opConst(BcProgram* p, const char* restrict code,
+                   size_t* restrict bgn, uchar inst)
 {
-	BcInstPtr ip;
-	size_t i, nargs;
-	BcFunc* f;
+	BcResult r;
+	BcNum* l;
+	BcNum* n;
 	BcVec* v;
-	BcAuto* a;
-	BcResult* arg;
+	uchar op;
+	bool assign = false;
 
-	// Pull the number of arguments out of the bytecode vector.
-	nargs = bc_program_index(code, bgn);
+	r.d.loc.loc = bc_program_index(code, bgn);
 
-	// Set up instruction pointer.
-	ip.idx = 0;
-	ip.func = bc_program_index(code, bgn);
-	f = bc_vec_item(&p->fns, ip.func);
+	if (inst == BC_INST_ARRAY_OP_CONST)
+	{
+		BcResult* operand;
 
-	// Error checking.
-	if (BC_ERR(!f->code.len)) bc_verr(BC_ERR_EXEC_UNDEF_FUNC, f->name);
-	if (BC_ERR(nargs != f->nparams))
+		v = bc_program_vec(p, r.d.loc.loc, BC_TYPE_ARRAY);
+
+		// The array index is on top of the results stack, just as it would be
+		// for BC_INST_ARRAY_ELEM.
+		bc_program_prep(p, &operand, &n, 0);
+
+		r.t = BC_RESULT_ARRAY_ELEM;
+		r.d.loc.idx = (size_t) bc_num_bigdig(n);
+
+		bc_vec_pop(&p->results);
+	}
+	else
 	{
-		bc_verr(BC_ERR_EXEC_PARAMS, f->nparams, nargs);
+		v = bc_program_vec(p, r.d.loc.loc, BC_TYPE_VAR);
+		r.t = BC_RESULT_VAR;
+
+		// In the x = x op c form, skip the second load of x.
+		if (code[*bgn] == BC_INST_VAR)
+		{
+			*bgn += 1;
+			bc_program_index(code, bgn);
+			assign = true;
+		}
 	}
 
-	// Set the length of the results stack. We discount the argument, of course.
-	ip.len = p->results.len - nargs;
+	r.d.loc.stack_idx = v->len - 1;
 
-	assert(BC_PROG_STACK(&p->results, nargs));
+	// Get the constant.
+	op = (uchar) code[(*bgn)++];
+	if (op == BC_INST_NUM)
+	{
+		n = bc_program_constNum(p, bc_program_index(code, bgn));
+	}
+	else n = (op == BC_INST_ONE) ? &vm->one : &vm->zero;
 
-	// Prepare the globals' stacks.
-	if (BC_G) bc_program_prepGlobals(p);
+	// Get the operator. In the x = x op c form, it is a plain binary operator
+	// followed by BC_INST_ASSIGN_NO_VAL, which we skip.
+	op = (uchar) code[(*bgn)++];
+	if (op < BC_INST_ASSIGN_POWER) *bgn += 1;
+	else op -= (BC_INST_ASSIGN_POWER_NO_VAL - BC_INST_POWER);
 
-	// Push the arguments onto the stacks of their respective parameters.
+	l = bc_program_num(p, &r);
+
+	// This is the same type check as bc_program_assign() does.
+	if (BC_PROG_STR(l)) bc_err(BC_ERR_EXEC_TYPE);
+
+	assert(BC_NUM_RDX_VALID(l));
+	assert(BC_NUM_RDX_VALID(n));
+
+	// In the x = x op c form, the result goes into a register that then trades
+	// numbers with x, so x is not changed if there is an error, just as when
+	// the results stack is used. An assignment operator changes x in place,
+	// like bc_program_assign() does.
+	if (assign)
+	{
+		BcNum* res = bc_program_reg(p, 0, l);
+
+		bc_program_ops[op - BC_INST_POWER](l, n, res, BC_PROG_SCALE(p));
+
+		bc_program_regSwap(l, res);
+	}
+	else bc_program_ops[op - BC_INST_POWER](l, n, l, BC_PROG_SCALE(p));
+}
+
+/**
+ * Returns the number for a variable or constant operand of
+ * BC_INST_VAR_ASSIGN_REGS or BC_INST_VAR_ADDMUL.
+ * @param p     The program.
+ * @param code  The bytecode vector to pull the operand out of.
+ * @param bgn   An in/out parameter; the start of the operand, and will be
+ *              updated to point after the operand on return.
+ * @param inst  The instruction that loads the operand.
+ * @return      The number for the operand.
+ */
+static BcNum*
+bc_program_regOperand(BcProgram* p, const char* restrict code,
+                      size_t* restrict bgn, uchar inst)
+{
+	BcNum* n;
+
+	if (inst == BC_INST_VAR)
+	{
+		BcVec* v = bc_program_vec(p, bc_program_index(code, bgn), BC_TYPE_VAR);
+		n = bc_vec_top(v);
+	}
+	else if (inst == BC_INST_NUM)
+	{
+		n = bc_program_constNum(p, bc_program_index(code, bgn));
+	}
+	else n = (inst == BC_INST_ONE) ? &vm->one : &vm->zero;
+
+	return n;
+}
+
+/**
+ * Executes BC_INST_VAR_ASSIGN_REGS. This evaluates the expression after the
+ * variable like the results stack would, except that the operands are used
+ * where they are, without being copied, and the result of each operator is
+ * put in a register. At the end, the variable trades numbers with the register
+ * that has the result, so nothing is copied, and the variable is not changed
+ * if there is an error. For the sequences that are replaced, see the
+ * development manual (manuals/development.md#superinstructions).
+ * @param p     The program.
+ * @param code  The bytecode vector to pull the operands out of.
+ * @param bgn   An in/out parameter; the start of the operands, and will be
+ *              updated to point after the fused sequence on return.
+ */
+static void
+bc_program_assignRegs(BcProgram* p, const char* restrict code,
+                      size_t* restrict bgn)
+{
+	BcNum* opds[BC_PROG_REG_DEPTH];
+	BcNum* x;
+	BcNum* res;
+	BcVec* v;
+	size_t depth = 0, scale = BC_PROG_SCALE(p);
+	uchar inst;
+
+	v = bc_program_vec(p, bc_program_index(code, bgn), BC_TYPE_VAR);
+
+	inst = (uchar) code[(*bgn)++];
+
+	// Evaluate the expression. The parser made sure that it is well-formed.
+	while (inst < BC_INST_ASSIGN_POWER_NO_VAL || inst > BC_INST_ASSIGN_NO_VAL)
+	{
+		if (inst >= BC_INST_POWER && inst < BC_INST_REL_EQ)
+		{
+			assert(depth >= 2);
+
+			depth -= 1;
+
+			res = bc_program_reg(p, depth - 1, opds[depth - 1]);
+
+			// This is the same type check as bc_program_op() does. Variables
+			// are checked here, not when they are loaded, so that errors
+			// happen in the same order.
+			if (BC_ERR(BC_PROG_STR(opds[depth - 1]) ||
+			           BC_PROG_STR(opds[depth])))
+			{
+				bc_err(BC_ERR_EXEC_TYPE);
+			}
+
+			assert(BC_NUM_RDX_VALID(opds[depth - 1]));
+			assert(BC_NUM_RDX_VALID(opds[depth]));
+
+			bc_program_ops[inst - BC_INST_POWER](opds[depth - 1], opds[depth],
+			                                     res, scale);
+
+			opds[depth - 1] = res;
+		}
+		else
+		{
+			assert(depth < BC_PROG_REG_DEPTH);
+
+			opds[depth] = bc_program_regOperand(p, code, bgn, inst);
+			depth += 1;
+		}
+
+		inst = (uchar) code[(*bgn)++];
+	}
+
+	assert(depth == 1);
+
+	x = bc_vec_top(v);
+
+	// In the x op= e form, do the math with the variable.
+	if (inst != BC_INST_ASSIGN_NO_VAL)
+	{
+		// These are the same type checks as bc_program_assign() does.
+		if (BC_ERR(BC_PROG_STR(opds[0]) || BC_PROG_STR(x)))
+		{
+			bc_err(BC_ERR_EXEC_TYPE);
+		}
+
+		res = bc_program_reg(p, 0, opds[0]);
+
+		// bc_program_assign() does the math in place, which leaves the
+		// variable zero if it fails. To do the same, the old value goes into
+		// the clean register, and the result goes into the variable.
+		bc_program_regSwap(x, res);
+		if (opds[0] == x) opds[0] = res;
+
+		inst -= (BC_INST_ASSIGN_POWER_NO_VAL - BC_INST_POWER);
+
+		bc_program_ops[inst - BC_INST_POWER](res, opds[0], x, scale);
+	}
+	else
+	{
+		assert(opds[0] == p->regs || opds[0] == p->regs + 1);
+
+		// In the x = e form, the variable is only changed once the value has
+		// been computed, like the stack does.
+		bc_program_regSwap(x, opds[0]);
+	}
+}
+
+/**
+ * Executes BC_INST_VAR_ADDMUL. The factors are used where they are, and the
+ * product is added to or subtracted from the variable in its own limbs. For
+ * the sequences that are replaced, see the development manual
+ * (manuals/development.md#superinstructions).
+ * @param p     The program.
+ * @param code  The bytecode vector to pull the operands out of.
+ * @param bgn   An in/out parameter; the start of the operands, and will be
+ *              updated to point after the fused sequence on return.
+ */
+static void
+bc_program_addMul(BcProgram* p, const char* restrict code,
+                  size_t* restrict bgn)
+{
+	BcNum* a;
+	BcNum* b;
+	BcNum* x;
+	BcVec* v;
+	uchar inst;
+
+	v = bc_program_vec(p, bc_program_index(code, bgn), BC_TYPE_VAR);
+
+	inst = (uchar) code[(*bgn)++];
+	a = bc_program_regOperand(p, code, bgn, inst);
+
+	inst = (uchar) code[(*bgn)++];
+	b = bc_program_regOperand(p, code, bgn, inst);
+
+	// Skip the multiplication and get the assignment.
+	assert(code[*bgn] == BC_INST_MULTIPLY);
+	*bgn += 1;
+	inst = (uchar) code[(*bgn)++];
+
+	x = bc_vec_top(v);
+
+	// These are the same type checks, in the same order, as bc_program_op()
+	// and bc_program_assign() do.
+	if (BC_ERR(BC_PROG_STR(a) || BC_PROG_STR(b))) bc_err(BC_ERR_EXEC_TYPE);
+	if (BC_ERR(BC_PROG_STR(x))) bc_err(BC_ERR_EXEC_TYPE);
+
+	assert(BC_NUM_RDX_VALID(a));
+	assert(BC_NUM_RDX_VALID(b));
+	assert(BC_NUM_RDX_VALID(x));
+
+	if (inst == BC_INST_ASSIGN_PLUS_NO_VAL)
+	{
+		bc_num_addmul(a, b, x, BC_PROG_SCALE(p));
+	}
+	else
+	{
+		assert(inst == BC_INST_ASSIGN_MINUS_NO_VAL);
+		bc_num_submul(a, b, x, BC_PROG_SCALE(p));
+	}
+}
+
+/**
+ * Does the comparison for BC_INST_REL_JUMP_ZERO and pops its operands.
+ * @param p     The program.
+ * @param inst  The relational operator.
+ * @return      True if the jump should be taken, which is when the comparison
+ *              fails.
+ */
+static bool
+bc_program_relJump(BcProgram* p, uchar inst)
+{
+	BcResult* opd1;
+	BcResult* opd2;
+	BcNum* n1;
+	BcNum* n2;
+	bool cond;
+
+	bc_program_binOpPrep(p, &opd1, &n1, &opd2, &n2, 0);
+
+	cond = bc_program_rel(inst, bc_num_cmp(n1, n2));
+
+	bc_vec_npop(&p->results, 2);
+
+	return !cond;
+}
+
+/**
+ * Frees a memoized call.
+ * @param m    The memoized call.
+ * @param res  True if the result needs to be freed too.
+ */
+static void
+bc_program_memoFree(BcMemo* m, bool res)
+{
+	BC_SIG_ASSERT_LOCKED;
+
+	bc_vec_free(&m->args);
+	if (res) bc_num_free(&m->res);
+}
+
+/**
+ * Empties the cache of memoized calls. This is done when a function is
+ * redefined because cached results may depend on it.
+ * @param p  The program.
+ */
+static void
+bc_program_memoClear(BcProgram* p)
+{
+	size_t i;
+
+	BC_SIG_ASSERT_LOCKED;
+
+	for (i = 0; i < p->memos.len; ++i)
+	{
+		BcMemo* m = bc_vec_item(&p->memos, i);
+
+		if (!m->func) continue;
+
+		bc_program_memoFree(m, true);
+		m->func = 0;
+	}
+}
+
+/**
+ * Adds a number to a hash. Everything that makes numbers different, including
+ * the scale, goes into the hash.
+ * @param h  The hash so far.
+ * @param n  The number.
+ * @return   The new hash.
+ */
+static size_t
+bc_program_memoHash(size_t h, const BcNum* n)
+{
+	size_t i;
+
+	h = h * 31 + n->len;
+	h = h * 31 + n->rdx;
+	h = h * 31 + n->scale;
+
+	for (i = 0; i < n->len; ++i)
+	{
+		h = h * 31 + (size_t) n->num[i];
+	}
+
+	return h;
+}
+
+/**
+ * Returns true if two numbers are exactly the same, including their scales.
+ * @param a  The first number.
+ * @param b  The second number.
+ * @return   True if @a a and @a b are exactly the same.
+ */
+static bool
+bc_program_memoEq(const BcNum* a, const BcNum* b)
+{
+	return a->len == b->len && a->rdx == b->rdx && a->scale == b->scale &&
+	       !memcmp(a->num, b->num, a->len * sizeof(BcDig));
+}
+
+/**
+ * Returns the number of an argument to a memoized function, or NULL if the
+ * call cannot use the cache. Strings and arrays are not cached, and neither
+ * are bad arguments, so that bc_program_call() can report them.
+ * @param p      The program.
+ * @param nargs  The number of arguments.
+ * @param i      The index of the argument.
+ * @return       The number of the argument, or NULL.
+ */
+static BcNum*
+bc_program_memoArg(BcProgram* p, size_t nargs, size_t i)
+{
+	BcResult* arg = bc_vec_item_rev(&p->results, nargs - 1 - i);
+	BcNum* n;
+
+	if (arg->t == BC_RESULT_ARRAY || arg->t == BC_RESULT_VOID) return NULL;
+
+	n = bc_program_num(p, arg);
+
+	return BC_PROG_STR(n) ? NULL : n;
+}
+
+/**
+ * Looks for a call to a memoized function in the cache. If it is there, the
+ * arguments are replaced by a copy of its result. Otherwise, the key of the
+ * call is pushed onto the memo_calls stack so that bc_program_return() can
+ * cache the result.
+ * @param p      The program.
+ * @param fidx   The index of the function.
+ * @param nargs  The number of arguments, which is the number of parameters.
+ * @return       True if the result was in the cache, false otherwise.
+ */
+static bool
+bc_program_memo(BcProgram* p, size_t fidx, size_t nargs)
+{
+	BcMemo* m;
+	BcMemo key;
+	BcResult* res;
+	BcNum* n;
+	size_t i, h = fidx;
+
+	// Hash the key.
+	for (i = 0; i < BC_PROG_GLOBALS_LEN; ++i)
+	{
+		h = h * 31 + (size_t) p->globals[i];
+	}
+
+	for (i = 0; i < nargs; ++i)
+	{
+		n = bc_program_memoArg(p, nargs, i);
+		if (n == NULL) return false;
+
+		h = bc_program_memoHash(h, n);
+	}
+
+	// Check the slot for the key.
+	if (p->memos.len)
+	{
+		m = bc_vec_item(&p->memos, h % BC_PROG_MEMO_SIZE);
+
+		for (i = 0; m->func == fidx && m->hash == h && i < nargs; ++i)
+		{
+			n = bc_program_memoArg(p, nargs, i);
+			if (!bc_program_memoEq(n, bc_vec_item(&m->args, i))) break;
+		}
+
+		if (m->func == fidx && m->hash == h && i == nargs &&
+		    !memcmp(m->globals, p->globals, sizeof(p->globals)))
+		{
+			res = bc_program_prepResult(p);
+
+			BC_SIG_LOCK;
+
+			bc_num_createCopy(&res->d.n, &m->res);
+			bc_program_retire(p, nargs);
+
+			BC_SIG_UNLOCK;
+
+			return true;
+		}
+	}
+
+	BC_SIG_LOCK;
+
+	// Save the key, with copies of the arguments, before they are moved into
+	// the parameters.
+	key.func = fidx;
+	key.hash = h;
+	key.depth = p->stack.len + 1;
+
+	// NOLINTNEXTLINE
+	memcpy(key.globals, p->globals, sizeof(p->globals));
+
+	bc_vec_init(&key.args, sizeof(BcNum), BC_DTOR_NUM);
+
+	for (i = 0; i < nargs; ++i)
+	{
+		n = bc_vec_pushEmpty(&key.args);
+		bc_num_createCopy(n, bc_program_memoArg(p, nargs, i));
+	}
+
+	bc_vec_push(&p->memo_calls, &key);
+
+	BC_SIG_UNLOCK;
+
+	return false;
+}
+
+/**
+ * Caches the result of a call to a memoized function that is returning, if
+ * there is one. This evicts whatever was in its slot. The signal lock must be
+ * held.
+ * @param p    The program.
+ * @param res  The result of the call.
+ */
+static void
+bc_program_memoStore(BcProgram* p, const BcResult* res)
+{
+	BcMemo* key;
+	BcMemo* m;
+
+	BC_SIG_ASSERT_LOCKED;
+
+	if (!p->memo_calls.len) return;
+
+	key = bc_vec_top(&p->memo_calls);
+
+	// The call might not have used the cache.
+	if (key->depth != p->stack.len) return;
+
+	// Strings are not cached.
+	if (res->t != BC_RESULT_TEMP)
+	{
+		bc_program_memoFree(key, false);
+		bc_vec_pop(&p->memo_calls);
+		return;
+	}
+
+	// Allocate the cache if necessary.
+	if (!p->memos.len)
+	{
+		size_t i;
+
+		for (i = 0; i < BC_PROG_MEMO_SIZE; ++i)
+		{
+			m = bc_vec_pushEmpty(&p->memos);
+			m->func = 0;
+		}
+	}
+
+	m = bc_vec_item(&p->memos, key->hash % BC_PROG_MEMO_SIZE);
+
+	if (m->func) bc_program_memoFree(m, true);
+
+	// NOLINTNEXTLINE
+	memcpy(m, key, sizeof(BcMemo));
+	bc_num_createCopy(&m->res, &res->d.n);
+
+	bc_vec_pop(&p->memo_calls);
+}
+
+/**
+ * Pushes a fresh value onto the stack of an auto variable or array. The
+ * signal lock must be held.
+ * @param v  The stack of the auto.
+ * @param t  The type of the auto.
+ */
+static void
+bc_program_pushAuto(BcVec* v, BcType t)
+{
+	BC_SIG_ASSERT_LOCKED;
+
+	// If a variable, just push a 0; otherwise, push an array.
+	if (t == BC_TYPE_VAR)
+	{
+		BcNum* n = bc_vec_pushEmpty(v);
+		bc_num_init(n, BC_NUM_DEF_SIZE);
+	}
+	else
+	{
+		BcVec* v2;
+
+		assert(t == BC_TYPE_ARRAY);
+
+		v2 = bc_vec_pushEmpty(v);
+		bc_array_init(v2, true, false);
+	}
+}
+
+/**
+ * Parses a function in a math library that has not been parsed yet. This uses
+ * the read parser because the main parser may be in the middle of a parse.
+ * @param p     The program.
+ * @param fidx  The index of the function.
+ */
+static void
+bc_program_loadFunc(BcProgram* p, size_t fidx)
+{
+	BcFunc* f = bc_vec_item(&p->fns, fidx);
+	const char* text = f->lib;
+	BcMode mode;
+
+	BC_SIG_LOCK;
+
+	if (!BC_PARSE_IS_INITED(&vm->read_prs, p))
+	{
+		bc_parse_init(&vm->read_prs, p, BC_PROG_MAIN);
+
+		// Initialize this too because bc_vm_shutdown() expects them to be
+		// initialized together.
+		bc_vec_init(&vm->read_buf, sizeof(char), BC_DTOR_NONE);
+	}
+	// This needs to be updated because the parser could have been used
+	// somewhere else.
+	else bc_parse_updateFunc(&vm->read_prs, BC_PROG_MAIN);
+
+	bc_lex_file(&vm->read_prs.l, vm->file);
+
+	// Keywords that were redefined are still keywords in the libraries.
+	vm->no_redefine = true;
+
+	// The library is not stdin, so the lexer must not ask for more of it.
+	mode = vm->mode;
+	vm->mode = BC_MODE_FILE;
+
+	BC_SETJMP_LOCKED(vm, err);
+
+	BC_SIG_UNLOCK;
+
+	bc_parse_text(&vm->read_prs, text, BC_MODE_FILE);
+
+	BC_SIG_LOCK;
+
+	bc_parse_define(&vm->read_prs);
+
+	BC_UNSETJMP(vm);
+
+	vm->no_redefine = false;
+	vm->mode = (uchar) mode;
+
+	BC_SIG_UNLOCK;
+
+	return;
+
+err:
+	BC_SIG_MAYLOCK;
+
+	vm->no_redefine = false;
+	vm->mode = (uchar) mode;
+
+	// Throw away any partial parse so that the function can be parsed again.
+	bc_vec_npop(&vm->read_prs.flags, vm->read_prs.flags.len - 1);
+	bc_parse_updateFunc(&vm->read_prs, BC_PROG_MAIN);
+
+	f = bc_vec_item(&p->fns, fidx);
+	bc_func_reset(f);
+	f->lib = text;
+
+	BC_LONGJMP_CONT(vm);
+}
+
+/**
+ * Calls a function and sets up all of the data structures to make that
+ * happen.
+ * @param p      The program.
+ * @param nargs  The number of arguments on the results stack.
+ * @param fidx   The index of the function to call.
+ */
+static void
+bc_program_callFunc(BcProgram* p, size_t nargs, size_t fidx)
+{
+	BcInstPtr ip;
+	size_t i;
+	BcFunc* f;
+	BcVec* v;
+	BcAuto* a;
+	BcResult* arg;
+
+	// Set up instruction pointer.
+	ip.idx = 0;
+	ip.func = fidx;
+	f = bc_vec_item(&p->fns, ip.func);
+
+	// Functions in the math libraries are parsed when they are first called.
+	if (f->lib != NULL)
+	{
+		bc_program_loadFunc(p, fidx);
+		f = bc_vec_item(&p->fns, ip.func);
+	}
+
+	// Error checking.
+	if (BC_ERR(!f->code.len)) bc_verr(BC_ERR_EXEC_UNDEF_FUNC, f->name);
+	if (BC_ERR(nargs != f->nparams))
+	{
+		bc_verr(BC_ERR_EXEC_PARAMS, f->nparams, nargs);
+	}
+
+	// A memoized function may not need to be called at all.
+	if (f->memo && bc_program_memo(p, ip.func, nargs)) return;
+
+	// Set the length of the results stack. We discount the argument, of course.
+	ip.len = p->results.len - nargs;
+
+	assert(BC_PROG_STACK(&p->results, nargs));
+
+	// Prepare the globals' stacks.
+	if (BC_G) bc_program_prepGlobals(p);
+
+	// Push the arguments onto the stacks of their respective parameters.
+	for (i = 0; i < nargs; ++i)
+	{
+		arg = bc_vec_top(&p->results);
+		if (BC_ERR(arg->t == BC_RESULT_VOID)) bc_err(BC_ERR_EXEC_VOID_VAL);
+
+		// Get the corresponding parameter.
+		a = bc_vec_item(&f->autos, nargs - 1 - i);
+
+		// Actually push the value onto the parameter's stack.
+		bc_program_copyToVar(p, a->idx, a->type);
+	}
+
+	BC_SIG_LOCK;
+
+	// Push zeroes onto the stacks of the auto variables.
+	for (; i < f->autos.len; ++i)
+	{
+		// Get the auto and its stack.
+		a = bc_vec_item(&f->autos, i);
+		v = bc_program_vec(p, a->idx, a->type);
+
+		bc_program_pushAuto(v, a->type);
+	}
+
+	// Push the instruction pointer onto the execution stack.
+	bc_vec_push(&p->stack, &ip);
+
+	BC_SIG_UNLOCK;
+}
+
+/**
+ * Executes a function call for bc.
+ * @param p     The program.
+ * @param code  The bytecode vector to pull the number of arguments and the
+ *              function index out of.
+ * @param bgn   An in/out parameter; the start of the indices in the bytecode
+ *              vector, and will be updated to point after the indices on
+ *              return.
+ */
+static void
+bc_program_call(BcProgram* p, const char* restrict code, size_t* restrict bgn)
+{
+	size_t nargs, fidx;
+
+	// Pull the number of arguments and the function out of the bytecode.
+	nargs = bc_program_index(code, bgn);
+	fidx = bc_program_index(code, bgn);
+
+	bc_program_callFunc(p, nargs, fidx);
+}
+
+/**
+ * Executes BC_INST_INLINE. If the function has not been redefined since it was
+ * inlined, this moves the arguments into hidden variables, and the inlined body
+ * after it uses those instead of the parameters. Otherwise, it makes a normal
+ * call and skips the stale body.
+ * @param p     The program.
+ * @param code  The bytecode vector to pull the indices out of.
+ * @param bgn   An in/out parameter; the start of the indices in the bytecode
+ *              vector, and will be updated to point after the indices, or
+ *              after the inlined body, on return.
+ */
+static void
+bc_program_inline(BcProgram* p, const char* restrict code,
+                  size_t* restrict bgn)
+{
+	BcInstPtr* ip = bc_vec_top(&p->stack);
+	BcFunc* func = bc_vec_item(&p->fns, ip->func);
+	BcFunc* f;
+	BcResult* arg;
+	BcVec* v;
+	size_t i, nargs, fidx, version, label, idx;
+
+	nargs = bc_program_index(code, bgn);
+	fidx = bc_program_index(code, bgn);
+	version = bc_program_index(code, bgn);
+	label = bc_program_index(code, bgn);
+
+	f = bc_vec_item(&p->fns, fidx);
+
+	if (f->version != version)
+	{
+		// This has to be set before the call because the call can invalidate
+		// the instruction pointer.
+		*bgn = *((size_t*) bc_vec_item(&func->labels, label));
+
+		// The body is skipped, so a stack trace must not show it.
+		p->inl.func = 0;
+
+		bc_program_callFunc(p, nargs, fidx);
+
+		return;
+	}
+
+	// The variables are in reverse order, like the arguments on the stack.
+	for (i = 0; i < nargs; ++i)
+	{
+		arg = bc_vec_top(&p->results);
+		if (BC_ERR(arg->t == BC_RESULT_VOID)) bc_err(BC_ERR_EXEC_VOID_VAL);
+
+		idx = bc_program_index(code, bgn);
+
+		bc_program_copyToVar(p, idx, BC_TYPE_VAR);
+
+		// Only the new value needs to be kept.
+		BC_SIG_LOCK;
+		v = bc_program_vec(p, idx, BC_TYPE_VAR);
+		bc_vec_npopAt(v, 1, v->len - 2);
+		BC_SIG_UNLOCK;
+	}
+
+	// Remember where the body is, so a stack trace can show it as a frame.
+	p->inl.func = fidx;
+	p->inl.caller = ip->func;
+	p->inl.version = func->version;
+	p->inl.depth = p->stack.len;
+	p->inl.bgn = *bgn;
+	p->inl.end = *((size_t*) bc_vec_item(&func->labels, label));
+}
+
+/**
+ * Returns true if the current frame can be reused for a tail call. It can't
+ * if the function or number of arguments is different, or if an argument
+ * would become a reference to an array of the frame that is being replaced.
+ * @param p      The program.
+ * @param ip     The instruction pointer of the current frame.
+ * @param fidx   The index of the function to call.
+ * @param nargs  The number of arguments.
+ * @return       True if the frame can be reused, false otherwise.
+ */
+static bool
+bc_program_tailFrame(BcProgram* p, const BcInstPtr* ip, size_t fidx,
+                     size_t nargs)
+{
+	BcFunc* f = bc_vec_item(&p->fns, fidx);
+	size_t i, j;
+
+	if (fidx != ip->func || nargs != f->nparams) return false;
+
+	assert(BC_PROG_STACK(&p->results, ip->len + nargs));
+
+	for (i = 0; i < nargs; ++i)
+	{
+		BcAuto* a = bc_vec_item(&f->autos, i);
+		BcResult* arg = bc_vec_item_rev(&p->results, nargs - 1 - i);
+
+		if (arg->t != BC_RESULT_ARRAY || a->type != BC_TYPE_REF) continue;
+
+		for (j = 0; j < f->autos.len; ++j)
+		{
+			BcAuto* a2 = bc_vec_item(&f->autos, j);
+			BcVec* v;
+
+			if (a2->type == BC_TYPE_VAR || a2->idx != arg->d.loc.loc) continue;
+
+			// Copying an existing reference is fine; making a new one is not.
+			v = bc_vec_top(bc_program_vec(p, a2->idx, a2->type));
+			if (v->size != sizeof(uchar)) return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Executes a tail call. If the current frame can be reused, the arguments
+ * replace the current values of the parameters, the autos are reset, and
+ * execution starts over at the beginning of the function. Otherwise, this is
+ * just a normal call.
+ * @param p     The program.
+ * @param code  The bytecode vector to pull the indices out of.
+ * @param bgn   An in/out parameter; the start of the indices in the bytecode
+ *              vector, and will be updated to point after the indices on
+ *              return.
+ */
+static void
+bc_program_tailCall(BcProgram* p, const char* restrict code,
+                    size_t* restrict bgn)
+{
+	BcInstPtr* ip = bc_vec_top(&p->stack);
+	size_t i, nargs, fidx, extra;
+	BcFunc* f;
+	BcVec* v;
+	BcAuto* a;
+	BcResult* arg;
+
+	nargs = bc_program_index(code, bgn);
+	fidx = bc_program_index(code, bgn);
+
+	if (!bc_program_tailFrame(p, ip, fidx, nargs))
+	{
+		bc_program_callFunc(p, nargs, fidx);
+		return;
+	}
+
+	f = bc_vec_item(&p->fns, fidx);
+
+	// Get rid of any results that the frame left under the arguments.
+	extra = p->results.len - nargs - ip->len;
+	if (extra)
+	{
+		if (nargs) bc_vec_npopAt(&p->results, extra, ip->len);
+		else bc_vec_npop(&p->results, extra);
+	}
+
+	// Push the arguments, just like bc_program_call() does. This has to happen
+	// before the old values go because the arguments may use them.
 	for (i = 0; i < nargs; ++i)
 	{
 		arg = bc_vec_top(&p->results);
 		if (BC_ERR(arg->t == BC_RESULT_VOID)) bc_err(BC_ERR_EXEC_VOID_VAL);
 
-		// Get the corresponding parameter.
 		a = bc_vec_item(&f->autos, nargs - 1 - i);
 
-		// Actually push the value onto the parameter's stack.
 		bc_program_copyToVar(p, a->idx, a->type);
 	}
 
 	BC_SIG_LOCK;
 
-	// Push zeroes onto the stacks of the auto variables.
-	for (; i < f->autos.len; ++i)
+	for (i = 0; i < f->autos.len; ++i)
 	{
-		// Get the auto and its stack.
 		a = bc_vec_item(&f->autos, i);
 		v = bc_program_vec(p, a->idx, a->type);
 
-		// If a variable, just push a 0; otherwise, push an array.
-		if (a->type == BC_TYPE_VAR)
-		{
-			BcNum* n = bc_vec_pushEmpty(v);
-			bc_num_init(n, BC_NUM_DEF_SIZE);
-		}
+		// The old value of a parameter is right under the new one. Other
+		// autos just start over.
+		if (i < nargs) bc_vec_npopAt(v, 1, v->len - 2);
 		else
 		{
-			BcVec* v2;
-
-			assert(a->type == BC_TYPE_ARRAY);
-
-			v2 = bc_vec_pushEmpty(v);
-			bc_array_init(v2, true, false);
+			bc_vec_pop(v);
+			bc_program_pushAuto(v, a->type);
 		}
 	}
 
-	// Push the instruction pointer onto the execution stack.
-	bc_vec_push(&p->stack, &ip);
+	// Start the function over.
+	ip->idx = 0;
 
 	BC_SIG_UNLOCK;
 }
@@ -1915,6 +2982,15 @@ bc_program_return(BcProgram* p, uchar inst)
 			// NOLINTNEXTLINE
 			memcpy(&res->d.n, num, sizeof(BcNum));
 		}
+		// A temporary is going to be retired, so just move its number.
+		else if (operand->t == BC_RESULT_TEMP || operand->t >= BC_RESULT_IBASE)
+		{
+			BC_SIG_LOCK;
+
+			// NOLINTNEXTLINE
+			memcpy(&res->d.n, num, sizeof(BcNum));
+			operand->t = BC_RESULT_ZERO;
+		}
 		else
 		{
 			BC_SIG_LOCK;
@@ -1945,6 +3021,8 @@ bc_program_return(BcProgram* p, uchar inst)
 
 	BC_SIG_LOCK;
 
+	if (f->memo) bc_program_memoStore(p, res);
+
 	// When we retire, pop all of the unused results.
 	bc_program_retire(p, nresults);
 
@@ -1975,7 +3053,7 @@ bc_program_builtin(BcProgram* p, uchar inst)
 #if BC_ENABLE_EXTRA_MATH
 	assert(inst >= BC_INST_LENGTH && inst <= BC_INST_IRAND);
 #else // BC_ENABLE_EXTRA_MATH
-	assert(inst >= BC_INST_LENGTH && inst <= BC_INST_IS_STRING);
+	assert(inst >= BC_INST_LENGTH && inst <= BC_INST_NEXT_PRIME);
 #endif // BC_ENABLE_EXTRA_MATH
 
 #ifndef BC_PROG_NO_STACK_CHECK
@@ -2041,6 +3119,32 @@ bc_program_builtin(BcProgram* p, uchar inst)
 		if (cond) bc_num_one(&res->d.n);
 	}
 
+	// Primality is hard, but that is all in the num code.
+	else if (inst == BC_INST_IS_PRIME)
+	{
+		bool prime = bc_num_isPrime(num, false);
+
+		BC_SIG_LOCK;
+
+		bc_num_init(&res->d.n, BC_NUM_DEF_SIZE);
+
+		BC_SIG_UNLOCK;
+
+		if (prime) bc_num_one(&res->d.n);
+	}
+
+	// So is finding the next prime.
+	else if (inst == BC_INST_NEXT_PRIME)
+	{
+		BC_SIG_LOCK;
+
+		bc_num_init(&res->d.n, num->len - BC_NUM_RDX_VAL(num) + 1);
+
+		BC_SIG_UNLOCK;
+
+		bc_num_nextPrime(num, &res->d.n);
+	}
+
 #if BC_ENABLE_EXTRA_MATH
 
 	// irand() is easy.
@@ -2222,6 +3326,84 @@ bc_program_modexp(BcProgram* p)
 	bc_program_retire(p, 3);
 }
 
+/**
+ * Executes a modular inverse.
+ * @param p  The program.
+ */
+static void
+bc_program_modinv(BcProgram* p)
+{
+	BcResult* opd1;
+	BcResult* opd2;
+	BcResult* res;
+	BcNum* n1;
+	BcNum* n2;
+
+	res = bc_program_prepResult(p);
+
+	assert(p->nresults == 1);
+
+	bc_program_binOpPrep(p, &opd1, &n1, &opd2, &n2, 1);
+
+	BC_SIG_LOCK;
+
+	bc_num_init(&res->d.n, n2->len);
+
+	BC_SIG_UNLOCK;
+
+	bc_num_modinv(n1, n2, &res->d.n);
+
+	bc_program_retire(p, 2);
+}
+
+/**
+ * Executes an extended GCD. This leaves three results on the stack: the GCD
+ * and then the cofactors of the first and second operands, with the second
+ * cofactor on top.
+ * @param p  The program.
+ */
+static void
+bc_program_egcd(BcProgram* p)
+{
+	BcResult* opd1;
+	BcResult* opd2;
+	BcResult* res;
+	BcResult* res2;
+	BcResult* res3;
+	BcNum* n1;
+	BcNum* n2;
+	size_t req;
+
+	// We grow first to avoid pointer invalidation.
+	bc_vec_grow(&p->results, 3);
+
+	// We don't need to update the pointer because
+	// the capacity is enough due to the line above.
+	res3 = bc_program_prepResult(p);
+	res2 = bc_program_prepResult(p);
+	res = bc_program_prepResult(p);
+	assert(p->nresults == 3);
+
+	// Prepare the operands.
+	bc_program_binOpPrep(p, &opd1, &n1, &opd2, &n2, 3);
+
+	req = bc_num_addReq(n1, n2, 0);
+
+	BC_SIG_LOCK;
+
+	// Initialize the results.
+	bc_num_init(&res->d.n, req);
+	bc_num_init(&res2->d.n, req);
+	bc_num_init(&res3->d.n, req);
+
+	BC_SIG_UNLOCK;
+
+	// Execute.
+	bc_num_egcd(n1, n2, &res3->d.n, &res2->d.n, &res->d.n);
+
+	bc_program_retire(p, 2);
+}
+
 /**
  * Asciifies a number for dc. This is a helper for bc_program_asciify().
  * @param p  The program.
@@ -2809,7 +3991,7 @@ bc_program_insertFunc(BcProgram* p, const char* name)
 
 	// Insert into the map and get the resulting ID.
 	new = bc_map_insert(&p->fn_map, name, p->fns.len, &idx);
-	id_ptr = (BcId*) bc_vec_item(&p->fn_map, idx);
+	id_ptr = (BcId*) bc_vec_item(&p->fn_map.ids, idx);
 	idx = id_ptr->idx;
 
 	// If the function is new...
@@ -2819,11 +4001,13 @@ bc_program_insertFunc(BcProgram* p, const char* name)
 		bc_program_addFunc(p, id_ptr);
 	}
 #if BC_ENABLED
-	// bc has to reset the function because it's about to be redefined.
+	// bc has to reset the function because it's about to be redefined. Cached
+	// results may have come from the old definition, so they go too.
 	else if (BC_IS_BC)
 	{
 		BcFunc* func = bc_vec_item(&p->fns, idx);
 		bc_func_reset(func);
+		bc_program_memoClear(p);
 	}
 #endif // BC_ENABLED
 
@@ -2851,22 +4035,40 @@ bc_program_free(BcProgram* p)
 #endif // BC_ENABLED
 
 	bc_vec_free(&p->fns);
-	bc_vec_free(&p->fn_map);
+	bc_map_free(&p->fn_map);
 	bc_vec_free(&p->vars);
-	bc_vec_free(&p->var_map);
+	bc_map_free(&p->var_map);
 	bc_vec_free(&p->arrs);
-	bc_vec_free(&p->arr_map);
+	bc_map_free(&p->arr_map);
 	bc_vec_free(&p->results);
 	bc_vec_free(&p->stack);
 	bc_vec_free(&p->consts);
-	bc_vec_free(&p->const_map);
+	bc_map_free(&p->const_map);
 	bc_vec_free(&p->strs);
-	bc_vec_free(&p->str_map);
+	bc_map_free(&p->str_map);
 
 	bc_num_free(&p->asciify);
 
 #if BC_ENABLED
-	if (BC_IS_BC) bc_num_free(&p->last);
+	if (BC_IS_BC)
+	{
+		bc_num_free(&p->last);
+
+		for (i = 0; i < BC_PROG_REG_DEPTH * 2; ++i)
+		{
+			bc_num_free(p->regs + i);
+		}
+
+		bc_program_memoClear(p);
+		bc_vec_free(&p->memos);
+
+		for (i = 0; i < p->memo_calls.len; ++i)
+		{
+			bc_program_memoFree(bc_vec_item(&p->memo_calls, i), false);
+		}
+
+		bc_vec_free(&p->memo_calls);
+	}
 #endif // BC_ENABLED
 
 #if BC_ENABLE_EXTRA_MATH
@@ -2931,7 +4133,21 @@ bc_program_init(BcProgram* p)
 #endif // BC_ENABLE_EXTRA_MATH
 
 #if BC_ENABLED
-	if (BC_IS_BC) bc_num_init(&p->last, BC_NUM_DEF_SIZE);
+	if (BC_IS_BC)
+	{
+		bc_num_init(&p->last, BC_NUM_DEF_SIZE);
+
+		for (i = 0; i < BC_PROG_REG_DEPTH * 2; ++i)
+		{
+			bc_num_clear(p->regs + i);
+		}
+
+		bc_vec_init(&p->memos, sizeof(BcMemo), BC_DTOR_NONE);
+		bc_vec_init(&p->memo_calls, sizeof(BcMemo), BC_DTOR_NONE);
+	}
+
+	// NOLINTNEXTLINE
+	memset(&p->inl, 0, sizeof(BcInlineFrame));
 #endif // BC_ENABLED
 
 #if BC_DEBUG || BC_ENABLE_MEMCHECK
@@ -2964,38 +4180,95 @@ bc_program_init(BcProgram* p)
 	p->nresults = 0;
 }
 
-void
-bc_program_printStackTrace(BcProgram* p)
+/**
+ * Prints one frame of a stack trace.
+ * @param p           The program.
+ * @param i           The number of the frame.
+ * @param max_digits  The number of digits in the largest frame number.
+ * @param fidx        The index of the function in the frame.
+ */
+static void
+bc_program_printFrame(BcProgram* p, size_t i, size_t max_digits, size_t fidx)
 {
-	size_t i, max_digits;
+	BcFunc* f = bc_vec_item(&p->fns, fidx);
+	size_t j, digits;
 
-	max_digits = bc_vm_numDigits(p->stack.len - 1);
+	digits = bc_vm_numDigits(i);
 
-	for (i = 0; i < p->stack.len; ++i)
+	bc_file_puts(&vm->ferr, bc_flush_none, "    ");
+
+	for (j = 0; j < max_digits - digits; ++j)
 	{
-		BcInstPtr* ip = bc_vec_item_rev(&p->stack, i);
-		BcFunc* f = bc_vec_item(&p->fns, ip->func);
-		size_t j, digits;
+		bc_file_putchar(&vm->ferr, bc_flush_none, ' ');
+	}
 
-		digits = bc_vm_numDigits(i);
+	bc_file_printf(&vm->ferr, "%zu: %s", i, f->name);
 
-		bc_file_puts(&vm->ferr, bc_flush_none, "    ");
+#if BC_ENABLED
+	if (BC_IS_BC && fidx != BC_PROG_MAIN && fidx != BC_PROG_READ)
+	{
+		bc_file_puts(&vm->ferr, bc_flush_none, "()");
+	}
+#endif // BC_ENABLED
 
-		for (j = 0; j < max_digits - digits; ++j)
-		{
-			bc_file_putchar(&vm->ferr, bc_flush_none, ' ');
-		}
+	bc_file_putchar(&vm->ferr, bc_flush_none, '\n');
+}
+
+#if BC_ENABLED
+
+/**
+ * Returns true if the last inlined body that was entered is still running,
+ * which means that a stack trace should show it as a frame above its caller.
+ * @param p  The program.
+ * @return   True if the last inlined body is still running, false otherwise.
+ */
+static bool
+bc_program_inInline(BcProgram* p)
+{
+	BcInstPtr* ip;
+	BcFunc* f;
 
-		bc_file_printf(&vm->ferr, "%zu: %s", i, f->name);
+	if (!p->inl.func || p->inl.depth > p->stack.len) return false;
+
+	ip = bc_vec_item(&p->stack, p->inl.depth - 1);
+	f = bc_vec_item(&p->fns, ip->func);
+
+	// The body can only be entered through BC_INST_INLINE, so if the caller has
+	// not been redefined, being inside it means that it is still running.
+	return ip->func == p->inl.caller && f->version == p->inl.version &&
+	       ip->idx > p->inl.bgn && ip->idx <= p->inl.end;
+}
+
+#endif // BC_ENABLED
+
+void
+bc_program_printStackTrace(BcProgram* p)
+{
+	size_t i, n, max_digits, depth;
+
+#if BC_ENABLED
+	// An inlined body has no frame of its own, so it gets an extra one.
+	if (BC_IS_BC && bc_program_inInline(p)) depth = p->inl.depth;
+	else depth = 0;
+#else // BC_ENABLED
+	depth = 0;
+#endif // BC_ENABLED
+
+	max_digits = bc_vm_numDigits(p->stack.len - (depth == 0));
+
+	for (i = 0, n = 0; i < p->stack.len; ++i, ++n)
+	{
+		BcInstPtr* ip = bc_vec_item_rev(&p->stack, i);
 
 #if BC_ENABLED
-		if (BC_IS_BC && ip->func != BC_PROG_MAIN && ip->func != BC_PROG_READ)
+		if (p->stack.len - i == depth)
 		{
-			bc_file_puts(&vm->ferr, bc_flush_none, "()");
+			bc_program_printFrame(p, n, max_digits, p->inl.func);
+			n += 1;
 		}
 #endif // BC_ENABLED
 
-		bc_file_putchar(&vm->ferr, bc_flush_none, '\n');
+		bc_program_printFrame(p, n, max_digits, ip->func);
 	}
 }
 
@@ -3034,6 +4307,19 @@ bc_program_reset(BcProgram* p)
 #if BC_ENABLED
 	// Clear the globals' stacks.
 	if (BC_G) bc_program_popGlobals(p, true);
+
+	// Forget the calls to memoized functions that will never return.
+	if (BC_IS_BC)
+	{
+		while (p->memo_calls.len)
+		{
+			bc_program_memoFree(bc_vec_top(&p->memo_calls), false);
+			bc_vec_pop(&p->memo_calls);
+		}
+
+		// The code of main is about to be cleared.
+		p->inl.func = 0;
+	}
 #endif // BC_ENABLED
 
 	// Clear the bytecode vector of the main function.
@@ -3213,6 +4499,42 @@ bc_program_exec(BcProgram* p)
 				BC_PROG_JUMP(inst, code, ip);
 			}
 
+			// clang-format off
+			BC_PROG_LBL(BC_INST_TAIL_CALL):
+			// clang-format on
+			{
+				assert(BC_IS_BC);
+
+				bc_program_tailCall(p, code, &ip->idx);
+
+				// This may have been a normal call, so update everything.
+				BC_SIG_LOCK;
+				ip = bc_vec_top(&p->stack);
+				func = bc_vec_item(&p->fns, ip->func);
+				code = func->code.v;
+				BC_SIG_UNLOCK;
+
+				BC_PROG_JUMP(inst, code, ip);
+			}
+
+			// clang-format off
+			BC_PROG_LBL(BC_INST_INLINE):
+			// clang-format on
+			{
+				assert(BC_IS_BC);
+
+				bc_program_inline(p, code, &ip->idx);
+
+				// This may have been a normal call, so update everything.
+				BC_SIG_LOCK;
+				ip = bc_vec_top(&p->stack);
+				func = bc_vec_item(&p->fns, ip->func);
+				code = func->code.v;
+				BC_SIG_UNLOCK;
+
+				BC_PROG_JUMP(inst, code, ip);
+			}
+
 			// clang-format off
 			BC_PROG_LBL(BC_INST_INC):
 			BC_PROG_LBL(BC_INST_DEC):
@@ -3234,6 +4556,53 @@ bc_program_exec(BcProgram* p)
 				BC_PROG_JUMP(inst, code, ip);
 			}
 
+			// clang-format off
+			BC_PROG_LBL(BC_INST_VAR_OP_CONST):
+			BC_PROG_LBL(BC_INST_ARRAY_OP_CONST):
+			// clang-format on
+			{
+				bc_program_opConst(p, code, &ip->idx, inst);
+				BC_PROG_JUMP(inst, code, ip);
+			}
+
+			// clang-format off
+			BC_PROG_LBL(BC_INST_VAR_ASSIGN_REGS):
+			// clang-format on
+			{
+				bc_program_assignRegs(p, code, &ip->idx);
+				BC_PROG_JUMP(inst, code, ip);
+			}
+
+			// clang-format off
+			BC_PROG_LBL(BC_INST_VAR_ADDMUL):
+			// clang-format on
+			{
+				bc_program_addMul(p, code, &ip->idx);
+				BC_PROG_JUMP(inst, code, ip);
+			}
+
+			// clang-format off
+			BC_PROG_LBL(BC_INST_REL_JUMP_ZERO):
+			// clang-format on
+			{
+				// The relational operator is where BC_INST_JUMP_ZERO was, and
+				// the label index follows it.
+				cond = bc_program_relJump(p, (uchar) code[ip->idx++]);
+				idx = bc_program_index(code, &ip->idx);
+
+				// This is the same as BC_INST_JUMP_ZERO.
+				if (cond)
+				{
+					size_t* addr = bc_vec_item(&func->labels, idx);
+
+					assert(*addr != SIZE_MAX);
+
+					ip->idx = *addr;
+				}
+
+				BC_PROG_JUMP(inst, code, ip);
+			}
+
 			// clang-format off
 			BC_PROG_LBL(BC_INST_RET):
 			BC_PROG_LBL(BC_INST_RET0):
@@ -3373,6 +4742,8 @@ bc_program_exec(BcProgram* p)
 			BC_PROG_LBL(BC_INST_ABS):
 			BC_PROG_LBL(BC_INST_IS_NUMBER):
 			BC_PROG_LBL(BC_INST_IS_STRING):
+			BC_PROG_LBL(BC_INST_IS_PRIME):
+			BC_PROG_LBL(BC_INST_NEXT_PRIME):
 #if BC_ENABLE_EXTRA_MATH
 			BC_PROG_LBL(BC_INST_IRAND):
 #endif // BC_ENABLE_EXTRA_MATH
@@ -3579,6 +4950,22 @@ bc_program_exec(BcProgram* p)
 				BC_PROG_JUMP(inst, code, ip);
 			}
 
+			// clang-format off
+			BC_PROG_LBL(BC_INST_MODINV):
+			// clang-format on
+			{
+				bc_program_modinv(p);
+				BC_PROG_JUMP(inst, code, ip);
+			}
+
+			// clang-format off
+			BC_PROG_LBL(BC_INST_EGCD):
+			// clang-format on
+			{
+				bc_program_egcd(p);
+				BC_PROG_JUMP(inst, code, ip);
+			}
+
 			// clang-format off
 			BC_PROG_LBL(BC_INST_PRINT_STREAM):
 			// clang-format on
@@ -3844,8 +5231,15 @@ bc_program_printInst(const BcProgram* p, const char* restrict code,
 	             (unsigned long) inst);
 
 	if (inst == BC_INST_VAR || inst == BC_INST_ARRAY_ELEM ||
-	    inst == BC_INST_ARRAY)
+	    inst == BC_INST_ARRAY || inst == BC_INST_VAR_OP_CONST ||
+	    inst == BC_INST_ARRAY_OP_CONST || inst == BC_INST_VAR_ASSIGN_REGS ||
+	    inst == BC_INST_VAR_ADDMUL)
+	{
+		bc_program_printIndex(code, bgn);
+	}
+	else if (inst == BC_INST_REL_JUMP_ZERO)
 	{
+		bc_vm_printf("%s ", bc_inst_names[(uchar) code[(*bgn)++]]);
 		bc_program_printIndex(code, bgn);
 	}
 	else if (inst == BC_INST_STR) bc_program_printStr(p, code, bgn);
@@ -3855,11 +5249,26 @@ bc_program_printInst(const BcProgram* p, const char* restrict code,
 		BcConst* c = bc_vec_item(&p->consts, idx);
 		bc_vm_printf("(%s)", c->val);
 	}
-	else if (inst == BC_INST_CALL ||
+	else if (inst == BC_INST_CALL || inst == BC_INST_TAIL_CALL ||
 	         (inst > BC_INST_STR && inst <= BC_INST_JUMP_ZERO))
 	{
 		bc_program_printIndex(code, bgn);
-		if (inst == BC_INST_CALL) bc_program_printIndex(code, bgn);
+		if (inst == BC_INST_CALL || inst == BC_INST_TAIL_CALL)
+		{
+			bc_program_printIndex(code, bgn);
+		}
+	}
+	else if (inst == BC_INST_INLINE)
+	{
+		size_t i, nargs = bc_program_index(code, bgn);
+
+		bc_vm_printf(" (%zu) ", nargs);
+
+		// The function, version, label, and the variables.
+		for (i = 0; i < nargs + 3; ++i)
+		{
+			bc_program_printIndex(code, bgn);
+		}
 	}
 
 	bc_vm_putchar('\n', bc_flush_err);
@@ -402,89 +402,188 @@ bc_vec_free(void* vec)
 
 #if !BC_ENABLE_LIBRARY
 
+size_t
+bc_map_hashBytes(size_t h, const char* str, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; ++i)
+	{
+		h ^= (uchar) str[i];
+		h *= (size_t) UINT32_C(16777619);
+	}
+
+	return h;
+}
+
 /**
- * Finds a name in a map by binary search. Returns the index where the item
- * *would* be if it doesn't exist. Callers are responsible for checking that the
- * item exists at the index.
- * @param v     The map.
- * @param name  The name to find.
- * @return      The index of the item with @a name, or where the item would be
- *              if it does not exist.
+ * Hashes a name for a map, with the high bits folded into the low bits because
+ * the low bits are used to index the hash table.
+ * @param name  The name to hash.
+ * @return      The hash of @a name.
  */
 static size_t
-bc_map_find(const BcVec* restrict v, const char* name)
+bc_map_hash(const char* name)
 {
-	size_t low = 0, high = v->len;
+	size_t h = bc_map_hashBytes(BC_MAP_HASH, name, strlen(name));
+
+	return h ^ (h >> 16);
+}
+
+/**
+ * Finds the slot in the hash table of a map for a name. The slot either has
+ * the index of the ID with @a name, or it is empty, and it is where the ID
+ * would go.
+ * @param m     The map.
+ * @param name  The name to find.
+ * @return      A pointer to the slot for @a name.
+ */
+static size_t*
+bc_map_slot(const BcMap* restrict m, const char* name)
+{
+	size_t* table = (size_t*) m->table.v;
+	size_t mask = m->table.len - 1;
+	size_t i = bc_map_hash(name) & mask;
+
+	// This is linear probing. It always ends because the table is never more
+	// than half full.
+	while (table[i])
+	{
+		const BcId* id = bc_vec_item(&m->ids, table[i] - 1);
+		if (!strcmp(name, id->name)) break;
+		i = (i + 1) & mask;
+	}
+
+	return table + i;
+}
+
+/**
+ * Doubles the size of the hash table of a map and puts the IDs back into it.
+ * @param m  The map.
+ */
+static void
+bc_map_grow(BcMap* restrict m)
+{
+	size_t i, len = m->table.len * 2, mask = len - 1;
+	size_t* table;
+
+	bc_vec_expand(&m->table, len);
+	m->table.len = len;
+
+	table = (size_t*) m->table.v;
+
+	// NOLINTNEXTLINE
+	memset(table, 0, len * sizeof(size_t));
 
-	while (low < high)
+	// Names are unique, so there is no need to compare them.
+	for (i = 0; i < m->ids.len; ++i)
 	{
-		size_t mid = low + (high - low) / 2;
-		const BcId* id = bc_vec_item(v, mid);
-		int result = strcmp(name, id->name);
+		const BcId* id = bc_vec_item(&m->ids, i);
+		size_t j = bc_map_hash(id->name) & mask;
+
+		while (table[j])
+		{
+			j = (j + 1) & mask;
+		}
 
-		if (!result) return mid;
-		else if (result < 0) high = mid;
-		else low = mid + 1;
+		table[j] = i + 1;
 	}
+}
+
+void
+bc_map_init(BcMap* restrict m)
+{
+	BC_SIG_ASSERT_LOCKED;
+
+	assert(m != NULL);
 
-	return low;
+	bc_vec_init(&m->ids, sizeof(BcId), BC_DTOR_NONE);
+	bc_vec_init(&m->table, sizeof(size_t), BC_DTOR_NONE);
+
+	// The table starts with the capacity that vectors start with, all empty.
+	// NOLINTNEXTLINE
+	memset(m->table.v, 0, BC_VEC_START_CAP * sizeof(size_t));
+	m->table.len = BC_VEC_START_CAP;
+}
+
+void
+bc_map_free(BcMap* restrict m)
+{
+	BC_SIG_ASSERT_LOCKED;
+
+	assert(m != NULL);
+
+	bc_vec_free(&m->table);
+	bc_vec_free(&m->ids);
 }
 
 bool
-bc_map_insert(BcVec* restrict v, const char* name, size_t idx,
+bc_map_insert(BcMap* restrict m, const char* name, size_t idx,
               size_t* restrict i)
 {
 	BcId id;
+	size_t* slot;
 
 	BC_SIG_ASSERT_LOCKED;
 
-	assert(v != NULL && name != NULL && i != NULL);
-
-	*i = bc_map_find(v, name);
+	assert(m != NULL && name != NULL && i != NULL);
 
-	assert(*i <= v->len);
+	slot = bc_map_slot(m, name);
 
-	if (*i != v->len && !strcmp(name, ((BcId*) bc_vec_item(v, *i))->name))
+	if (*slot)
 	{
+		*i = *slot - 1;
 		return false;
 	}
 
+	// Keep the table at most half full so probe sequences stay short.
+	if ((m->ids.len + 1) * 2 > m->table.len)
+	{
+		bc_map_grow(m);
+		slot = bc_map_slot(m, name);
+	}
+
 	id.name = bc_slabvec_strdup(&vm->slabs, name);
 	id.idx = idx;
 
-	bc_vec_pushAt(v, &id, *i);
+	*i = m->ids.len;
+	bc_vec_push(&m->ids, &id);
+
+	*slot = m->ids.len;
 
 	return true;
 }
 
 size_t
-bc_map_index(const BcVec* restrict v, const char* name)
+bc_map_index(const BcMap* restrict m, const char* name)
 {
-	size_t i;
-	BcId* id;
-
-	assert(v != NULL && name != NULL);
+	size_t slot;
 
-	i = bc_map_find(v, name);
+	assert(m != NULL && name != NULL);
 
-	// If out of range, return invalid.
-	if (i >= v->len) return BC_VEC_INVALID_IDX;
+	slot = *bc_map_slot(m, name);
 
-	id = (BcId*) bc_vec_item(v, i);
-
-	// Make sure the item exists and return appropriately.
-	return strcmp(name, id->name) ? BC_VEC_INVALID_IDX : i;
+	return slot ? slot - 1 : BC_VEC_INVALID_IDX;
 }
 
 #if DC_ENABLED
 const char*
-bc_map_name(const BcVec* restrict v, size_t idx)
+bc_map_name(const BcMap* restrict m, size_t idx)
 {
-	size_t i, len = v->len;
+	size_t i, len = m->ids.len;
+	const BcId* id;
+
+	// The IDs are in insertion order, and the partner arrays are pushed to when
+	// IDs are inserted, so the ID is almost certainly at the same index.
+	if (idx < len)
+	{
+		id = bc_vec_item(&m->ids, idx);
+		if (id->idx == idx) return id->name;
+	}
 
 	for (i = 0; i < len; ++i)
 	{
-		BcId* id = (BcId*) bc_vec_item(v, i);
+		id = bc_vec_item(&m->ids, i);
 		if (id->idx == idx) return id->name;
 	}
 
@@ -320,6 +320,11 @@ bc_vm_handleError(BcErr e)
 		vm->err = (BclError) (e - BC_ERR_MATH_NEGATIVE +
 		                      BCL_ERROR_MATH_NEGATIVE);
 	}
+	// Parse errors come from compiling expressions.
+	else if (e >= BC_ERR_PARSE_EOF && e < BC_ERR_POSIX_START)
+	{
+		vm->err = BCL_ERROR_PARSE_INVALID_STR;
+	}
 	// Abort if we should.
 	else if (vm->abrt) abort();
 	else if (e == BC_ERR_FATAL_ALLOC_ERR) vm->err = BCL_ERROR_FATAL_ALLOC_ERR;
@@ -653,7 +658,8 @@ bc_vm_shutdown(void)
 #endif // BC_ENABLE_HISTORY
 #endif // !BC_ENABLE_LIBRARY
 
-#if BC_DEBUG || BC_ENABLE_MEMCHECK
+// The library frees its caches because threads can come and go.
+#if BC_DEBUG || BC_ENABLE_MEMCHECK || BC_ENABLE_LIBRARY
 #if !BC_ENABLE_LIBRARY
 	bc_vec_free(&vm->env_args);
 	free(vm->env_args_buffer);
@@ -672,67 +678,150 @@ bc_vm_shutdown(void)
 	bc_slabvec_free(&vm->slabs);
 #endif // !BC_ENABLE_LIBRARY
 
+	bc_vm_freeRecips();
 	bc_vm_freeTemps();
-#endif // BC_DEBUG || BC_ENABLE_MEMCHECK
+#endif // BC_DEBUG || BC_ENABLE_MEMCHECK || BC_ENABLE_LIBRARY
 
 #if !BC_ENABLE_LIBRARY
+#if BC_DEBUG_CODE
+	bc_file_printf(&vm->ferr, "temps: %zu hits, %zu misses, %zu drops\n",
+	               vm->temps_hits, vm->temps_misses, vm->temps_drops);
+#endif // BC_DEBUG_CODE
+
 	// We always want to flush.
 	bc_file_free(&vm->fout);
 	bc_file_free(&vm->ferr);
 #endif // !BC_ENABLE_LIBRARY
 }
 
+/**
+ * Returns the size class of temps for a limb array with capacity @a cap, or
+ * BC_VM_TEMP_CLASSES if it does not have one.
+ * @param cap  The capacity of the limb array.
+ * @return     The size class.
+ */
+static size_t
+bc_vm_tempClass(size_t cap)
+{
+	size_t i;
+
+	for (i = 0; i < BC_VM_TEMP_CLASSES; ++i)
+	{
+		if (cap == ((size_t) BC_NUM_DEF_SIZE) << i) break;
+	}
+
+	return i;
+}
+
+size_t
+bc_vm_tempCap(size_t req)
+{
+	size_t i, cap = BC_NUM_DEF_SIZE;
+
+	for (i = 1; i < BC_VM_TEMP_CLASSES && cap < req; ++i)
+	{
+		cap <<= 1;
+	}
+
+	return cap >= req ? cap : req;
+}
+
 void
-bc_vm_addTemp(BcDig* num)
+bc_vm_addTemp(BcDig* num, size_t cap)
 {
+	size_t i = bc_vm_tempClass(cap);
 #if BC_ENABLE_LIBRARY
 	BcVm* vm = bcl_getspecific();
 #endif // BC_ENABLE_LIBRARY
 
 	BC_SIG_ASSERT_LOCKED;
 
-	// If we don't have room, just free.
-	if (vm->temps_len == BC_VM_MAX_TEMPS) free(num);
+	// If it does not fit in a class, or we don't have room, just free.
+	if (i == BC_VM_TEMP_CLASSES) free(num);
+	else if (vm->temps_size + BC_NUM_SIZE(cap) > BC_VM_MAX_TEMPS_SIZE)
+	{
+		free(num);
+
+#if BC_DEBUG_CODE
+		vm->temps_drops += 1;
+#endif // BC_DEBUG_CODE
+	}
 	else
 	{
-		// Add to the buffer and length.
-		vm->temps_buf[vm->temps_len] = num;
-		vm->temps_len += 1;
+		// Push onto the list for the class.
+		// NOLINTNEXTLINE
+		memcpy(num, vm->temps + i, sizeof(BcDig*));
+		vm->temps[i] = num;
+		vm->temps_size += BC_NUM_SIZE(cap);
 	}
 }
 
 BcDig*
-bc_vm_takeTemp(void)
+bc_vm_takeTemp(size_t cap)
 {
+	size_t i = bc_vm_tempClass(cap);
+	BcDig* num;
 #if BC_ENABLE_LIBRARY
 	BcVm* vm = bcl_getspecific();
 #endif // BC_ENABLE_LIBRARY
 
 	BC_SIG_ASSERT_LOCKED;
 
-	if (!vm->temps_len) return NULL;
+	if (i == BC_VM_TEMP_CLASSES) return NULL;
+
+	num = vm->temps[i];
 
-	vm->temps_len -= 1;
+	if (num == NULL)
+	{
+#if BC_DEBUG_CODE
+		vm->temps_misses += 1;
+#endif // BC_DEBUG_CODE
 
-	return vm->temps_buf[vm->temps_len];
+		return NULL;
+	}
+
+	// Pop off of the list for the class.
+	// NOLINTNEXTLINE
+	memcpy(vm->temps + i, num, sizeof(BcDig*));
+	vm->temps_size -= BC_NUM_SIZE(cap);
+
+#if BC_DEBUG_CODE
+	vm->temps_hits += 1;
+#endif // BC_DEBUG_CODE
+
+	return num;
 }
 
-BcDig*
-bc_vm_getTemp(void)
+void
+bc_vm_freeTemps(void)
 {
+	size_t i;
 #if BC_ENABLE_LIBRARY
 	BcVm* vm = bcl_getspecific();
 #endif // BC_ENABLE_LIBRARY
 
 	BC_SIG_ASSERT_LOCKED;
 
-	if (!vm->temps_len) return NULL;
+	if (!vm->temps_size) return;
 
-	return vm->temps_buf[vm->temps_len - 1];
+	// Free them all...
+	for (i = 0; i < BC_VM_TEMP_CLASSES; ++i)
+	{
+		while (vm->temps[i] != NULL)
+		{
+			BcDig* num = vm->temps[i];
+
+			// NOLINTNEXTLINE
+			memcpy(vm->temps + i, num, sizeof(BcDig*));
+			free(num);
+		}
+	}
+
+	vm->temps_size = 0;
 }
 
 void
-bc_vm_freeTemps(void)
+bc_vm_freeRecips(void)
 {
 	size_t i;
 #if BC_ENABLE_LIBRARY
@@ -741,15 +830,20 @@ bc_vm_freeTemps(void)
 
 	BC_SIG_ASSERT_LOCKED;
 
-	if (!vm->temps_len) return;
-
-	// Free them all...
-	for (i = 0; i < vm->temps_len; ++i)
+	for (i = 0; i < BC_NUM_RECIP_SLOTS; ++i)
 	{
-		free(vm->temps_buf[i]);
+		BcNumRecip* r = vm->recips + i;
+
+		// These are freed directly instead of with bc_num_free() because this
+		// is called when the temps are going away as well.
+		free(r->div.num);
+		free(r->recip.num);
+
+		// NOLINTNEXTLINE
+		memset(r, 0, sizeof(BcNumRecip));
 	}
 
-	vm->temps_len = 0;
+	vm->recips_next = 0;
 }
 
 #if !BC_ENABLE_LIBRARY
@@ -1066,14 +1160,24 @@ bc_vm_endif(void)
 
 #endif // BC_ENABLED
 
+#if BC_ENABLED
+static void
+bc_vm_cache(BcCacheFile* c, const char* file);
+#endif // BC_ENABLED
+
 /**
  * Processes a file.
- * @param file  The filename.
+ * @param file   The filename.
+ * @param cache  True if the file may be a bytecode cache, false if it has to be
+ *               a script.
  */
 static void
-bc_vm_file(const char* file)
+bc_vm_file(const char* file, bool cache)
 {
 	char* data = NULL;
+#if BC_ENABLED
+	BcCacheFile c;
+#endif // BC_ENABLED
 #if BC_ENABLE_LIBRARY
 	BcVm* vm = bcl_getspecific();
 #endif // BC_ENABLE_LIBRARY
@@ -1082,6 +1186,23 @@ bc_vm_file(const char* file)
 
 	vm->mode = BC_MODE_FILE;
 
+#if BC_ENABLED
+	if (BC_IS_BC && cache)
+	{
+		BC_SIG_LOCK;
+
+		if (bc_cache_open(&c, file))
+		{
+			bc_vm_cache(&c, file);
+			return;
+		}
+
+		BC_SIG_UNLOCK;
+	}
+#else // BC_ENABLED
+	BC_UNUSED(cache);
+#endif // BC_ENABLED
+
 	// Set up the lexer.
 	bc_lex_file(&vm->prs.l, file);
 
@@ -1119,6 +1240,119 @@ err:
 	BC_LONGJMP_CONT(vm);
 }
 
+#if BC_ENABLED
+
+/**
+ * Runs a bytecode cache or, if it cannot be run, the script that it was
+ * compiled from.
+ * @param c     The cache, opened by bc_cache_open().
+ * @param file  The filename of the cache.
+ */
+static void
+bc_vm_cache(BcCacheFile* c, const char* file)
+{
+	BC_SIG_ASSERT_LOCKED;
+
+	BC_SETJMP_LOCKED(vm, err);
+
+	BC_SIG_UNLOCK;
+
+	if (c->good)
+	{
+		bc_lex_file(&vm->prs.l, file);
+		bc_cache_run(c);
+	}
+	else bc_vm_file(c->src, false);
+
+err:
+
+	BC_SIG_MAYLOCK;
+
+	// The filename must not be left pointing to the freed source path.
+	vm->file = file;
+
+	bc_cache_close(c);
+
+	// The script cleans up after itself.
+	if (c->good) bc_vm_clean();
+
+	if (vm->status == (sig_atomic_t) BC_STATUS_SUCCESS) BC_LONGJMP_STOP;
+
+	BC_LONGJMP_CONT(vm);
+}
+
+/**
+ * Compiles a file into the bytecode cache in vm->compile instead of running it.
+ * Everything is parsed like it would be for bc_vm_file(), and every time bc
+ * would execute, the cache records what was parsed instead.
+ * @param file  The filename.
+ */
+static void
+bc_vm_compile(const char* file)
+{
+	char* data = NULL;
+
+	vm->mode = BC_MODE_FILE;
+
+	bc_lex_file(&vm->prs.l, file);
+
+	BC_SIG_LOCK;
+
+	data = bc_read_file(file);
+
+	assert(data != NULL);
+
+	bc_cache_init(&vm->cache, file, data);
+
+	BC_SETJMP_LOCKED(vm, err);
+
+	BC_SIG_UNLOCK;
+
+	bc_parse_text(&vm->prs, data, BC_MODE_FILE);
+
+	while (vm->prs.l.t != BC_LEX_EOF)
+	{
+		BC_SIG_LOCK;
+
+		vm->parse(&vm->prs);
+
+		if (!BC_PARSE_NO_EXEC(&vm->prs)) bc_cache_step(&vm->cache);
+
+		BC_SIG_UNLOCK;
+	}
+
+	// Make sure to end any open if statements.
+	bc_parse_endif(&vm->prs);
+
+	BC_SIG_LOCK;
+	bc_cache_step(&vm->cache);
+	BC_SIG_UNLOCK;
+
+err:
+
+	BC_SIG_MAYLOCK;
+
+	free(data);
+
+	// A quit stops parsing, so running the cache has to stop there too.
+	if (vm->status == (sig_atomic_t) BC_STATUS_QUIT && !vm->sig)
+	{
+		bc_cache_event(&vm->cache, BC_CACHE_QUIT);
+		vm->status = BC_STATUS_SUCCESS;
+	}
+
+	if (vm->status == (sig_atomic_t) BC_STATUS_SUCCESS) BC_LONGJMP_STOP;
+	else bc_cache_free(&vm->cache);
+
+	BC_LONGJMP_CONT(vm);
+
+	BC_SIG_LOCK;
+	bc_cache_write(&vm->cache, vm->compile);
+	BC_SIG_UNLOCK;
+}
+
+#endif // BC_ENABLED
+
 #if !BC_ENABLE_OSSFUZZ
 
 bool
@@ -1344,21 +1578,41 @@ err:
 #if BC_ENABLED
 
 /**
- * Loads a math library.
- * @param name  The name of the library.
+ * Loads a math library. Its functions are not parsed here; this only finds
+ * their names and where their definitions start. bc_program_loadFunc() parses
+ * each one the first time that it is called, so bc -l starts as fast as bc.
  * @param text  The text of the source code.
  */
 static void
-bc_vm_load(const char* name, const char* text)
+bc_vm_load(const char* text)
 {
-	bc_lex_file(&vm->prs.l, name);
-	bc_parse_text(&vm->prs, text, BC_MODE_FILE);
+	const char* def = text;
 
 	BC_SIG_LOCK;
 
-	while (vm->prs.l.t != BC_LEX_EOF)
+	// The libraries only have function definitions, and each starts a line.
+	while (def != NULL)
 	{
-		vm->parse(&vm->prs);
+		const char* name = def + sizeof("define");
+		const char* paren = strchr(name, '(');
+		const char* space;
+		BcFunc* f;
+		size_t idx;
+
+		assert(!strncmp(def, "define ", sizeof("define")) && paren != NULL);
+
+		// Skip "void" and the like.
+		space = memchr(name, ' ', (size_t) (paren - name));
+		if (space != NULL) name = space + 1;
+
+		bc_vec_string(&vm->prs.l.str, (size_t) (paren - name), name);
+
+		idx = bc_program_insertFunc(&vm->prog, vm->prs.l.str.v);
+		f = bc_vec_item(&vm->prog.fns, idx);
+		f->lib = def;
+
+		def = strstr(paren, "\ndefine ");
+		if (def != NULL) def += 1;
 	}
 
 	BC_SIG_UNLOCK;
@@ -1460,21 +1714,26 @@ bc_vm_exec(void)
 	// Load the math libraries.
 	if (BC_IS_BC && (vm->flags & BC_FLAG_L))
 	{
-		// Can't allow redefinitions in the builtin library.
-		vm->no_redefine = true;
-
-		bc_vm_load(bc_lib_name, bc_lib);
+		bc_vm_load(bc_lib);
 
 #if BC_ENABLE_EXTRA_MATH
-		if (!BC_IS_POSIX) bc_vm_load(bc_lib2_name, bc_lib2);
+		if (!BC_IS_POSIX) bc_vm_load(bc_lib2);
 #endif // BC_ENABLE_EXTRA_MATH
+	}
+#endif // BC_ENABLED
 
-		// Make sure to clear this.
-		vm->no_redefine = false;
+#if BC_ENABLED
+	// Compiling a script is all that bc does when compiling.
+	if (vm->compile != NULL)
+	{
+		if (BC_ERR(vm->exprs.len || vm->files.len != 1))
+		{
+			bc_verr(BC_ERR_FATAL_OPTION, "-o (--compile)");
+		}
 
-		// Execute to ensure that all is hunky dory. Without this, scale can be
-		// set improperly.
-		bc_program_exec(&vm->prog);
+		bc_vm_compile(*((char**) bc_vec_item(&vm->files, 0)));
+
+		return;
 	}
 #endif // BC_ENABLED
 
@@ -1502,7 +1761,7 @@ bc_vm_exec(void)
 #if DC_ENABLED
 		has_file = true;
 #endif // DC_ENABLED
-		bc_vm_file(path);
+		bc_vm_file(path, true);
 
 		if (vm->status != BC_STATUS_SUCCESS) return;
 	}
@@ -1801,17 +2060,11 @@ bc_vm_init(void)
 void
 bc_vm_atexit(void)
 {
-#if BC_DEBUG
-#if BC_ENABLE_LIBRARY
 	BcVm* vm = bcl_getspecific();
-#endif // BC_ENABLE_LIBRARY
-#endif // BC_DEBUG
 
 	bc_vm_shutdown();
 
-#if BC_DEBUG
 	bc_vec_free(&vm->jmp_bufs);
-#endif // BC_DEBUG
 }
 #else // BC_ENABLE_LIBRARY
 BcStatus
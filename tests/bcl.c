@@ -53,12 +53,22 @@ int
 main(void)
 {
 	BclError e;
-	BclContext ctxt;
+	BclContext ctxt, ctxt2;
 	size_t scale;
 	BclNumber n, n2, n3, n4, n5, n6, n7;
 	char* res;
 	unsigned char seed[BCL_SEED_SIZE];
 	BclBigDig b = 0;
+	bool prime;
+	BclLimb limbs[4], flimbs[4];
+	unsigned char bytes[8], fbytes[8];
+	size_t ilen, flen;
+	char buf[32];
+	BclNumber va[3], vb[3], vc[3];
+	size_t i;
+	BclExpr expr;
+	BclFuture fut, fut2, fut3;
+	BclShared shr;
 
 	e = bcl_start();
 	err(e);
@@ -291,6 +301,85 @@ main(void)
 	n7 = bcl_modexp(bcl_dup(n5), bcl_dup(n5), bcl_dup(n5));
 	err(bcl_err(n7));
 
+	// Check primality with both tests. 2^89-1 is prime.
+	n6 = bcl_parse("618970019642690137449562111");
+	err(bcl_err(n6));
+
+	e = bcl_isprime_keep(n6, false, &prime);
+	err(e);
+	if (!prime) err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+
+	e = bcl_isprime_keep(n6, true, &prime);
+	err(e);
+	if (!prime) err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+
+	// This is a strong pseudoprime to the first 12 prime bases.
+	n7 = bcl_parse("318665857834031151167461");
+	err(bcl_err(n7));
+
+	e = bcl_isprime(bcl_dup(n7), false, &prime);
+	err(e);
+	if (prime) err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+
+	e = bcl_isprime_keep(n7, true, &prime);
+	err(e);
+	if (prime) err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+
+	// And check the next prime.
+	n7 = bcl_nextprime(n7);
+	err(bcl_err(n7));
+
+	res = bcl_string_keep(n7);
+	if (strcmp(res, "318665857834031151167483"))
+	{
+		err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+	}
+
+	free(res);
+
+	n7 = bcl_nextprime_keep(n6);
+	err(bcl_err(n7));
+
+	// Check the modular inverse modulo 2^89-1.
+	n7 = bcl_parse("12345678901234567890");
+	err(bcl_err(n7));
+
+	n7 = bcl_modinv(n7, bcl_dup(n6));
+	err(bcl_err(n7));
+
+	res = bcl_string_keep(n7);
+	if (strcmp(res, "338604421359886006294785622"))
+	{
+		err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+	}
+
+	free(res);
+
+	// And the extended GCD. 240 * -9 + 46 * 47 is 2.
+	n5 = bcl_parse("240");
+	err(bcl_err(n5));
+
+	n6 = bcl_parse("46");
+	err(bcl_err(n6));
+
+	e = bcl_egcd_keep(n5, n6, &n2, &n3, &n4);
+	err(e);
+
+	res = bcl_string(n2);
+	if (strcmp(res, "2")) err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+	free(res);
+
+	res = bcl_string(n3);
+	if (strcmp(res, "-9")) err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+	free(res);
+
+	res = bcl_string(n4);
+	if (strcmp(res, "47")) err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+	free(res);
+
+	e = bcl_egcd(n5, n6, &n2, &n3, &n4);
+	err(e);
+
 	// Clean up.
 	bcl_num_free(n);
 
@@ -382,6 +471,345 @@ main(void)
 
 	free(res);
 
+	// Test exporting and importing limbs.
+	n = bcl_parse("-1234567890.0123456789");
+	err(bcl_err(n));
+
+	ilen = flen = 1;
+	e = bcl_limbs_keep(n, limbs, &ilen, flimbs, &flen);
+	if (e != BCL_ERROR_MATH_OVERFLOW || ilen != 2 || flen != 2)
+	{
+		err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+	}
+
+	err(bcl_limbs_keep(n, limbs, &ilen, flimbs, &flen));
+
+	if (limbs[0] != 234567890 || limbs[1] != 1 || flimbs[0] != 900000000 ||
+	    flimbs[1] != 12345678)
+	{
+		err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+	}
+
+	n2 = bcl_limbs2num(limbs, ilen, flimbs, 10, true);
+	err(bcl_err(n2));
+
+	if (bcl_cmp(n, n2) || bcl_num_scale(n2) != 10)
+	{
+		err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+	}
+
+	limbs[0] = BCL_LIMB_POW;
+	n2 = bcl_limbs2num(limbs, ilen, flimbs, 10, true);
+	if (bcl_err(n2) != BCL_ERROR_MATH_OVERFLOW)
+	{
+		err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+	}
+
+	// Test exporting and importing bytes.
+	n3 = bcl_parse("258.25");
+	err(bcl_err(n3));
+
+	ilen = flen = sizeof(bytes);
+	err(bcl_bytes_keep(n3, true, bytes, &ilen, fbytes, &flen));
+
+	if (ilen != 2 || bytes[0] != 1 || bytes[1] != 2 || flen != 1 ||
+	    fbytes[0] != 25)
+	{
+		err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+	}
+
+	n4 = bcl_bytes2num(bytes, ilen, fbytes, flen, 2, false, true);
+	err(bcl_err(n4));
+
+	if (bcl_cmp(n3, n4)) err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+
+	fbytes[0] = 100;
+	n4 = bcl_bytes2num(bytes, ilen, fbytes, flen, 2, false, true);
+	if (bcl_err(n4) != BCL_ERROR_MATH_OVERFLOW)
+	{
+		err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+	}
+
+	// Test converting to a string in a buffer.
+	e = bcl_string_into_keep(n, buf, 8, &ilen);
+	if (e != BCL_ERROR_MATH_OVERFLOW || ilen != 22)
+	{
+		err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+	}
+
+	err(bcl_string_into(n, buf, sizeof(buf), NULL));
+	if (strcmp(buf, "-1234567890.0123456789")) err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+
+	err(bcl_string_into(n3, buf, sizeof(buf), &ilen));
+	if (strcmp(buf, "258.25") || ilen != 6) err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+
+	// Test the explicit context functions on a context that is not pushed.
+	ctxt2 = bcl_ctxt_create();
+
+	n = bcl_ctxt_parse(ctxt2, "2.5");
+	err(bcl_ctxt_err(ctxt2, n));
+
+	n2 = bcl_ctxt_bigdig2num(ctxt2, 3);
+	err(bcl_ctxt_err(ctxt2, n2));
+
+	n3 = bcl_ctxt_mul_keep(ctxt2, n, n2);
+	err(bcl_ctxt_err(ctxt2, n3));
+
+	n3 = bcl_ctxt_add(ctxt2, n3, n);
+	err(bcl_ctxt_err(ctxt2, n3));
+
+	res = bcl_ctxt_string_keep(ctxt2, n3);
+	if (strcmp(res, "10.0")) err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+
+	free(res);
+
+	if (bcl_ctxt_cmp(ctxt2, n3, n2) <= 0) err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+
+	// Test the batched functions.
+	bcl_ctxt_setScale(ctxt2, 2);
+
+	for (i = 0; i < 3; ++i)
+	{
+		va[i] = bcl_ctxt_bigdig2num(ctxt2, i + 1);
+		err(bcl_ctxt_err(ctxt2, va[i]));
+		vb[i] = bcl_ctxt_bigdig2num(ctxt2, 2 * (i + 1));
+		err(bcl_ctxt_err(ctxt2, vb[i]));
+	}
+
+	err(bcl_ctxt_add_array(ctxt2, va, vb, vc, 3));
+
+	res = bcl_ctxt_string(ctxt2, vc[2]);
+	if (strcmp(res, "9")) err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+
+	free(res);
+
+	bcl_ctxt_num_free(ctxt2, vc[0]);
+	bcl_ctxt_num_free(ctxt2, vc[1]);
+
+	err(bcl_ctxt_div_array(ctxt2, va, vb, vc, 3));
+
+	n = bcl_ctxt_sum(ctxt2, vc, 3);
+	n2 = bcl_ctxt_parse(ctxt2, "1.5");
+	if (bcl_ctxt_cmp(ctxt2, n, n2)) err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+
+	n = bcl_ctxt_prod(ctxt2, va, 3);
+	n2 = bcl_ctxt_dot(ctxt2, va, vb, 3);
+	res = bcl_ctxt_string(ctxt2, bcl_ctxt_add(ctxt2, n, n2));
+	if (strcmp(res, "34")) err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+
+	free(res);
+
+	n = bcl_ctxt_bigdig2num(ctxt2, 3);
+	err(bcl_ctxt_axpy(ctxt2, n, va, vb, 3));
+
+	res = bcl_ctxt_string(ctxt2, bcl_ctxt_sum(ctxt2, vb, 3));
+	if (strcmp(res, "30")) err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+
+	free(res);
+
+	// A failed batch must not leave any results behind.
+	bcl_ctxt_zero(ctxt2, vb[2]);
+	e = bcl_ctxt_div_array(ctxt2, va, vb, vc, 3);
+	if (e != BCL_ERROR_MATH_DIVIDE_BY_ZERO) err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+	if (bcl_ctxt_err(ctxt2, vc[0]) == BCL_ERROR_NONE)
+	{
+		err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+	}
+
+	// Test compiled expressions.
+	err(bcl_ctxt_expr_compile(ctxt2, "-x^2 + sqrt(y) * (x - 1) / 2", &expr));
+
+	if (bcl_expr_nvars(expr) != 2 || strcmp(bcl_expr_var(expr, 1), "y"))
+	{
+		err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+	}
+
+	vc[0] = va[2];
+	vc[1] = bcl_ctxt_parse(ctxt2, "16");
+
+	res = bcl_ctxt_string(ctxt2, bcl_expr_eval(expr, vc, 2));
+	if (strcmp(res, "13.00")) err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+
+	free(res);
+
+	// Evaluate again with a different binding.
+	vc[0] = va[1];
+
+	res = bcl_ctxt_string(ctxt2, bcl_expr_eval(expr, vc, 2));
+	if (strcmp(res, "6.00")) err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+
+	free(res);
+
+	bcl_ctxt_num_setNeg(ctxt2, vc[1], true);
+
+	n = bcl_expr_eval(expr, vc, 2);
+	if (bcl_ctxt_err(ctxt2, n) != BCL_ERROR_MATH_NEGATIVE)
+	{
+		err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+	}
+
+	n = bcl_expr_eval(expr, vc, 1);
+	if (bcl_ctxt_err(ctxt2, n) != BCL_ERROR_INVALID_NUM)
+	{
+		err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+	}
+
+	bcl_expr_free(expr);
+
+	e = bcl_ctxt_expr_compile(ctxt2, "x +", &expr);
+	if (e != BCL_ERROR_PARSE_INVALID_STR || expr != NULL)
+	{
+		err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+	}
+
+	// Test the worker pool.
+	err(bcl_pool_start(2));
+
+	n = bcl_ctxt_parse(ctxt2, "12345678901234567890");
+	err(bcl_ctxt_err(ctxt2, n));
+
+	n2 = bcl_ctxt_parse(ctxt2, "6");
+	err(bcl_ctxt_err(ctxt2, n2));
+
+	err(bcl_ctxt_async_mul(ctxt2, n, n, &fut));
+	err(bcl_ctxt_async_sqrt(ctxt2, n2, &fut2));
+	err(bcl_ctxt_async_string(ctxt2, n, &fut3));
+
+	res = bcl_ctxt_string(ctxt2, bcl_ctxt_future_num(ctxt2, fut));
+	if (strcmp(res, "152415787532388367501905199875019052100"))
+	{
+		err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+	}
+
+	free(res);
+
+	err(bcl_future_wait(fut2));
+	if (!bcl_future_done(fut2)) err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+
+	res = bcl_ctxt_string(ctxt2, bcl_ctxt_future_num(ctxt2, fut2));
+	if (strcmp(res, "2.44")) err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+
+	free(res);
+
+	res = bcl_future_string(fut3);
+	if (strcmp(res, "12345678901234567890")) err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+
+	free(res);
+
+	// Errors come back through the future.
+	n3 = bcl_ctxt_parse(ctxt2, "0");
+	err(bcl_ctxt_async_div(ctxt2, n, n3, &fut));
+	err(bcl_ctxt_async_parse(ctxt2, "x", &fut2));
+
+	if (bcl_future_wait(fut) != BCL_ERROR_MATH_DIVIDE_BY_ZERO)
+	{
+		err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+	}
+
+	n3 = bcl_ctxt_future_num(ctxt2, fut);
+	if (bcl_ctxt_err(ctxt2, n3) != BCL_ERROR_MATH_DIVIDE_BY_ZERO)
+	{
+		err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+	}
+
+	n3 = bcl_ctxt_future_num(ctxt2, fut2);
+	if (bcl_ctxt_err(ctxt2, n3) != BCL_ERROR_PARSE_INVALID_STR)
+	{
+		err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+	}
+
+	// Cancelling works whether or not the job has started.
+	err(bcl_ctxt_async_pow(ctxt2, n, n2, &fut));
+	bcl_future_cancel(fut);
+
+	// Shared numbers can be used by any context and by the workers.
+	n = bcl_ctxt_parse(ctxt2, "12345678901234567890");
+	err(bcl_ctxt_share(ctxt2, n, &shr));
+
+	n = bcl_shared_num(shr);
+	err(bcl_err(n));
+
+	n2 = bcl_ctxt_shared_num(ctxt2, shr);
+	err(bcl_ctxt_err(ctxt2, n2));
+
+	err(bcl_ctxt_async_mul(ctxt2, n2, n2, &fut));
+
+	// The views keep the number alive.
+	bcl_shared_free(shr);
+
+	res = bcl_string(bcl_add_keep(n, n));
+	if (strcmp(res, "24691357802469135780")) err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+
+	free(res);
+
+	n3 = bcl_ctxt_parse(ctxt2, "1");
+	if (bcl_ctxt_copy(ctxt2, n2, n3) != BCL_ERROR_INVALID_NUM)
+	{
+		err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+	}
+
+	// A view cannot be accumulated into.
+	if (bcl_ctxt_addmul(ctxt2, n3, n3, n2) != BCL_ERROR_INVALID_NUM)
+	{
+		err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+	}
+
+	res = bcl_ctxt_string(ctxt2, bcl_ctxt_future_num(ctxt2, fut));
+	if (strcmp(res, "152415787532388367501905199875019052100"))
+	{
+		err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+	}
+
+	free(res);
+
+	res = bcl_ctxt_string(ctxt2, n2);
+	if (strcmp(res, "12345678901234567890")) err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+
+	free(res);
+
+	bcl_num_free(n);
+
+	// Check fused multiply-add and accumulating in place, including when the
+	// accumulator is also a factor.
+	n = bcl_ctxt_parse(ctxt2, "-1.5");
+	err(bcl_ctxt_err(ctxt2, n));
+
+	n2 = bcl_ctxt_parse(ctxt2, "12345678901234567890");
+	err(bcl_ctxt_err(ctxt2, n2));
+
+	n3 = bcl_ctxt_fma_keep(ctxt2, n, n2, n);
+	res = bcl_ctxt_string_keep(ctxt2, n3);
+	if (strcmp(res, "-18518518351851851836.5"))
+	{
+		err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+	}
+
+	free(res);
+
+	err(bcl_ctxt_addmul(ctxt2, n, n2, n3));
+	err(bcl_ctxt_submul(ctxt2, n3, n, n3));
+
+	res = bcl_ctxt_string(ctxt2, bcl_ctxt_fma(ctxt2, n3, n, n2));
+	if (strcmp(res, "151234566540123456658.12"))
+	{
+		err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+	}
+
+	free(res);
+
+	bcl_pool_end();
+
+	bcl_ctxt_free(ctxt2);
+
+	// A NULL context means the current one.
+	n = bcl_ctxt_parse(NULL, "7");
+	err(bcl_err(n));
+
+	res = bcl_ctxt_string(NULL, n);
+	if (strcmp(res, "7")) err(BCL_ERROR_FATAL_UNKNOWN_ERR);
+
+	free(res);
+
 	bcl_ctxt_freeNums(ctxt);
 
 	bcl_gc();
@@ -205,6 +205,46 @@ err="$?"
 
 checktest "$d" "$err" "script $f" "$res" "$out"
 
+# Compile the script into a bytecode cache and make sure running the cache
+# gives the same results.
+if [ "$d" = "bc" ]; then
+
+	cache="$outputdir/${d}_outputs/${name}.bcc"
+
+	"$exe" "$@" $options --compile="$cache" "$s"
+	err="$?"
+
+	checktest_retcode "$d" "$err" "compiling script $f"
+
+	printf '%s\n' "$halt" 2> /dev/null | "$exe" "$@" $options "$cache" > "$out"
+	err="$?"
+
+	checktest "$d" "$err" "script $f (compiled)" "$res" "$out"
+
+	# A cache that is truncated or has a byte changed must not be run; bc has
+	# to fall back on the script. The changed byte is in the last event.
+	size=$(wc -c < "$cache")
+	bad="$outputdir/${d}_outputs/${name}_bad.bcc"
+
+	dd if="$cache" of="$bad" bs=1 count=$((size - 9)) > /dev/null 2>&1
+
+	printf '%s\n' "$halt" 2> /dev/null | "$exe" "$@" $options "$bad" > "$out"
+	err="$?"
+
+	checktest "$d" "$err" "script $f (truncated cache)" "$res" "$out"
+
+	cp "$cache" "$bad"
+	printf '\377' | dd of="$bad" bs=1 seek=$((size - 20)) conv=notrunc \
+		> /dev/null 2>&1
+
+	printf '%s\n' "$halt" 2> /dev/null | "$exe" "$@" $options "$bad" > "$out"
+	err="$?"
+
+	checktest "$d" "$err" "script $f (changed cache)" "$res" "$out"
+
+	rm -f "$cache" "$bad"
+fi
+
 rm -f "$out"
 
 exec printf 'pass\n'
@@ -109,6 +109,12 @@ if [ "$d" = "bc" ]; then
 
 	cat "$testdir/$d/stdin2.txt" | "$exe" "$@" "$options" > "$out" 2> /dev/null
 	checktest "$d" "$?" "stdin2" "$testdir/$d/stdin2_results.txt" "$out"
+
+	# In interactive mode, errors do not stop bc, so this checks that a failed
+	# assignment leaves the variable alone.
+	cat "$testdir/$d/stdin3.txt" | "$exe" "$@" "$options" -i > "$out" \
+		2> /dev/null
+	checktest "$d" "$?" "stdin3" "$testdir/$d/stdin3_results.txt" "$out"
 fi
 
 rm -f "$out"